@@ -36,6 +36,8 @@ extern UART_HandleTypeDef huart1;
 
 /* USER CODE BEGIN Private defines */
 extern DMA_HandleTypeDef hdma_usart1_rx;
+
+extern DMA_HandleTypeDef hdma_usart1_tx;
 /* USER CODE END Private defines */
 
 void MX_USART1_UART_Init(void);
@@ -0,0 +1,156 @@
+// PWM→转速标定扫描仿真 (主机端工具)
+//
+// 用模拟电机驱动 User/Module/Calib 的扫描状态机, 参数与 motor_app.c 相同 (450~900, 步长25, 外环100Hz):
+//   电机: 起转PWM以下静止, 之上稳态转速随PWM单调上升 (可带饱和), 一阶惯性, 转速带随机波动
+//   反馈: 1kHz 量化编码器计数 → alpha-beta-gamma 速度估计器 (User/Module/Filter, 与固件同一增益), 外环取最新值
+// 检查: 扫描完成; 死区边缘为起转PWM以下最后一个扫描点; 转速严格递增; 每点与稳态转速的误差;
+//       calib_table_rpm_to_pwm 查表后的稳态转速与目标的误差; 同一随机种子两次扫描结果完全相同
+// 任一检查不通过时返回1
+//
+// 编译 (在 07_Encoder 目录下):
+//   gcc -O2 -c User/Module/Calib/motor_calib.c User/Module/Filter/velocity_filter.c
+//   g++ -std=c++17 -O2 -IUser/Module/Calib -IUser/Module/Filter -o calib_sim Tools/calib_sim.cpp motor_calib.o velocity_filter.o
+// 用法: calib_sim
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+#include "motor_calib.h"
+#include "velocity_filter.h"
+
+namespace {
+
+constexpr int kPwmStart = 450, kPwmEnd = 900, kPwmStep = 25;   // MOTOR_CALIB_PWM_*
+constexpr double kInnerDt = 0.001;                              // CONTROL_RATE_HZ = 1000
+constexpr int kOuterDiv = 10;                                   // CONTROL_OUTER_RATE_HZ = 100
+constexpr double kPpr = 1551.0;                                 // ENCODER_PPR
+constexpr float kAbgAlpha = 0.8f, kAbgBeta = 0.5f, kAbgGamma = 0.02f, kAbgRefDt = 0.01f;  // ENCODER_ABG_*
+
+struct MotorModel {
+    const char *name;
+    int breakaway_pwm;      // 起转PWM
+    double gain;            // 稳态转速 = gain * (pwm - zero_pwm)^exponent
+    double zero_pwm;
+    double exponent;
+    double max_rpm;         // 饱和转速 (0 = 不饱和)
+    double tau_s;           // 时间常数
+    double ripple_rpm;      // 转速随机波动 (标准差)
+
+    double SteadyRpm(int pwm) const {
+        if (pwm < breakaway_pwm) return 0.0;
+        double rpm = gain * std::pow(pwm - zero_pwm, exponent);
+        return max_rpm > 0.0 && rpm > max_rpm ? max_rpm : rpm;
+    }
+};
+
+struct Result {
+    CalibTable_T table;
+    CalibState state;
+    double seconds;
+};
+
+// 运行一次扫描 (与 Motor_Task 标定分支相同: 每个外环周期用最新估计转速更新, 输出下一段PWM)
+Result Sweep(const MotorModel &motor, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> ripple(0.0, motor.ripple_rpm);
+
+    VelFilter_T filter;
+    float alpha = kAbgAlpha, beta = kAbgBeta, gamma = kAbgGamma;
+    vel_filter_abg_rescale(&alpha, &beta, &gamma, kAbgRefDt, static_cast<float>(kInnerDt));
+    vel_filter_init_abg(&filter, alpha, beta, gamma);
+
+    Result r{};
+    CalibSweep_T sweep;
+    calib_sweep_start(&sweep, &r.table, kPwmStart, kPwmEnd, kPwmStep, kInnerDt * kOuterDiv);
+
+    const float cps = static_cast<float>(kPpr / 60.0);
+    double rpm = 0.0, theta = 0.0;
+    float feedback = 0.0f;
+    int pwm = sweep.pwm;
+    uint64_t tick = 0;
+
+    while (sweep.state == CALIB_SETTLING && tick < 600000) {
+        double target = motor.SteadyRpm(pwm);
+        rpm += (target - rpm) * kInnerDt / motor.tau_s;
+        double actual = rpm > 0.0 ? rpm + ripple(rng) : 0.0;
+        theta += actual / 60.0 * kPpr * kInnerDt;
+        feedback = vel_filter_update(&filter, static_cast<int64_t>(std::floor(theta + 0.5)), 0.0f,
+                                     static_cast<float>(kInnerDt)) / cps;
+        if (++tick % kOuterDiv == 0) pwm = calib_sweep_update(&sweep, feedback);
+    }
+    r.state = sweep.state;
+    r.seconds = tick * kInnerDt;
+    return r;
+}
+
+bool Check(bool cond, const char *what) {
+    std::printf("  %s: %s\n", cond ? "PASS" : "FAIL", what);
+    return cond;
+}
+
+bool Run(const MotorModel &motor) {
+    std::printf("%s\n", motor.name);
+    Result r = Sweep(motor, 1);
+    const CalibTable_T &t = r.table;
+    bool ok = true;
+
+    std::printf("  %.1f s, %u points\n  %6s %9s %9s\n", r.seconds, t.count, "pwm", "rpm", "true");
+    for (unsigned i = 0; i < t.count; i++) {
+        std::printf("  %6d %9.2f %9.2f\n", t.pwm[i], t.rpm[i], motor.SteadyRpm(t.pwm[i]));
+    }
+
+    ok &= Check(r.state == CALIB_DONE && t.valid, "sweep finished with a valid table");
+    if (!t.valid) return false;
+
+    int edge = kPwmStart;
+    for (int pwm = kPwmStart; pwm < motor.breakaway_pwm && pwm <= kPwmEnd; pwm += kPwmStep) edge = pwm;
+    ok &= Check(t.pwm[0] == edge && t.rpm[0] == 0.0f, "dead-band edge is the last sweep point below breakaway");
+
+    bool increasing = true;
+    double worst_point = 0.0;
+    for (unsigned i = 1; i < t.count; i++) {
+        increasing &= t.rpm[i] > t.rpm[i - 1] && t.pwm[i] > t.pwm[i - 1];
+        double truth = motor.SteadyRpm(t.pwm[i]);
+        worst_point = std::fmax(worst_point, std::fabs(t.rpm[i] - truth) / truth);
+    }
+    ok &= Check(increasing, "rpm and pwm strictly increasing");
+    std::printf("  worst point error %.2f%%\n", worst_point * 100.0);
+    ok &= Check(worst_point < 0.01, "every point within 1% of the steady-state rpm");
+
+    // 查表: 表内目标转速 → PWM → 稳态转速 (离散PWM本身有 ±0.5 的分辨率)
+    double worst_inverse = 0.0;
+    for (double target = t.rpm[1]; target <= t.rpm[t.count - 1]; target += 1.0) {
+        int pwm = calib_table_rpm_to_pwm(&t, static_cast<float>(target));
+        double slope = (motor.SteadyRpm(pwm + 1) - motor.SteadyRpm(pwm - 1)) / 2.0;
+        double err = std::fabs(motor.SteadyRpm(pwm) - target) - 0.5 * slope;
+        worst_inverse = std::fmax(worst_inverse, err / target);
+    }
+    std::printf("  worst lookup error %.2f%%\n", worst_inverse * 100.0);
+    ok &= Check(worst_inverse < 0.02, "lookup within 2% of the target rpm between points");
+
+    Result again = Sweep(motor, 1);
+    ok &= Check(std::memcmp(&again.table, &r.table, sizeof(CalibTable_T)) == 0 && again.state == r.state,
+                "same seed gives an identical table");
+    return ok;
+}
+
+}  // namespace
+
+int main() {
+    const MotorModel motors[] = {
+        // 与 motor_app.c 未标定时的线性关系 PWM = 1.30 * rpm + 529.2 一致, 起转点略高
+        {"linear (firmware default fit)", 540, 1.0 / 1.30, 529.2, 1.0, 0.0, 0.08, 0.3},
+        // 转速随PWM增长变缓, 死区更宽, 波动更大
+        {"concave, wide dead band", 610, 4.0, 560.0, 0.75, 0.0, 0.12, 1.0},
+        // 高PWM时饱和: 饱和后的点转速不再上升, 不能入表
+        {"saturating at 250 rpm", 540, 1.0 / 1.30, 529.2, 1.0, 250.0, 0.08, 0.3},
+    };
+
+    bool ok = true;
+    for (const MotorModel &m : motors) ok &= Run(m);
+    std::printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,265 @@
+// 抢占式内核测试 (主机端工具)
+//
+// 用桩移植层在主机上运行 Module/Kernel/kernel.c (不含 kernel_port.c 的汇编):
+//   PRIMASK 为一个标志, kernel_port_pend 挂起一个模拟的 PendSV;
+//   PendSV 与硬件一样只在开中断且没有中断在执行时进入, 进入后关中断直接调用 kernel_activate,
+//   被抢占的任务留在主机调用栈上, 与固件在主栈上等待相同
+// 检查:
+//   固定场景: 中断激活后按优先级执行, 高优先级任务立即抢占, 同级不抢占, 重复激活只执行一次,
+//             低优先级任务等到被抢占者返回后执行, 天花板锁期间只允许更高优先级抢占, 解锁时执行被挡住的任务
+//   随机压力: 任务和中断在随机位置激活任务、加锁解锁, 每次执行任务时检查
+//             优先级严格高于被抢占的上下文 (含锁天花板)、没有更高优先级的任务就绪,
+//             回到空闲时所有激活过的任务都已执行、没有就绪任务
+// 任一检查不通过时返回1
+//
+// 编译 (在 07_Encoder 目录下):
+//   gcc -O2 -c User/Module/Kernel/kernel.c
+//   g++ -std=c++17 -O2 -IUser/Module/Kernel -o kernel_test Tools/kernel_test.cpp kernel.o
+// 用法: kernel_test
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "kernel.h"
+
+namespace {
+
+// 模拟的处理器状态
+uint32_t g_primask;
+int g_isr_depth;
+bool g_pendsv;
+
+// PendSV 最低优先级: 开中断、没有中断在执行时才进入
+void TakePendSV() {
+    while (g_pendsv && g_primask == 0 && g_isr_depth == 0) {
+        g_pendsv = false;
+        g_primask = 1;
+        kernel_activate();
+        g_primask = 0;
+    }
+}
+
+// 中断: 只能在开中断时进入, 返回时检查 PendSV
+void Isr(const std::function<void()> &fn) {
+    if (g_primask != 0) return;
+    g_isr_depth++;
+    fn();
+    g_isr_depth--;
+    TakePendSV();
+}
+
+}  // namespace
+
+// 桩移植层
+void kernel_port_init(void) { g_pendsv = false; }
+uint32_t kernel_port_irq_save(void) {
+    uint32_t state = g_primask;
+    g_primask = 1;
+    return state;
+}
+void kernel_port_irq_restore(uint32_t _state) {
+    g_primask = _state;
+    TakePendSV();
+}
+void kernel_port_pend(void) { g_pendsv = true; }
+
+namespace {
+
+constexpr int kTasks = 6;
+const uint8_t kLevels[kTasks] = {0, 0, 1, 1, 2, 3};
+
+std::function<void(uint8_t)> g_body;    // 当前场景的任务函数
+std::string g_log;
+
+void Dispatch(uint8_t index) { g_body(index); }
+
+void Reset(const std::function<void(uint8_t)> &body) {
+    g_primask = 0;
+    g_isr_depth = 0;
+    kernel_init(kLevels, kTasks, Dispatch);
+    g_body = body;
+    g_log.clear();
+}
+
+void Mark(const char *s) { g_log += s; }
+void Mark(char c, uint8_t index) {
+    g_log += c;
+    g_log += static_cast<char>('0' + index);
+    g_log += ' ';
+}
+
+bool g_ok = true;
+void Check(bool cond, const char *what) {
+    std::printf("  %s: %s\n", cond ? "PASS" : "FAIL", what);
+    g_ok &= cond;
+}
+void CheckLog(const char *expect, const char *what) {
+    bool ok = g_log == expect;
+    Check(ok, what);
+    if (!ok) std::printf("        got \"%s\", expected \"%s\"\n", g_log.c_str(), expect);
+}
+bool Idle() { return kernel_pending() == 0 && kernel_active_level() == KERNEL_IDLE_LEVEL; }
+
+// 任务记录开始 '<' 和结束 '>', 中间执行 step(index)
+std::function<void(uint8_t)> Body(const std::function<void(uint8_t)> &step) {
+    return [step](uint8_t i) {
+        Mark('<', i);
+        step(i);
+        Mark('>', i);
+    };
+}
+
+void TestScenarios() {
+    std::printf("scenarios\n");
+
+    Reset(Body([](uint8_t) {}));
+    Isr([] { kernel_post(0x3Cu); });
+    CheckLog("<2 >2 <3 >3 <4 >4 <5 >5 ", "posted tasks run by level, then by index");
+    Check(Idle(), "back to idle with nothing ready");
+
+    Reset(Body([](uint8_t i) { if (i == 5) kernel_post(0x1u); }));
+    Isr([] { kernel_post(0x20u); });
+    CheckLog("<5 <0 >0 >5 ", "higher level preempts the posting task at once");
+
+    Reset(Body([](uint8_t i) { if (i == 2) { kernel_post(0x8u); Mark("| "); } }));
+    Isr([] { kernel_post(0x4u); });
+    CheckLog("<2 | >2 <3 >3 ", "same level does not preempt");
+
+    Reset(Body([](uint8_t i) {
+        static bool again = true;
+        if (i == 0 && again) {
+            again = false;
+            kernel_post(0x1u);
+        }
+    }));
+    Isr([] { kernel_post(0x11u); kernel_post(0x11u); });
+    CheckLog("<0 >0 <0 >0 <4 >4 ", "repeated posts before a run execute once; a post while running runs again");
+
+    Reset(Body([](uint8_t i) {
+        if (i == 2) Isr([] { kernel_post(0x21u); });
+        if (i == 0) Mark("| ");
+    }));
+    Isr([] { kernel_post(0x4u); });
+    CheckLog("<2 <0 | >0 >2 <5 >5 ", "lower level waits for the preempted task to return");
+
+    Reset(Body([](uint8_t i) {
+        if (i == 5) {
+            uint8_t prev = kernel_lock(1);
+            Check(kernel_active_level() == 1, "lock raises the active level to the ceiling");
+            Isr([] { kernel_post(0x1u | 0x4u | 0x10u); });
+            Mark("| ");
+            kernel_unlock(prev);
+            Check(kernel_active_level() == 3, "unlock restores the task level");
+        }
+    }));
+    Isr([] { kernel_post(0x20u); });
+    CheckLog("<5 <0 >0 | <2 >2 <4 >4 >5 ", "lock blocks the ceiling level, unlock runs what it held back");
+
+    Reset(Body([](uint8_t i) {
+        if (i == 4) {
+            uint8_t outer = kernel_lock(1);
+            uint8_t inner = kernel_lock(0);
+            kernel_post(0x1u | 0x4u);
+            Mark("| ");
+            kernel_unlock(inner);
+            Mark("| ");
+            kernel_unlock(outer);
+        }
+    }));
+    Isr([] { kernel_post(0x10u); });
+    CheckLog("<4 | <0 >0 | <2 >2 >4 ", "nested locks release one ceiling at a time");
+    Check(Idle(), "back to idle with nothing ready");
+}
+
+// 随机压力
+std::mt19937 g_rng(2024);
+std::vector<uint8_t> g_ctx;     // 各层被抢占上下文的有效优先级 (含锁天花板), 底部为空闲
+uint32_t g_owed;                // 已激活尚未开始执行
+uint64_t g_runs, g_preemptions, g_errors;
+int g_max_depth;
+
+void Fail(const char *what) {
+    if (g_errors++ < 5) std::printf("        %s\n", what);
+}
+
+void Post(uint32_t mask) {
+    g_owed |= mask;
+    kernel_post(mask);
+}
+
+void Step(int depth);
+
+void StressBody(uint8_t i) {
+    if (kLevels[i] >= g_ctx.back()) Fail("task does not outrank the preempted context");
+    for (int j = 0; j < kTasks; j++) {
+        if ((kernel_pending() >> j & 1u) && kLevels[j] < kLevels[i]) Fail("higher level task left ready");
+    }
+    if (kernel_active_level() != kLevels[i]) Fail("active level is not the task level");
+    if (g_ctx.size() > 1) g_preemptions++;
+    g_owed &= ~(1u << i);
+    g_runs++;
+    g_ctx.push_back(kLevels[i]);
+    g_max_depth = std::max(g_max_depth, static_cast<int>(g_ctx.size()) - 1);
+
+    int steps = static_cast<int>(g_rng() % 3);
+    for (int k = 0; k < steps; k++) Step(1);
+
+    g_ctx.pop_back();
+}
+
+// 任务中或主循环中的一步: 中断激活 / 直接激活 / 加锁后再走一步
+// 主循环中一次激活随机多个任务, 任务中只激活一个 (平均每次执行引出的激活少于一次, 保证能回到空闲)
+void Step(int depth) {
+    uint32_t mask = depth == 0 ? g_rng() & ((1u << kTasks) - 1) : 1u << (g_rng() % kTasks);
+    switch (g_rng() % 4) {
+    case 0:
+    case 1:
+        Isr([mask] { Post(mask); });
+        break;
+    case 2:
+        Post(mask);
+        break;
+    case 3:
+        if (depth < 3) {
+            uint8_t ceiling = static_cast<uint8_t>(g_rng() % 4);
+            uint8_t saved = g_ctx.back();
+            uint8_t prev = kernel_lock(ceiling);
+            if (ceiling < g_ctx.back()) g_ctx.back() = ceiling;
+            Step(depth + 1);
+            if (g_rng() & 1u) Isr([mask] { Post(mask); });
+            g_ctx.back() = saved;
+            kernel_unlock(prev);
+        }
+        break;
+    }
+}
+
+void TestStress() {
+    std::printf("random stress\n");
+    Reset(StressBody);
+    g_ctx.assign(1, KERNEL_IDLE_LEVEL);
+    bool idle = true;
+    for (int n = 0; n < 200000; n++) {
+        Step(0);
+        idle &= g_owed == 0 && Idle() && g_ctx.size() == 1;
+    }
+    std::printf("  %llu runs, %llu preemptions, max nesting %d\n", static_cast<unsigned long long>(g_runs),
+                static_cast<unsigned long long>(g_preemptions), g_max_depth);
+    Check(g_errors == 0, "every run outranks the preempted context and no higher level is left ready");
+    Check(idle, "every posted task ran before returning to idle");
+    Check(g_preemptions > 0 && g_max_depth >= 3, "preemption exercised at several levels");
+}
+
+}  // namespace
+
+int main() {
+    TestScenarios();
+    TestStress();
+    std::printf("%s\n", g_ok ? "PASS" : "FAIL");
+    return g_ok ? 0 : 1;
+}
@@ -0,0 +1,183 @@
+// 延迟格式化日志解码 (主机端工具)
+//
+// 从固件 (.axf, ELF) 的符号表中取出所有 log_fmt_ 格式串 (地址即编号), 把串口上的日志帧还原为文本
+// 日志帧格式见 User/App/log_app.h, 参数编码与格式化复用 User/Module/Log (与设备端文本方式相同)
+// 非日志帧的文本原样输出, 其他类型的帧 (如遥测) 忽略
+//
+// 编译 (在 07_Encoder 目录下):
+//   gcc -O2 -c User/Module/Frame/frame.c User/Module/Log/log.c
+//   g++ -std=c++17 -O2 -IUser/Module/Frame -IUser/Module/Log -o log_decode Tools/log_decode.cpp frame.o log.o
+// 用法:
+//   ./log_decode MDK-ARM/07_Encoder/07_Encoder.axf /dev/ttyUSB0   # 不给串口时从 stdin 读取
+//   ./log_decode --dump MDK-ARM/07_Encoder/07_Encoder.axf          # 列出格式串表
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "frame.h"
+#include "log.h"
+
+namespace {
+
+constexpr uint8_t kFrameRecord = 0x4C;  // LOG_FRAME_RECORD
+constexpr size_t kFrameHeader = 10;     // LOG_FRAME_HEADER
+constexpr char kLevelName[] = "EWID";
+
+uint32_t U32(const uint8_t *p) { return p[0] | p[1] << 8 | p[2] << 16 | static_cast<uint32_t>(p[3]) << 24; }
+uint64_t U64(const uint8_t *p) { return U32(p) | static_cast<uint64_t>(U32(p + 4)) << 32; }
+uint16_t U16(const uint8_t *p) { return static_cast<uint16_t>(p[0] | p[1] << 8); }
+
+struct Section {
+    uint32_t type;
+    uint64_t addr, offset, size;
+    uint32_t link;
+    uint64_t entsize;
+};
+
+// 读取 ELF (32/64位, 小端) 的符号表, 返回 格式串地址 → 格式串
+bool LoadFormats(const char *path, std::map<uint32_t, std::string> *formats) {
+    FILE *f = std::fopen(path, "rb");
+    if (!f) {
+        std::perror(path);
+        return false;
+    }
+    std::vector<uint8_t> elf;
+    uint8_t buf[65536];
+    size_t n;
+    while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0) elf.insert(elf.end(), buf, buf + n);
+    std::fclose(f);
+
+    if (elf.size() < 64 || std::memcmp(elf.data(), "\x7f" "ELF", 4) != 0 || elf[5] != 1) {
+        std::fprintf(stderr, "%s: not a little-endian ELF file\n", path);
+        return false;
+    }
+    const bool is64 = elf[4] == 2;
+    const uint64_t shoff = is64 ? U64(&elf[0x28]) : U32(&elf[0x20]);
+    const uint16_t shentsize = U16(&elf[is64 ? 0x3A : 0x2E]);
+    const uint16_t shnum = U16(&elf[is64 ? 0x3C : 0x30]);
+
+    std::vector<Section> sections;
+    for (uint16_t i = 0; i < shnum; i++) {
+        uint64_t at = shoff + static_cast<uint64_t>(i) * shentsize;
+        if (at + shentsize > elf.size()) return false;
+        const uint8_t *h = &elf[at];
+        Section s;
+        s.type = U32(h + 4);
+        if (is64) {
+            s = {s.type, U64(h + 16), U64(h + 24), U64(h + 32), U32(h + 40), U64(h + 56)};
+        } else {
+            s = {s.type, U32(h + 12), U32(h + 16), U32(h + 20), U32(h + 24), U32(h + 36)};
+        }
+        sections.push_back(s);
+    }
+
+    // 地址所在的已加载段中的字符串
+    auto string_at = [&](uint64_t addr, std::string *out) {
+        for (const Section &s : sections) {
+            if (s.type != 1 || addr < s.addr || addr >= s.addr + s.size) continue;  // SHT_PROGBITS
+            uint64_t pos = s.offset + (addr - s.addr);
+            uint64_t end = s.offset + s.size;
+            out->clear();
+            while (pos < end && pos < elf.size() && elf[pos]) out->push_back(static_cast<char>(elf[pos++]));
+            return true;
+        }
+        return false;
+    };
+
+    for (const Section &symtab : sections) {
+        if (symtab.type != 2 || symtab.link >= sections.size() || symtab.entsize == 0) continue;  // SHT_SYMTAB
+        const Section &strtab = sections[symtab.link];
+        for (uint64_t at = symtab.offset; at + symtab.entsize <= symtab.offset + symtab.size; at += symtab.entsize) {
+            if (at + symtab.entsize > elf.size()) break;
+            const uint8_t *sym = &elf[at];
+            uint32_t name = U32(sym);
+            uint64_t value = is64 ? U64(sym + 8) : U32(sym + 4);
+            if (strtab.offset + name >= elf.size()) continue;
+            const char *sym_name = reinterpret_cast<const char *>(&elf[strtab.offset + name]);
+            if (!std::strstr(sym_name, "log_fmt_")) continue;
+
+            std::string text;
+            if (string_at(value, &text)) (*formats)[static_cast<uint32_t>(value)] = text;
+        }
+    }
+    return true;
+}
+
+class Decoder {
+public:
+    explicit Decoder(const std::map<uint32_t, std::string> &formats) : formats_(formats) {}
+
+    void Chunk(const std::vector<uint8_t> &chunk) {
+        if (chunk.empty()) return;
+        payload_.resize(chunk.size());
+        int32_t len = frame_decode(chunk.data(), static_cast<uint32_t>(chunk.size()), payload_.data());
+        if (len < 0) {
+            std::fwrite(chunk.data(), 1, chunk.size(), stdout);  // 文本
+        } else if (len >= static_cast<int32_t>(kFrameHeader) && payload_[0] == kFrameRecord) {
+            Record(payload_.data(), static_cast<uint32_t>(len));
+        }
+        std::fflush(stdout);
+    }
+
+private:
+    void Record(const uint8_t *p, uint32_t len) {
+        uint32_t tick = U32(p + 2);
+        uint32_t id = U32(p + 6);
+        std::printf("[%c %u] ", kLevelName[p[1] & 3], tick);
+
+        auto it = formats_.find(id);
+        if (it == formats_.end()) {
+            std::printf("<unknown format 0x%08x, %u argument bytes>\n", id, len - static_cast<uint32_t>(kFrameHeader));
+            return;
+        }
+        char text[512];
+        log_format(text, sizeof(text), it->second.c_str(), p + kFrameHeader, len - static_cast<uint32_t>(kFrameHeader));
+        std::printf("%s\n", text);
+    }
+
+    const std::map<uint32_t, std::string> &formats_;
+    std::vector<uint8_t> payload_;
+};
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    if (argc >= 3 && std::strcmp(argv[1], "--dump") == 0) {
+        std::map<uint32_t, std::string> formats;
+        if (!LoadFormats(argv[2], &formats)) return 1;
+        for (const auto &f : formats) std::printf("0x%08x  %s\n", f.first, f.second.c_str());
+        return 0;
+    }
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s firmware.axf [serial]\n       %s --dump firmware.axf\n", argv[0], argv[0]);
+        return 1;
+    }
+
+    std::map<uint32_t, std::string> formats;
+    if (!LoadFormats(argv[1], &formats)) return 1;
+    std::fprintf(stderr, "%zu format strings\n", formats.size());
+
+    FILE *in = argc > 2 ? std::fopen(argv[2], "rb") : stdin;
+    if (!in) {
+        std::perror(argv[2]);
+        return 1;
+    }
+
+    Decoder decoder(formats);
+    std::vector<uint8_t> chunk;
+    int c;
+    while ((c = std::fgetc(in)) != EOF) {
+        if (c == FRAME_DELIMITER) {
+            decoder.Chunk(chunk);
+            chunk.clear();
+        } else if (chunk.size() < 4096) {
+            chunk.push_back(static_cast<uint8_t>(c));
+        }
+    }
+    decoder.Chunk(chunk);
+    return 0;
+}
@@ -0,0 +1,356 @@
+// 参数存储测试 (主机端工具)
+//
+// 用内存数组模拟两个flash bank, 驱动 User/Module/ParamStore 的记录追加/换bank逻辑:
+//   flash模型: 编程只能把位从1写成0 (需要0→1时失败), 擦除整个bank为0xFF; 可在第N次编程时模拟掉电
+//   用例: 空存储; 保存/读取; 逐条追加后重新上电; bank写满后换bank (多轮, 代数递增);
+//         代数回绕; 追加和换bank过程中每一次编程处掉电; 最新记录CRC错误时退回上一条
+// 另外检查 param_app.h 的bank地址落在芯片flash (.ioc 的 Mcu.CPN) 的扇区边界上, 且不与 uvprojx 的 IROM1 重叠
+// 任一检查不通过时返回1
+//
+// 编译 (在 07_Encoder 目录下):
+//   gcc -O2 -c User/Module/ParamStore/param_store.c
+//   g++ -std=c++17 -O2 -IUser/Module/ParamStore -o param_store_test Tools/param_store_test.cpp param_store.o
+// 用法: param_store_test [07_Encoder目录, 默认当前目录]
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "param_store.h"
+
+namespace {
+
+constexpr uint32_t kBankSize = 256;     // 小bank, 几条记录即写满
+
+// 两个bank的NOR flash模型
+struct Flash {
+    uint8_t mem[2][kBankSize];
+    long programs = 0;          // 已执行的编程次数
+    long fail_after = -1;       // 第N次编程起全部失败 (掉电), -1=不失败
+    long erases = 0;
+
+    Flash() { Erase(0), Erase(1); }
+    void Erase(uint8_t bank) { std::memset(mem[bank], 0xFF, kBankSize); }
+    uint32_t Word(uint8_t bank, uint32_t offset) const {
+        uint32_t w;
+        std::memcpy(&w, &mem[bank][offset], 4);
+        return w;
+    }
+};
+
+Flash *g_flash = nullptr;
+
+int ProgramWord(uint8_t bank, uint32_t offset, uint32_t data) {
+    Flash &f = *g_flash;
+    if (bank > 1 || offset % 4 != 0 || offset + 4 > kBankSize) return -1;
+    if (f.fail_after >= 0 && f.programs >= f.fail_after) return -1;
+    f.programs++;
+    uint32_t old = f.Word(bank, offset);
+    if ((old & data) != data) return -1;            // 需要0→1, 未擦除
+    uint32_t w = old & data;
+    std::memcpy(&f.mem[bank][offset], &w, 4);
+    return 0;
+}
+
+int EraseBank(uint8_t bank) {
+    Flash &f = *g_flash;
+    if (bank > 1 || (f.fail_after >= 0 && f.programs >= f.fail_after)) return -1;
+    f.Erase(bank);
+    f.erases++;
+    return 0;
+}
+
+ParamFlashOps_T MakeOps(Flash &f) {
+    g_flash = &f;
+    ParamFlashOps_T ops{};
+    ops.bank_base[0] = f.mem[0];
+    ops.bank_base[1] = f.mem[1];
+    ops.bank_size = kBankSize;
+    ops.program_word = ProgramWord;
+    ops.erase_bank = EraseBank;
+    return ops;
+}
+
+// 测试数据: 第 n 次保存的内容 (长度不是4的倍数, 覆盖填充路径)
+constexpr uint16_t kLen = 42;
+struct Payload {
+    uint8_t b[kLen];
+};
+Payload MakePayload(uint32_t n) {
+    Payload p;
+    for (uint16_t i = 0; i < kLen; i++) p.b[i] = static_cast<uint8_t>(n * 31u + i * 7u);
+    return p;
+}
+
+// 读取并返回保存序号 (与 MakePayload 不一致时返回 -1, 空时返回 -2)
+long Loaded(const ParamStore_T &store) {
+    Payload p;
+    uint16_t ver = 0, len = 0;
+    if (param_store_load(&store, p.b, kLen, &ver, &len) != PARAM_OK) return -2;
+    if (len != kLen || std::memcmp(p.b, MakePayload(ver).b, kLen) != 0) return -1;
+    return ver;
+}
+
+// 按固件的方式保存: BUSY时先擦除备用bank再重试
+ParamResult Save(ParamStore_T &store, uint32_t n) {
+    Payload p = MakePayload(n);
+    ParamResult r = param_store_save(&store, p.b, kLen, static_cast<uint16_t>(n));
+    if (r == PARAM_BUSY) {
+        if (param_store_maintain(&store) != PARAM_OK) return PARAM_ERROR;
+        r = param_store_save(&store, p.b, kLen, static_cast<uint16_t>(n));
+    }
+    return r;
+}
+
+bool g_ok = true;
+void Check(bool cond, const char *what) {
+    std::printf("  %s: %s\n", cond ? "PASS" : "FAIL", what);
+    g_ok &= cond;
+}
+
+void TestBasic() {
+    std::printf("basic\n");
+    Flash f;
+    ParamFlashOps_T ops = MakeOps(f);
+    ParamStore_T store;
+    param_store_init(&store, &ops);
+    Check(Loaded(store) == -2 && !param_store_need_maintain(&store), "blank flash loads EMPTY, no erase pending");
+
+    Check(Save(store, 1) == PARAM_OK && Loaded(store) == 1, "save then load round trip");
+    uint8_t big[kBankSize];
+    Check(param_store_save(&store, big, kBankSize, 9) == PARAM_TOO_LARGE, "record larger than a bank is rejected");
+
+    // 读缓冲区小于记录时只拷贝前 _size 字节
+    uint8_t part[8] = {};
+    uint16_t len = 0;
+    param_store_load(&store, part, sizeof(part), nullptr, &len);
+    Check(len == kLen && std::memcmp(part, MakePayload(1).b, sizeof(part)) == 0, "short buffer gets a prefix");
+}
+
+void TestRotation() {
+    std::printf("append and bank rotation\n");
+    Flash f;
+    ParamFlashOps_T ops = MakeOps(f);
+    ParamStore_T store;
+    param_store_init(&store, &ops);
+
+    bool reload_ok = true, gen_ok = true, busy_seen = false;
+    int switches = 0;
+    int8_t bank = -1;
+    uint32_t gen = 0;
+    for (uint32_t n = 1; n <= 60; n++) {
+        Payload p = MakePayload(n);
+        ParamResult r = param_store_save(&store, p.b, kLen, static_cast<uint16_t>(n));
+        if (r == PARAM_BUSY) {
+            busy_seen = true;
+            r = Save(store, n);
+        }
+        reload_ok &= r == PARAM_OK && Loaded(store) == static_cast<long>(n);
+
+        if (store.active != bank) {
+            gen_ok &= bank < 0 || store.generation == gen + 1;
+            bank = store.active;
+            gen = store.generation;
+            switches++;
+        }
+
+        // 重新上电: 扫描结果与运行中的状态一致
+        ParamStore_T again;
+        param_store_init(&again, &ops);
+        reload_ok &= Loaded(again) == static_cast<long>(n) && again.active == store.active &&
+                     again.write_offset == store.write_offset && again.generation == store.generation;
+        store = again;
+    }
+    std::printf("  %d bank switches, %ld erases, generation %u\n", switches, f.erases, store.generation);
+    Check(switches > 10 && busy_seen, "full bank rotates to the spare after an erase");
+    Check(gen_ok, "generation increments on every switch");
+    Check(reload_ok, "re-init after every save finds the latest record and write offset");
+}
+
+// 构造一个只含一条记录的bank, 代数为 gen
+void CraftBank(Flash &f, uint8_t bank, uint32_t gen, uint32_t n) {
+    Flash scratch;
+    ParamFlashOps_T ops = MakeOps(scratch);
+    ParamStore_T s;
+    param_store_init(&s, &ops);                     // 两个bank都空白时写入bank0
+    Save(s, n);
+    std::memcpy(f.mem[bank], scratch.mem[0], kBankSize);
+    std::memcpy(f.mem[bank] + 4, &gen, 4);
+    g_flash = &f;
+}
+
+void TestGenerationWrap() {
+    std::printf("generation wrap\n");
+    Flash f;
+    ParamFlashOps_T ops = MakeOps(f);
+    CraftBank(f, 0, 0xFFFFFFFFu, 1);
+    CraftBank(f, 1, 0u, 2);
+    ParamStore_T store;
+    param_store_init(&store, &ops);
+    Check(store.active == 1 && Loaded(store) == 2, "generation 0 is newer than 0xFFFFFFFF");
+
+    CraftBank(f, 0, 5u, 3);
+    CraftBank(f, 1, 4u, 4);
+    param_store_init(&store, &ops);
+    Check(store.active == 0 && Loaded(store) == 3, "larger generation wins without wrap");
+}
+
+// 从 base 状态出发, 在保存 n 的第 k 次编程处掉电, 然后重新上电
+void TestTorn(const char *name, const Flash &base, uint32_t n) {
+    std::printf("power loss during %s\n", name);
+
+    // 先测出这次保存共需多少次编程
+    Flash probe = base;
+    ParamFlashOps_T ops = MakeOps(probe);
+    ParamStore_T store;
+    param_store_init(&store, &ops);
+    long prev = Loaded(store);
+    probe.programs = 0;
+    Save(store, n);
+    const long total = probe.programs;
+
+    bool keeps_prev = true, recovered = true;
+    for (long k = 0; k < total; k++) {
+        Flash f = base;
+        ops = MakeOps(f);
+        param_store_init(&store, &ops);
+        f.programs = 0;
+        f.fail_after = k;
+        Save(store, n);
+
+        // 上电
+        f.fail_after = -1;
+        param_store_init(&store, &ops);
+        long got = Loaded(store);
+        keeps_prev &= got == prev;                  // 提交标志未写入, 只能是旧记录
+
+        // 之后的保存仍然可用 (必要时擦除备用bank)
+        bool ok = true;
+        for (uint32_t m = n + 1; m < n + 8; m++) {
+            ok &= Save(store, m) == PARAM_OK;
+            ParamStore_T again;
+            param_store_init(&again, &ops);
+            ok &= Loaded(again) == static_cast<long>(m);
+            store = again;
+        }
+        recovered &= ok;
+    }
+    std::printf("  %ld cut points, previous record %ld\n", total, prev);
+    Check(keeps_prev, "every cut before the commit word keeps the previous record");
+    Check(recovered, "later saves succeed and reload after every cut");
+}
+
+void TestCrc() {
+    std::printf("CRC mismatch\n");
+    Flash f;
+    ParamFlashOps_T ops = MakeOps(f);
+    ParamStore_T store;
+    param_store_init(&store, &ops);
+    Save(store, 1);
+    Save(store, 2);
+    uint32_t latest = store.record_offset;
+
+    // 最新记录数据区翻转一位
+    f.mem[store.active][latest + 8 + 3] ^= 0x01;
+    param_store_init(&store, &ops);
+    Check(Loaded(store) == 1, "corrupted latest record falls back to the previous one");
+    Check(Save(store, 3) == PARAM_OK && Loaded(store) == 3, "appending after a bad record works");
+
+    ParamStore_T again;
+    param_store_init(&again, &ops);
+    Check(Loaded(again) == 3 && again.record_count == 3, "bad record is skipped but counted");
+}
+
+// ——— flash布局 ———
+
+std::string ReadFile(const std::string &path) {
+    std::ifstream in(path);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+bool FindHex(const std::string &text, const std::string &pattern, uint32_t *value) {
+    std::smatch m;
+    if (!std::regex_search(text, m, std::regex(pattern))) return false;
+    *value = static_cast<uint32_t>(std::stoul(m[1].str(), nullptr, 16));
+    return true;
+}
+
+void TestLayout(const std::string &root) {
+    std::printf("flash layout\n");
+    std::string app = ReadFile(root + "/User/App/param_app.h");
+    std::string proj = ReadFile(root + "/MDK-ARM/07_Encoder.uvprojx");
+    std::string ioc = ReadFile(root + "/07_Encoder.ioc");
+
+    uint32_t bank0 = 0, bank1 = 0, size = 0, irom = 0, sector0 = 0, sector1 = 0;
+    bool parsed = FindHex(app, R"(#define\s+PARAM_BANK0_ADDR\s+0x([0-9A-Fa-f]+))", &bank0) &&
+                  FindHex(app, R"(#define\s+PARAM_BANK1_ADDR\s+0x([0-9A-Fa-f]+))", &bank1) &&
+                  FindHex(app, R"(#define\s+PARAM_BANK_SIZE\s+0x([0-9A-Fa-f]+))", &size) &&
+                  FindHex(proj, R"(<OCR_RVCT4>[\s\S]*?<Size>0x([0-9A-Fa-f]+)</Size>)", &irom);
+    std::smatch m;
+    parsed &= std::regex_search(app, m, std::regex(R"(PARAM_BANK0_SECTOR\s+FLASH_SECTOR_(\d+))")) &&
+              (sector0 = static_cast<uint32_t>(std::stoul(m[1].str())), true);
+    parsed &= std::regex_search(app, m, std::regex(R"(PARAM_BANK1_SECTOR\s+FLASH_SECTOR_(\d+))")) &&
+              (sector1 = static_cast<uint32_t>(std::stoul(m[1].str())), true);
+    parsed &= std::regex_search(ioc, m, std::regex(R"(Mcu\.CPN=STM32F40\d(\w)(\w))"));
+    Check(parsed, "param_app.h, uvprojx and .ioc parsed");
+    if (!parsed) return;
+
+    // F40x 容量代码: E=512KB, G=1MB; 扇区 0~3 16KB, 4 64KB, 5~11 128KB
+    const uint32_t flash_kb = m[2].str() == "G" ? 1024 : (m[2].str() == "E" ? 512 : 0);
+    std::vector<uint32_t> sectors;
+    for (uint32_t addr = 0x08000000u, i = 0; addr < 0x08000000u + flash_kb * 1024u; i++) {
+        sectors.push_back(addr);
+        addr += i < 4 ? 0x4000u : (i == 4 ? 0x10000u : 0x20000u);
+    }
+    auto sector_ok = [&](uint32_t addr, uint32_t sector) {
+        return sector < sectors.size() && sectors[sector] == addr &&
+               (sector + 1 < sectors.size() ? sectors[sector + 1] : 0x08000000u + flash_kb * 1024u) - addr == size;
+    };
+    std::printf("  %s flash %u KB, IROM1 0x%X, banks 0x%08X/0x%08X (sector %u/%u) x 0x%X\n",
+                m[0].str().c_str() + 8, flash_kb, irom, bank0, bank1, sector0, sector1, size);
+    Check(flash_kb != 0 && sector_ok(bank0, sector0) && sector_ok(bank1, sector1),
+          "banks are whole sectors inside the chip's flash");
+    Check(0x08000000u + irom <= bank0 && 0x08000000u + irom <= bank1, "IROM1 ends before the parameter banks");
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    TestBasic();
+    TestRotation();
+    TestGenerationWrap();
+    TestCrc();
+
+    // 追加: bank内已有记录, 保存写在同一bank
+    {
+        Flash f;
+        ParamFlashOps_T ops = MakeOps(f);
+        ParamStore_T store;
+        param_store_init(&store, &ops);
+        Save(store, 1);
+        Save(store, 2);
+        TestTorn("an append", f, 3);
+    }
+    // 换bank: 当前bank已满, 备用bank已擦除
+    {
+        Flash f;
+        ParamFlashOps_T ops = MakeOps(f);
+        ParamStore_T store;
+        param_store_init(&store, &ops);
+        uint32_t n = 1;
+        while (store.write_offset + 8 + ((kLen + 3) & ~3) + 4 <= kBankSize) Save(store, n++);
+        param_store_maintain(&store);
+        TestTorn("a bank switch", f, n);
+    }
+
+    TestLayout(argc > 1 ? argv[1] : ".");
+    std::printf("%s\n", g_ok ? "PASS" : "FAIL");
+    return g_ok ? 0 : 1;
+}
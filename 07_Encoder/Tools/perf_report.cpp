@@ -0,0 +1,151 @@
+// 执行时间报告解析 (主机端工具)
+//
+// 解析固件串口输出中的 "#PERF ..." 行 (见 User/App/perf_app.c), 周期换算为微秒, 输出表格和直方图
+//
+// 编译: g++ -std=c++17 -O2 -o perf_report perf_report.cpp
+// 用法: perf_report [串口日志文件]   (省略文件名时读标准输入, 可直接接串口: cat /dev/ttyUSB0 | perf_report)
+//       先在串口发送 "perf" 触发报告, "perf reset" 清零统计
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Slot {
+    std::string ctx;
+    std::string name;
+    uint64_t n = 0;
+    uint64_t min = 0;
+    uint64_t max = 0;
+    uint64_t mean = 0;
+    std::vector<uint64_t> hist;
+};
+
+struct Report {
+    double hz = 168e6;
+    int shift = 7;
+    int bins = 16;
+    std::vector<Slot> slots;
+};
+
+// 解析 "key=value" 字段
+std::map<std::string, std::string> ParseFields(std::istringstream &in)
+{
+    std::map<std::string, std::string> fields;
+    std::string token;
+    while (in >> token) {
+        auto eq = token.find('=');
+        if (eq != std::string::npos) fields[token.substr(0, eq)] = token.substr(eq + 1);
+    }
+    return fields;
+}
+
+std::vector<uint64_t> ParseList(const std::string &text)
+{
+    std::vector<uint64_t> values;
+    std::istringstream in(text);
+    std::string item;
+    while (std::getline(in, item, ',')) values.push_back(std::stoull(item));
+    return values;
+}
+
+// 直方图第 i 格的上界(周期)
+uint64_t BinUpper(const Report &report, int i)
+{
+    return uint64_t(1) << (report.shift + i);
+}
+
+void PrintReport(const Report &report, int index)
+{
+    const double us = 1e6 / report.hz;
+
+    std::printf("==== report %d (%.0f MHz) ====\n", index, report.hz / 1e6);
+    std::printf("%-4s %-8s %10s %10s %10s %10s\n", "ctx", "name", "count", "min(us)", "mean(us)", "max(us)");
+    for (const Slot &s : report.slots) {
+        std::printf("%-4s %-8s %10llu %10.2f %10.2f %10.2f\n", s.ctx.c_str(), s.name.c_str(),
+                    (unsigned long long)s.n, s.min * us, s.mean * us, s.max * us);
+    }
+
+    std::printf("\nhistogram (upper bound of each bin, us):\n%-13s", "");
+    for (int i = 0; i < report.bins; i++) {
+        if (i == report.bins - 1) std::printf("%8s", "more");
+        else std::printf("%8.1f", BinUpper(report, i) * us);
+    }
+    std::printf("\n");
+    for (const Slot &s : report.slots) {
+        std::printf("%-4s %-8s", s.ctx.c_str(), s.name.c_str());
+        for (uint64_t v : s.hist) std::printf("%8llu", (unsigned long long)v);
+        std::printf("\n");
+    }
+    std::printf("\n");
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    std::ifstream file;
+    if (argc > 1) {
+        file.open(argv[1]);
+        if (!file) {
+            std::fprintf(stderr, "cannot open %s\n", argv[1]);
+            return 1;
+        }
+    }
+    std::istream &in = (argc > 1) ? static_cast<std::istream &>(file) : std::cin;
+
+    Report report;
+    bool active = false;
+    int count = 0;
+    std::string line;
+
+    while (std::getline(in, line)) {
+        auto pos = line.find("#PERF ");
+        if (pos == std::string::npos) continue;  // 其他调试输出
+
+        std::istringstream fields_in(line.substr(pos + 6));
+        std::string kind;
+        fields_in >> kind;
+
+        if (kind == "BEGIN") {
+            auto fields = ParseFields(fields_in);
+            report = Report();
+            if (fields.count("hz")) report.hz = std::stod(fields["hz"]);
+            if (fields.count("shift")) report.shift = std::stoi(fields["shift"]);
+            if (fields.count("bins")) report.bins = std::stoi(fields["bins"]);
+            active = true;
+        } else if (kind == "END") {
+            if (active) PrintReport(report, ++count);
+            active = false;
+        } else if (active && (kind == "isr" || kind == "task")) {
+            Slot slot;
+            slot.ctx = kind;
+            fields_in >> slot.name;
+            auto fields = ParseFields(fields_in);
+            try {
+                slot.n = std::stoull(fields["n"]);
+                slot.min = std::stoull(fields["min"]);
+                slot.max = std::stoull(fields["max"]);
+                slot.mean = std::stoull(fields["mean"]);
+                slot.hist = ParseList(fields["hist"]);
+            } catch (const std::exception &) {
+                std::fprintf(stderr, "skipped malformed line: %s\n", line.c_str());
+                continue;
+            }
+            slot.hist.resize(report.bins);
+            report.slots.push_back(slot);
+        }
+    }
+
+    if (count == 0) {
+        std::fprintf(stderr, "no complete #PERF report found\n");
+        return 1;
+    }
+    return 0;
+}
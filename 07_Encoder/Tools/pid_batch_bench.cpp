@@ -0,0 +1,129 @@
+// 批量速度环基准 (主机端工具)
+//
+// 对比 1/2/4/8 路控制器时, pid_batch_update 一次批量计算与逐路调用 pid_calculate_advanced (反算抗饱和) 的耗时,
+// 并逐路比较两者输出 (同一组系数与测量值, 含输出饱和)
+// 耗时为主机上的相对值: 标量版本每次调用还要做一次除法 (d_tau + dt) 和抗饱和方式分支,
+// 批量版本的系数按固定周期预先算好, 因此在 1~2 路 (AXIS_COUNT <= 2) 时也不比标量慢, 固件不保留标量路径
+// 输出不一致或 1~2 路时批量版本明显变慢 (超过标量的1.5倍) 时返回1
+//
+// 编译 (在 07_Encoder 目录下):
+//   gcc -O2 -c User/Module/PID/pid.c User/Module/PID/pid_batch.c
+//   g++ -std=c++17 -O2 -IUser/Module/PID -o pid_batch_bench Tools/pid_batch_bench.cpp pid.o pid_batch.o
+// 用法: pid_batch_bench
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "pid.h"
+#include "pid_batch.h"
+
+namespace {
+
+constexpr float kDt = 0.001f;           // CONTROL_RATE_HZ = 1000
+constexpr float kDTau = 0.02f;          // PID_SPEED_D_TAU
+constexpr float kLimit = 999.0f;
+constexpr int kInputs = 1024;           // 测量值序列长度 (循环使用)
+
+struct Lanes {
+    int n;
+    PIDBatch_T batch;
+    std::vector<PID_T> scalar;
+};
+
+void Init(Lanes &l, int n) {
+    l.n = n;
+    l.scalar.resize(n);
+    pid_batch_init(&l.batch, static_cast<uint8_t>(n), kLimit);
+    for (int i = 0; i < n; i++) {
+        // 各路增益不同, 与固件一样取 kb = ki/kp
+        float kp = 2.0f + i, ki = 40.0f + 10.0f * i, kd = (i & 1) ? 0.01f : 0.0f;
+        pid_batch_set_gains(&l.batch, static_cast<uint8_t>(i), kp, ki, kd, kDTau, 1.0f, ki / kp, kDt);
+        l.batch.target[i] = 60.0f + 20.0f * i;
+        l.batch.out_min[i] = -kLimit - 600.0f;
+        l.batch.out_max[i] = kLimit - 600.0f;
+
+        PID_T &p = l.scalar[i];
+        pid_init(&p, kp, ki, kd, l.batch.target[i], kLimit);
+        pid_set_d_filter(&p, kDTau);
+        pid_set_anti_windup(&p, PID_AW_BACK_CALC, ki / kp);
+        pid_set_output_limits(&p, l.batch.out_min[i], l.batch.out_max[i]);
+    }
+}
+
+// 测量值: 目标附近的噪声, 偶尔远离目标使输出饱和
+std::vector<float> MakeInputs(int n) {
+    std::mt19937 rng(11);
+    std::normal_distribution<float> noise(0.0f, 3.0f);
+    std::vector<float> v(static_cast<size_t>(kInputs) * n);
+    for (int t = 0; t < kInputs; t++) {
+        for (int i = 0; i < n; i++) {
+            float target = 60.0f + 20.0f * i;
+            v[static_cast<size_t>(t) * n + i] = (t % 256) < 32 ? target - 200.0f : target + noise(rng);
+        }
+    }
+    return v;
+}
+
+double Equivalence(int n) {
+    Lanes l;
+    Init(l, n);
+    std::vector<float> in = MakeInputs(n);
+    double worst = 0.0;
+    for (int t = 0; t < 5 * kInputs; t++) {
+        const float *y = &in[static_cast<size_t>(t % kInputs) * n];
+        pid_batch_update(&l.batch, y);
+        for (int i = 0; i < n; i++) {
+            float out = pid_calculate_advanced(&l.scalar[i], y[i], kDt);
+            worst = std::max(worst, static_cast<double>(std::fabs(out - l.batch.out[i])));
+        }
+    }
+    return worst;
+}
+
+template <typename F>
+double NsPerAxis(F &&f, int n) {
+    constexpr int kRounds = 5;
+    constexpr int kCalls = 2000000;
+    double best = 1e9;
+    for (int r = 0; r < kRounds; r++) {
+        auto t0 = std::chrono::steady_clock::now();
+        for (int c = 0; c < kCalls; c++) f(c & (kInputs - 1));
+        auto t1 = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::nano>(t1 - t0).count() / kCalls / n);
+    }
+    return best;
+}
+
+}  // namespace
+
+int main() {
+    bool ok = true;
+    std::printf("%5s %12s %12s %12s %10s\n", "lanes", "scalar ns/ax", "batch ns/ax", "speedup", "max diff");
+    for (int n : {1, 2, 4, 8}) {
+        Lanes l;
+        Init(l, n);
+        std::vector<float> in = MakeInputs(n);
+        volatile float sink = 0.0f;
+
+        double scalar = NsPerAxis([&](int t) {
+            const float *y = &in[static_cast<size_t>(t) * n];
+            for (int i = 0; i < n; i++) sink = pid_calculate_advanced(&l.scalar[i], y[i], kDt);
+        }, n);
+        double batch = NsPerAxis([&](int t) {
+            pid_batch_update(&l.batch, &in[static_cast<size_t>(t) * n]);
+            sink = l.batch.out[0];
+        }, n);
+        double diff = Equivalence(n);
+
+        std::printf("%5d %12.2f %12.2f %11.2fx %10.2g\n", n, scalar, batch, scalar / batch, diff);
+        ok &= diff < 1e-3;
+        if (n <= 2) ok &= batch < 1.5 * scalar;
+    }
+    std::printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,246 @@
+// 定点速度环等价性测试与基准 (主机端工具)
+//
+// 用同一组测量值同时驱动 pidq_calculate (Q16.16) 和 pid_calculate_advanced (浮点, 反算抗饱和),
+// 闭环对象为一阶惯性电机, 1kHz 控制周期, 反馈为编码器 speed_q16 (每周期计数的Q16低通, 与固件相同):
+//   场景: 阶跃/反向目标, 前馈变化 (限幅随之变化), 长时间输出饱和 (抗饱和), kd>0 (测量值微分滤波)
+//   另用 double 按同一算法计算参考输出, 比较定点/浮点各自与参考的最大误差, 以及两者之间的差值
+//   (浮点积分在几百PWM量级时每步舍入约1e-5, 长时间累积后误差反而大于定点)
+//   另检查极端输入下定点运算饱和而不回绕
+// 之后分别计时两种实现单次调用的耗时 (主机上的相对值, 板上周期数见 perf 报告)
+// 任一检查不通过时返回1
+//
+// 编译 (在 07_Encoder 目录下):
+//   gcc -O2 -c User/Module/PID/pid.c User/Module/PID/pid_q.c
+//   g++ -std=c++17 -O2 -IUser/Module/PID -o pid_q_test Tools/pid_q_test.cpp pid.o pid_q.o
+// 用法: pid_q_test
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "pid.h"
+#include "pid_q.h"
+
+namespace {
+
+constexpr float kDt = 0.001f;                    // CONTROL_RATE_HZ = 1000
+constexpr float kPpr = 1551.0f;                  // ENCODER_PPR
+constexpr float kRpmPerCount = 60.0f / (kPpr * kDt);
+constexpr int32_t kSpeedAlpha = static_cast<int32_t>(0.3f * 65536.0f);  // ENCODER_SPEED_Q_ALPHA
+constexpr float kOutLimit = 999.0f;
+constexpr float kDTau = 0.02f;                   // PID_SPEED_D_TAU
+constexpr double kMaxRefError = 0.2;             // 定点与参考的允许误差 (PWM, 主要来自系数的Q16量化, 如 kb*dt 约1092 LSB)
+constexpr double kMaxDiff = 0.5;                 // 定点与浮点的允许差值 (PWM, 小于输出分辨率1)
+
+struct Gains {
+    const char *name;
+    float kp, ki, kd, sp_weight;
+};
+
+// 一段: 目标转速与前馈
+struct Step {
+    int ticks;
+    float target_rpm;
+    float feedforward;
+};
+
+struct Result {
+    double fixed_error;     // 定点 - 参考
+    double float_error;     // 浮点 - 参考
+    double diff;            // 定点 - 浮点
+    int saturated_ticks;
+};
+
+// 参考实现: pid_calculate_advanced (反算抗饱和) 的 double 版本, 系数按定点的换算方式给出
+struct Reference {
+    double kp, ki_dt, kd_dt, d_alpha, kb_dt, sp_weight;
+    double target = 0, out_min = 0, out_max = 0;
+    double integral = 0, d_out = 0, last = 0;
+    bool primed = false;
+
+    Reference(const Gains &g, double kb) {
+        kp = g.kp;
+        ki_dt = static_cast<double>(g.ki) * kDt;
+        kd_dt = g.kd / (static_cast<double>(kDTau) + kDt);
+        d_alpha = kDTau / (static_cast<double>(kDTau) + kDt);
+        kb_dt = kb * kDt;
+        sp_weight = g.sp_weight;
+    }
+    double Update(double y) {
+        double error = target - y;
+        double p_out = kp * (sp_weight * target - y);
+        d_out = primed ? d_alpha * d_out - kd_dt * (y - last) : 0.0;
+        last = y;
+        primed = true;
+        double unsat = p_out + integral + d_out;
+        double out = std::fmax(out_min, std::fmin(out_max, unsat));
+        integral += ki_dt * error + kb_dt * (out - unsat);
+        return out;
+    }
+};
+
+Result Run(const Gains &g, const std::vector<Step> &steps) {
+    PID_T pid;
+    pid_init(&pid, g.kp, g.ki, g.kd, 0.0f, kOutLimit);
+    pid_set_setpoint_weight(&pid, g.sp_weight);
+    pid_set_d_filter(&pid, kDTau);
+    pid_set_anti_windup(&pid, PID_AW_BACK_CALC, g.kp > 0.0f ? g.ki / g.kp : 0.0f);
+
+    PIDQ_T pidq;
+    pidq_init(&pidq, g.kp, g.ki, g.kd, kDTau, g.sp_weight, g.kp > 0.0f ? g.ki / g.kp : 0.0f, kDt, kRpmPerCount);
+
+    Reference ref(g, g.kp > 0.0f ? g.ki / g.kp : 0.0f);
+
+    // 电机: 稳态转速 = (pwm - 529.2) / 1.30 (死区以下为0), 时间常数80ms, 最高约300rpm
+    std::mt19937 rng(3);
+    std::normal_distribution<double> ripple(0.0, 0.5);
+    double rpm = 0.0, theta = 0.0;
+    int64_t last_count = 0;
+    int32_t speed_q16 = 0;
+    float pwm = 0.0f;
+
+    Result r{0.0, 0.0, 0.0, 0};
+    for (const Step &s : steps) {
+        pid_set_target(&pid, s.target_rpm);
+        pidq_set_target(&pidq, PIDQ_FROM_FLOAT(s.target_rpm / kRpmPerCount));
+        pid_set_output_limits(&pid, -kOutLimit - s.feedforward, kOutLimit - s.feedforward);
+        pidq_set_output_limits(&pidq, PIDQ_FROM_FLOAT(-kOutLimit - s.feedforward),
+                               PIDQ_FROM_FLOAT(kOutLimit - s.feedforward));
+        // 参考使用定点实际量化后的目标和限幅, 只比较计算过程的误差
+        ref.target = static_cast<double>(pidq.target) / PIDQ_ONE * kRpmPerCount;
+        ref.out_min = static_cast<double>(pidq.out_min) / PIDQ_ONE;
+        ref.out_max = static_cast<double>(pidq.out_max) / PIDQ_ONE;
+
+        for (int t = 0; t < s.ticks; t++) {
+            double mag = std::fabs(pwm) > 529.2 ? (std::fabs(pwm) - 529.2) / 1.30 : 0.0;
+            double steady = std::copysign(std::fmin(mag, 300.0), pwm);
+            rpm += (steady - rpm) * kDt / 0.08;
+            theta += (rpm + ripple(rng)) / 60.0 * kPpr * kDt;
+
+            // Encoder_Driver_Update: 每周期计数 → speed_q16
+            int64_t count = static_cast<int64_t>(std::floor(theta));
+            int32_t sample = static_cast<int32_t>(count - last_count) * 65536;
+            last_count = count;
+            speed_q16 += static_cast<int32_t>((static_cast<int64_t>(sample - speed_q16) * kSpeedAlpha) >> 16);
+
+            float out_f = pid_calculate_advanced(&pid, speed_q16 / 65536.0f * kRpmPerCount, kDt);
+            double out_q = static_cast<double>(pidq_calculate(&pidq, speed_q16)) / PIDQ_ONE;
+            double out_r = ref.Update(static_cast<double>(speed_q16) / 65536.0 * kRpmPerCount);
+            r.fixed_error = std::fmax(r.fixed_error, std::fabs(out_q - out_r));
+            r.float_error = std::fmax(r.float_error, std::fabs(out_f - out_r));
+            r.diff = std::fmax(r.diff, std::fabs(out_f - out_q));
+            if (out_f <= pid.out_min || out_f >= pid.out_max) r.saturated_ticks++;
+            pwm = s.feedforward + out_f;
+        }
+    }
+    return r;
+}
+
+bool g_ok = true;
+void Check(bool cond, const char *what) {
+    std::printf("  %s: %s\n", cond ? "PASS" : "FAIL", what);
+    g_ok &= cond;
+}
+
+// 定点运算在极端输入下应饱和, 输出始终在限幅内且符号正确
+void TestSaturation() {
+    std::printf("saturation\n");
+    PIDQ_T pidq;
+    pidq_init(&pidq, 3.0f, 50.0f, 0.01f, kDTau, 1.0f, 50.0f / 3.0f, kDt, kRpmPerCount);
+    pidq_set_output_limits(&pidq, PIDQ_FROM_FLOAT(-kOutLimit), PIDQ_FROM_FLOAT(kOutLimit));
+
+    bool ok = true;
+    pidq_set_target(&pidq, INT32_MAX);
+    for (int i = 0; i < 10000; i++) ok &= pidq_calculate(&pidq, INT32_MIN) == pidq.out_max;
+    pidq_set_target(&pidq, INT32_MIN);
+    int32_t out = 0;
+    for (int i = 0; i < 10000; i++) out = pidq_calculate(&pidq, INT32_MAX);
+    ok &= out == pidq.out_min;
+    Check(ok, "full-scale target and measurement saturate to the limits without wrapping");
+
+    // 误差归零后反算抗饱和把积分拉回到限幅处, 不停留在 INT32_MIN
+    pidq_set_target(&pidq, 0);
+    for (int i = 0; i < 2000; i++) out = pidq_calculate(&pidq, 0);
+    Check(out == pidq.out_min && std::abs(pidq.integral - pidq.out_min) < PIDQ_ONE,
+          "back-calculation pulls the saturated integral back to the limit");
+}
+
+template <typename F>
+double NsPerCall(F &&f, int calls) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < calls; i++) f(i);
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / calls;
+}
+
+void Bench() {
+    std::printf("benchmark (host, ns per call)\n");
+    constexpr int kCalls = 20000000;
+    std::vector<int32_t> input(1024);
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int32_t> d(-40 * PIDQ_ONE, 40 * PIDQ_ONE);
+    for (int32_t &v : input) v = d(rng);
+
+    PID_T pid;
+    pid_init(&pid, 3.0f, 50.0f, 0.0f, 20.0f, kOutLimit);
+    pid_set_d_filter(&pid, kDTau);
+    pid_set_anti_windup(&pid, PID_AW_BACK_CALC, 50.0f / 3.0f);
+    PIDQ_T pidq;
+    pidq_init(&pidq, 3.0f, 50.0f, 0.0f, kDTau, 1.0f, 50.0f / 3.0f, kDt, kRpmPerCount);
+    pidq_set_output_limits(&pidq, PIDQ_FROM_FLOAT(-kOutLimit), PIDQ_FROM_FLOAT(kOutLimit));
+    pidq_set_target(&pidq, PIDQ_FROM_FLOAT(20.0f / kRpmPerCount));
+
+    volatile float sink_f = 0.0f;
+    volatile int32_t sink_q = 0;
+    double ns_f = NsPerCall([&](int i) {
+        sink_f = pid_calculate_advanced(&pid, input[i & 1023] / 65536.0f * kRpmPerCount, kDt);
+    }, kCalls);
+    double ns_q = NsPerCall([&](int i) { sink_q = pidq_calculate(&pidq, input[i & 1023]); }, kCalls);
+    std::printf("  pid_calculate_advanced %6.2f\n  pidq_calculate         %6.2f\n", ns_f, ns_q);
+}
+
+}  // namespace
+
+int main() {
+    const std::vector<Step> steps = {
+        {500, 0.0f, 0.0f},
+        {1500, 120.0f, 685.2f},         // 阶跃 (前馈 = 1.30*rpm + 529.2)
+        {1500, 40.0f, 581.2f},          // 减速
+        {1500, 250.0f, 854.2f},         // 接近饱和
+        {2000, 350.0f, 984.2f},         // 超过电机最高转速, 输出长时间饱和
+        {1500, 60.0f, 607.2f},          // 退出饱和
+        {2000, -80.0f, -633.2f},        // 反向
+        {1500, 0.0f, 0.0f},             // 停止
+        {8000, 16.0f, 550.0f},          // 低速长时间保持
+    };
+    const Gains gains[] = {
+        {"firmware default (kp 3, ki 50)", 3.0f, 50.0f, 0.0f, 1.0f},
+        {"with derivative (kd 0.02)", 3.0f, 50.0f, 0.02f, 1.0f},
+        {"setpoint weight 0.5, high gain", 8.0f, 200.0f, 0.01f, 0.5f},
+    };
+
+    std::printf("equivalence (max error in PWM)\n  %-32s %10s %10s %10s %10s\n", "gains", "fixed-ref", "float-ref",
+                "fixed-flt", "saturated");
+    bool ref_ok = true, closer_ok = true, diff_ok = true, sat_ok = true;
+    for (const Gains &g : gains) {
+        Result r = Run(g, steps);
+        std::printf("  %-32s %10.5f %10.5f %10.5f %10d\n", g.name, r.fixed_error, r.float_error, r.diff,
+                    r.saturated_ticks);
+        ref_ok &= r.fixed_error < kMaxRefError;
+        closer_ok &= r.fixed_error <= r.float_error;
+        diff_ok &= r.diff < kMaxDiff;
+        sat_ok &= r.saturated_ticks > 0;
+    }
+    Check(ref_ok, "fixed-point output within 0.2 PWM of the double reference");
+    Check(closer_ok, "fixed-point is no further from the reference than float");
+    Check(diff_ok, "fixed-point and float outputs differ by less than one PWM count");
+    Check(sat_ok, "output saturation exercised in every run");
+
+    TestSaturation();
+    Bench();
+    std::printf("%s\n", g_ok ? "PASS" : "FAIL");
+    return g_ok ? 0 : 1;
+}
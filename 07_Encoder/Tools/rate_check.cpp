@@ -0,0 +1,177 @@
+// 控制频率一致性检查 (主机端工具)
+//
+// 在 CONTROL_RATE_HZ = 100 / 500 / 1000 / 2000 下运行同一条速度曲线, 检查轨迹与控制频率无关:
+//   外环 100Hz (CONTROL_OUTER_RATE_HZ): scurve_eval 按整数周期数求曲线时间, 给出目标转速和线性前馈
+//   内环 CONTROL_RATE_HZ: 量化编码器 → alpha-beta-gamma 估计器 (vel_filter_abg_rescale 换算到该周期)
+//                        → pid_batch_update (系数按该周期预算) → 整数PWM
+//   电机: 一阶惯性 (死区以下为0), 以 10us 步长积分, PWM 在内环周期内保持
+// 检查: 各频率的最终路程与 1000Hz 相差不超过 0.35%, 全程位置与 1000Hz 的最大偏差不超过总路程的 0.35%,
+//       最终路程与曲线规划路程相差不超过 0.35%, 匀速段PWM波动小 (速度环与估计器耦合时会出现跨越死区的极限环)
+// 任一检查不通过时返回1
+//
+// 编译 (在 07_Encoder 目录下):
+//   gcc -O2 -c User/Module/Profile/scurve.c User/Module/PID/pid_batch.c User/Module/Filter/velocity_filter.c
+//   g++ -std=c++17 -O2 -IUser/Module/Profile -IUser/Module/PID -IUser/Module/Filter -o rate_check Tools/rate_check.cpp scurve.o pid_batch.o velocity_filter.o
+// 用法: rate_check
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "pid_batch.h"
+#include "scurve.h"
+#include "velocity_filter.h"
+
+namespace {
+
+constexpr int kRates[] = {100, 500, 1000, 2000};
+constexpr int kBaseRate = 1000;
+constexpr int kOuterHz = 100;                    // CONTROL_OUTER_RATE_HZ
+constexpr double kStep = 1e-5;                   // 电机积分步长
+constexpr double kPpr = 1551.0;                  // ENCODER_PPR
+constexpr float kAbgAlpha = 0.8f, kAbgBeta = 0.5f, kAbgGamma = 0.02f, kAbgRefDt = 0.01f;  // ENCODER_ABG_*
+constexpr float kKp = 3.0f, kKi = 50.0f;         // pid_params_default
+constexpr float kDTau = 0.02f;                   // PID_SPEED_D_TAU
+constexpr float kLimit = 999.0f;
+constexpr double kTolerance = 0.0035;            // 0.35%
+constexpr double kSettle = 0.5;                  // 曲线结束后继续运行的时间(s)
+constexpr double kMaxCruiseRipple = 50.0;        // 匀速段PWM标准差上限
+
+struct Profile {
+    const char *name;
+    SCurveLimits_T limits;
+    float cruise_time;
+};
+
+struct Trace {
+    std::vector<double> position;   // 每个外环周期末的位置 (圈)
+    double planned = 0.0;           // 规划路程 (圈, 含结束后按结束速度运行的部分)
+    double cruise_ripple = 0.0;     // 匀速段PWM标准差
+};
+
+// 线性前馈 PWM = 1.30 * rpm + 529.2 (motor_app.c 未标定时)
+float Feedforward(float rpm) {
+    if (rpm == 0.0f) return 0.0f;
+    return std::copysign(1.30f * std::fabs(rpm) + 529.2f, rpm);
+}
+
+Trace Run(const Profile &prof, int rate) {
+    const float dt = 1.0f / static_cast<float>(rate);
+    const int inner_per_outer = rate / kOuterHz;
+    const int steps_per_inner = static_cast<int>(std::lround(1.0 / rate / kStep));
+
+    SCurve_T curve;
+    scurve_plan_velocity(&curve, &prof.limits, prof.cruise_time);
+
+    VelFilter_T filter;
+    float alpha = kAbgAlpha, beta = kAbgBeta, gamma = kAbgGamma;
+    vel_filter_abg_rescale(&alpha, &beta, &gamma, kAbgRefDt, dt);
+    vel_filter_init_abg(&filter, alpha, beta, gamma);
+
+    PIDBatch_T pid;
+    pid_batch_init(&pid, 1, kLimit);
+    pid_batch_set_gains(&pid, 0, kKp, kKi, 0.0f, kDTau, 1.0f, kKi / kKp, dt);
+
+    Trace trace;
+    double ripple_sum = 0.0, ripple_sum2 = 0.0;
+    int ripple_n = 0;
+    const float cps = static_cast<float>(kPpr / 60.0);
+    double rpm = 0.0, theta = 0.0;
+    int pwm = 0;
+    const uint32_t outer_ticks = static_cast<uint32_t>(std::ceil((curve.total_time + kSettle) * kOuterHz));
+    const double end_time = static_cast<double>(outer_ticks) / kOuterHz;
+    trace.planned = (curve.distance + prof.limits.v_end * (end_time - curve.total_time)) / 60.0;
+
+    for (uint32_t tick = 1; tick <= outer_ticks; tick++) {
+        // 外环: 与 Motor_Profile_Step 相同, 时间由整数周期数换算
+        SCurvePoint_T sp;
+        scurve_eval(&curve, static_cast<float>(tick) / kOuterHz, &sp);
+        float target = tick * (1.0 / kOuterHz) > curve.total_time ? prof.limits.v_end : sp.v;
+        float ff = Feedforward(target);
+        pid.target[0] = target;
+        pid.out_min[0] = -kLimit - ff;
+        pid.out_max[0] = kLimit - ff;
+
+        for (int k = 0; k < inner_per_outer; k++) {
+            for (int s = 0; s < steps_per_inner; s++) {
+                double mag = std::abs(pwm) > 529.2 ? (std::abs(pwm) - 529.2) / 1.30 : 0.0;
+                double steady = pwm >= 0 ? mag : -mag;
+                rpm += (steady - rpm) * kStep / 0.08;
+                theta += rpm / 60.0 * kPpr * kStep;
+            }
+            // 内环: 编码器计数 → 估计器 → 速度环
+            int64_t count = static_cast<int64_t>(std::floor(theta));
+            float feedback = vel_filter_update(&filter, count, 0.0f, dt) / cps;
+            pid_batch_update(&pid, &feedback);
+            pwm = static_cast<int>(ff + pid.out[0]);
+
+            // 匀速段 (跳过开头0.5s的过渡)
+            double t = static_cast<double>(tick) / kOuterHz;
+            if (t > curve.t0[3] + 0.5 && t < curve.t0[4]) {
+                ripple_sum += pwm;
+                ripple_sum2 += static_cast<double>(pwm) * pwm;
+                ripple_n++;
+            }
+        }
+        trace.position.push_back(theta / kPpr);
+    }
+    if (ripple_n > 0) {
+        double mean = ripple_sum / ripple_n;
+        trace.cruise_ripple = std::sqrt(std::fmax(0.0, ripple_sum2 / ripple_n - mean * mean));
+    }
+    return trace;
+}
+
+bool g_ok = true;
+void Check(bool cond, const char *what) {
+    std::printf("  %s: %s\n", cond ? "PASS" : "FAIL", what);
+    g_ok &= cond;
+}
+
+void RunProfile(const Profile &prof) {
+    std::printf("%s\n", prof.name);
+    std::vector<Trace> traces;
+    const Trace *base = nullptr;
+    for (int rate : kRates) traces.push_back(Run(prof, rate));
+    for (size_t i = 0; i < traces.size(); i++) {
+        if (kRates[i] == kBaseRate) base = &traces[i];
+    }
+
+    const double total = base->position.back();
+    double worst_final = 0.0, worst_path = 0.0, worst_plan = 0.0, worst_ripple = 0.0;
+    std::printf("  %6s %12s %12s %12s %12s\n", "Hz", "final(rev)", "vs 1kHz", "max path dev", "cruise PWM");
+    for (size_t i = 0; i < traces.size(); i++) {
+        const Trace &t = traces[i];
+        double final_dev = (t.position.back() - total) / total;
+        double path_dev = 0.0;
+        for (size_t k = 0; k < t.position.size() && k < base->position.size(); k++) {
+            path_dev = std::fmax(path_dev, std::fabs(t.position[k] - base->position[k]) / total);
+        }
+        worst_final = std::fmax(worst_final, std::fabs(final_dev));
+        worst_path = std::fmax(worst_path, path_dev);
+        worst_plan = std::fmax(worst_plan, std::fabs(t.position.back() - t.planned) / t.planned);
+        worst_ripple = std::fmax(worst_ripple, t.cruise_ripple);
+        std::printf("  %6d %12.4f %11.3f%% %11.3f%% %10.1f sd\n", kRates[i], t.position.back(), final_dev * 100.0,
+                    path_dev * 100.0, t.cruise_ripple);
+    }
+    std::printf("  planned %.4f rev, worst deviation from plan %.3f%%\n", base->planned, worst_plan * 100.0);
+    Check(worst_final <= kTolerance, "final distance within 0.35% of 1 kHz at every rate");
+    Check(worst_path <= kTolerance, "position along the path within 0.35% of the distance at every rate");
+    Check(worst_plan <= kTolerance, "final distance within 0.35% of the planned distance");
+    Check(worst_ripple < kMaxCruiseRipple, "no limit cycle: cruise PWM standard deviation under 50");
+}
+
+}  // namespace
+
+int main() {
+    const Profile profiles[] = {
+        // 0 → 200rpm → 0 的S曲线
+        {"S-curve 0->200->0 rpm", {0.0f, 200.0f, 0.0f, 100.0f, 100.0f, 200.0f}, 2.0f},
+        // Trapezoid 模式默认参数 (15 → 115 → 15 rpm, 20 rpm/s, jerk 40, 匀速10s)
+        {"trapezoid default 15->115->15 rpm", {15.0f, 115.0f, 15.0f, 20.0f, 20.0f, 40.0f}, 10.0f},
+    };
+    for (const Profile &p : profiles) RunProfile(p);
+    std::printf("%s\n", g_ok ? "PASS" : "FAIL");
+    return g_ok ? 0 : 1;
+}
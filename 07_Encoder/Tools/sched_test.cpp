@@ -0,0 +1,235 @@
+// 调度核心测试 (主机端工具)
+//
+// 用模拟节拍驱动 Module/Sched, 起始时刻取 2^32 - 256, 所有用例都跨过节拍计数回绕:
+//   回绕: 不同周期/相位的任务逐节拍调用 sched_run_one, 每次执行时刻 = 启动时刻 + 相位 + k × 周期, 无漂移无错过
+//   超时: sched_run_one 晚于释放时刻执行时统计最大延迟, 跳过错过的周期 (不补跑), 之后仍按原相位释放
+//   抢占式: sched_release 的 _pending 中的任务不重复激活并计为错过, sched_begin 按激活对应的释放时刻统计延迟
+//   优先级: 同一节拍到期的任务按优先级执行, 同优先级先到期的先执行, 再按任务表顺序
+//   使能: sched_enable 禁止期间不执行不计错过, 重新使能时对齐到原相位上不早于当前时刻的释放时刻
+// 任一检查不通过时返回1
+//
+// 编译 (在 07_Encoder 目录下):
+//   gcc -O2 -c User/Module/Sched/sched.c
+//   g++ -std=c++17 -O2 -IUser/Module/Sched -o sched_test Tools/sched_test.cpp sched.o
+// 用法: sched_test
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "sched.h"
+
+namespace {
+
+constexpr uint32_t kStart = 0xFFFFFF00u;     // 2^32 - 256
+
+struct Run {
+    int id;
+    uint32_t now;
+};
+
+uint32_t g_now;
+std::vector<Run> g_log;
+
+template <int N>
+void Task() { g_log.push_back({N, g_now}); }
+
+SchedTask_T MakeTask(void (*func)(void), uint32_t period, uint32_t phase, uint8_t priority, const char *name) {
+    SchedTask_T t = {};
+    t.func = func;
+    t.period = period;
+    t.phase = phase;
+    t.priority = priority;
+    t.enabled = 1;
+    t.name = name;
+    return t;
+}
+
+// 协作式: 每个节拍执行完所有到期任务
+void RunTicks(Sched_T &s, uint32_t from, uint32_t ticks) {
+    for (uint32_t k = 0; k < ticks; k++) {
+        g_now = from + k;
+        while (sched_run_one(&s, g_now) != nullptr) {}
+    }
+}
+
+bool g_ok = true;
+void Check(bool cond, const char *what) {
+    std::printf("  %s: %s\n", cond ? "PASS" : "FAIL", what);
+    g_ok &= cond;
+}
+
+void TestWrap() {
+    std::printf("wrap at 2^32 - 256\n");
+    SchedTask_T tasks[] = {
+        MakeTask(Task<0>, 1, 0, 2, "1ms"),
+        MakeTask(Task<1>, 10, 3, 0, "10ms"),
+        MakeTask(Task<2>, 7, 5, 1, "7ms"),
+        MakeTask(Task<3>, 100, 99, 1, "100ms"),
+    };
+    Sched_T s;
+    sched_init(&s, tasks, 4, kStart);
+    g_log.clear();
+    constexpr uint32_t kTicks = 1000;
+    RunTicks(s, kStart, kTicks);
+
+    bool on_time = true;
+    uint32_t count[4] = {};
+    for (const Run &r : g_log) {
+        const SchedTask_T &t = tasks[r.id];
+        uint32_t expect = kStart + t.phase + count[r.id] * t.period;
+        on_time &= r.now == expect;
+        count[r.id]++;
+    }
+    bool counts = true, stats = true;
+    for (int i = 0; i < 4; i++) {
+        uint32_t expect = (kTicks - tasks[i].phase + tasks[i].period - 1) / tasks[i].period;
+        counts &= count[i] == expect && tasks[i].runs == expect;
+        stats &= tasks[i].misses == 0 && tasks[i].max_late == 0;
+    }
+    Check(on_time, "every run at start + phase + k * period across the wrap");
+    Check(counts, "run counts match the elapsed periods");
+    Check(stats, "no misses and no lateness");
+}
+
+void TestOverrun() {
+    std::printf("overrun\n");
+    SchedTask_T tasks[] = {MakeTask(Task<0>, 5, 2, 0, "5ms")};
+    Sched_T s;
+    sched_init(&s, tasks, 1, kStart + 250);     // 首次释放 2^32 - 4
+    g_log.clear();
+
+    // 首次释放后 12 个节拍才执行 (跨过回绕): 延迟12, 跳过2个周期
+    g_now = kStart + 264;
+    SchedTask_T *ran = sched_run_one(&s, g_now);
+    Check(ran == &tasks[0] && tasks[0].max_late == 12, "late run records max_late = 12");
+    Check(tasks[0].misses == 2, "two skipped periods counted as misses, not replayed");
+    Check(sched_run_one(&s, g_now) == nullptr, "no catch-up run in the same tick");
+    Check(tasks[0].release == kStart + 267u, "next release stays on the original phase");
+
+    // 之后按时执行, 统计不变
+    RunTicks(s, g_now + 1, 30);
+    bool on_time = g_log.size() == 7;
+    for (size_t k = 1; k < g_log.size(); k++) on_time &= g_log[k].now == kStart + 267u + (k - 1) * 5;
+    Check(on_time && tasks[0].misses == 2 && tasks[0].max_late == 12, "back on schedule after the overrun");
+
+    sched_reset_stats(&s);
+    Check(tasks[0].runs == 0 && tasks[0].misses == 0 && tasks[0].max_late == 0, "sched_reset_stats clears statistics");
+}
+
+void TestRelease() {
+    std::printf("sched_release\n");
+    SchedTask_T tasks[] = {
+        MakeTask(Task<0>, 1, 0, 0, "hi"),
+        MakeTask(Task<1>, 4, 1, 1, "lo"),
+    };
+    Sched_T s;
+    sched_init(&s, tasks, 2, kStart + 254);
+
+    uint32_t pending = 0;
+    uint32_t mask = sched_release(&s, kStart + 254, pending);
+    Check(mask == 0x1u, "only the due task is released");
+    pending |= mask;
+
+    // 上一次激活还未执行: 不重复激活, 计为错过
+    mask = sched_release(&s, kStart + 255, pending);
+    Check(mask == 0x2u && tasks[0].misses == 1, "pending task not re-posted, counted as a miss");
+    pending |= mask;
+
+    // 跨过回绕后开始执行: 延迟按激活对应的释放时刻计算
+    sched_begin(&tasks[0], kStart + 257);
+    sched_begin(&tasks[1], kStart + 258);
+    pending = 0;
+    Check(tasks[0].max_late == 3 && tasks[1].max_late == 3, "sched_begin measures lateness from the activation");
+    Check(tasks[0].runs == 1 && tasks[1].runs == 1, "sched_begin counts runs");
+
+    // 节拍中断停了一段时间: 一次补上跳过的周期, 只激活一次
+    mask = sched_release(&s, kStart + 265, pending);
+    Check(mask == 0x3u, "both tasks released once after a stalled tick");
+    Check(tasks[0].misses == 1 + 9 && tasks[1].misses == 1, "skipped periods counted as misses");
+    Check(tasks[0].release == kStart + 266u && tasks[1].release == kStart + 267u, "releases stay on phase");
+}
+
+void TestPriority() {
+    std::printf("priority order\n");
+    SchedTask_T tasks[] = {
+        MakeTask(Task<0>, 10, 0, 2, "p2"),
+        MakeTask(Task<1>, 10, 0, 1, "p1 (table first)"),
+        MakeTask(Task<2>, 10, 0, 0, "p0"),
+        MakeTask(Task<3>, 10, 0, 1, "p1 (table second)"),
+        MakeTask(Task<4>, 10, 254, 1, "p1 (released earlier)"),
+    };
+    Sched_T s;
+    sched_init(&s, tasks, 5, kStart);
+    // 任务4先到期, 但在所有任务都到期的节拍(回绕后)才开始执行
+    tasks[0].release = tasks[1].release = tasks[2].release = tasks[3].release = kStart + 256;
+    g_log.clear();
+    g_now = kStart + 256;
+    while (sched_run_one(&s, g_now) != nullptr) {}
+
+    const int expect[] = {2, 4, 1, 3, 0};
+    bool order = g_log.size() == 5;
+    for (size_t k = 0; order && k < 5; k++) order &= g_log[k].id == expect[k];
+    Check(order, "priority first, then earlier release, then table order");
+
+    // 长任务执行期间到期的高优先级任务排在剩下的低优先级任务之前
+    SchedTask_T tasks2[] = {
+        MakeTask(Task<0>, 10, 0, 0, "hi"),
+        MakeTask(Task<1>, 10, 0, 1, "mid"),
+        MakeTask(Task<2>, 1, 0, 0, "tick"),
+        MakeTask(Task<3>, 10, 0, 2, "lo"),
+    };
+    sched_init(&s, tasks2, 4, kStart + 255);
+    tasks2[2].release = kStart + 257;
+    g_log.clear();
+    g_now = kStart + 255;
+    sched_run_one(&s, g_now);           // hi
+    sched_run_one(&s, g_now);           // mid, 执行了3个节拍
+    g_now += 3;
+    while (sched_run_one(&s, g_now) != nullptr) {}
+    Check(g_log.size() == 4 && g_log[2].id == 2 && g_log[3].id == 3, "task due during a long run goes before lower priority");
+}
+
+void TestEnable() {
+    std::printf("sched_enable\n");
+    SchedTask_T tasks[] = {MakeTask(Task<0>, 10, 3, 0, "10ms")};
+    Sched_T s;
+    sched_init(&s, tasks, 1, kStart + 200);     // 释放时刻 2^32-53, -43, -33, ...
+    g_log.clear();
+    RunTicks(s, kStart + 200, 15);
+    Check(g_log.size() == 2, "runs before disable");
+
+    sched_enable(&tasks[0], 0, kStart + 215);
+    RunTicks(s, kStart + 215, 32);              // 跨过回绕
+    Check(g_log.size() == 2 && tasks[0].misses == 0, "no runs and no misses while disabled");
+
+    // 在两次释放之间重新使能: 下一次释放对齐到原相位
+    sched_enable(&tasks[0], 1, kStart + 247);
+    Check(tasks[0].release == kStart + 253u, "re-enabled between releases aligns to the next phase slot");
+    RunTicks(s, kStart + 247, 20);
+    Check(g_log.size() == 4 && g_log[2].now == kStart + 253u && g_log[3].now == kStart + 263u,
+          "runs resume on the original phase");
+    Check(tasks[0].misses == 0 && tasks[0].max_late == 0, "disabled span not counted as misses");
+
+    // 正好在释放时刻重新使能: 当前节拍执行
+    sched_enable(&tasks[0], 0, kStart + 267);
+    sched_enable(&tasks[0], 1, kStart + 303);
+    Check(tasks[0].release == kStart + 303u, "re-enabled on a release slot runs in that tick");
+
+    // 释放时刻还没到时重新使能: 不改变释放时刻
+    sched_enable(&tasks[0], 0, kStart + 300);
+    sched_enable(&tasks[0], 1, kStart + 301);
+    Check(tasks[0].release == kStart + 303u, "re-enabled before the pending release keeps it");
+}
+
+}  // namespace
+
+int main() {
+    TestWrap();
+    TestOverrun();
+    TestRelease();
+    TestPriority();
+    TestEnable();
+    std::printf("%s\n", g_ok ? "PASS" : "FAIL");
+    return g_ok ? 0 : 1;
+}
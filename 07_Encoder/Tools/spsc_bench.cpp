@@ -0,0 +1,334 @@
+// 单生产者单消费者环形缓冲区压力测试与吞吐量对比 (主机端工具)
+//
+// 1. 压力测试: 生产者/消费者两个线程, 随机混用整块读写和连续区间操作, 校验字节序列
+//    (缓冲区空/满时让出CPU, 单核主机上也能运行)
+// 2. 吞吐量: User/Module/Spsc 与 User/Module/Ringbuffer (rt_ringbuffer) 单线程写入+读出,
+//    原地写入 (rt_ringbuffer_reserve/commit 与 spsc_write_span/commit, 串口驱动格式化输出的方式, 先校验字节序列),
+//    零拷贝读出 (rt_ringbuffer_peek_linear/discard 与 spsc_read_span/release, 串口驱动交给DMA发送的方式),
+//    以及 Spsc 两个线程并发
+// 3. rt_ringbuffer 两个线程并发: 读写位置位域共用一个字, 统计序列错误 (多核主机上预期非0)
+//
+// 编译 (在 07_Encoder 目录下):
+//   gcc -O2 -c User/Module/Spsc/spsc.c User/Module/Ringbuffer/ringbuffer.c
+//   g++ -std=c++17 -O2 -pthread -IUser/Module/Spsc -IUser/Module/Ringbuffer -o spsc_bench Tools/spsc_bench.cpp spsc.o ringbuffer.o
+// 用法: spsc_bench [压力测试字节数, 默认 1e9]
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "ringbuffer.h"
+#include "spsc.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double Seconds(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// 第 i 个字节的期望值 (周期与2的幂不同, 错位能被发现)
+inline uint8_t Pattern(uint64_t i) { return static_cast<uint8_t>((i * 131u + (i >> 8)) % 251u); }
+
+// 两个线程, 随机混用 spsc_write / spsc_write_span 和 spsc_read / spsc_read_span
+bool StressSpsc(uint32_t ring_size, uint64_t total) {
+    std::vector<uint8_t> pool(ring_size);
+    Spsc_T ring;
+    spsc_init(&ring, pool.data(), ring_size);
+    std::atomic<uint64_t> errors{0};
+
+    std::thread producer([&] {
+        std::mt19937 rng(1);
+        std::vector<uint8_t> chunk(ring_size);
+        uint64_t sent = 0;
+        while (sent < total) {
+            uint32_t want = 1 + rng() % ring_size;
+            if (want > total - sent) want = static_cast<uint32_t>(total - sent);
+            if (rng() & 1) {
+                for (uint32_t i = 0; i < want; i++) chunk[i] = Pattern(sent + i);
+                uint32_t n = spsc_write(&ring, chunk.data(), want);
+                if (n == 0) std::this_thread::yield();
+                sent += n;
+            } else {
+                uint8_t *ptr, *wrap_ptr;
+                uint32_t wrap_len;
+                uint32_t span = spsc_write_span(&ring, &ptr, &wrap_ptr, &wrap_len);
+                if (want > span + wrap_len) want = span + wrap_len;
+                for (uint32_t i = 0; i < want; i++) (i < span ? ptr[i] : wrap_ptr[i - span]) = Pattern(sent + i);
+                spsc_write_commit(&ring, want);
+                if (want == 0) std::this_thread::yield();
+                sent += want;
+            }
+        }
+    });
+
+    std::thread consumer([&] {
+        std::mt19937 rng(2);
+        std::vector<uint8_t> chunk(ring_size);
+        uint64_t got = 0;
+        while (got < total) {
+            uint32_t want = 1 + rng() % ring_size;
+            if (rng() & 1) {
+                uint32_t n = spsc_read(&ring, chunk.data(), want);
+                for (uint32_t i = 0; i < n; i++) errors += chunk[i] != Pattern(got + i);
+                if (n == 0) std::this_thread::yield();
+                got += n;
+            } else {
+                uint8_t *ptr;
+                uint32_t n = spsc_read_span(&ring, &ptr);
+                if (n > want) n = want;
+                for (uint32_t i = 0; i < n; i++) errors += ptr[i] != Pattern(got + i);
+                spsc_read_release(&ring, n);
+                if (n == 0) std::this_thread::yield();
+                got += n;
+            }
+        }
+    });
+
+    auto start = Clock::now();
+    producer.join();
+    consumer.join();
+    std::printf("  ring %5u B: %llu MB checked, %llu errors, %.2f s\n", ring_size,
+                static_cast<unsigned long long>(total >> 20), static_cast<unsigned long long>(errors.load()),
+                Seconds(start));
+    return errors == 0;
+}
+
+// 单线程: 写入一块再读出一块, 比较两种实现每字节的开销
+template <typename Put, typename Get>
+double SingleThreadMBs(uint32_t chunk, Put put, Get get) {
+    std::vector<uint8_t> in(chunk, 0x5a), out(chunk);
+    const uint64_t total = 1ull << 30;
+    auto start = Clock::now();
+    for (uint64_t done = 0; done < total; done += chunk) {
+        put(in.data(), chunk);
+        get(out.data(), chunk);
+    }
+    return total / Seconds(start) / 1e6;
+}
+
+// 原地写入: 把 chunk 字节按空闲区的两段 (折返前/后) 写入后提交, 与 Uart_Printf 相同
+template <typename Reserve, typename Commit>
+void WriteInPlace(Reserve reserve, Commit commit, uint64_t start, uint32_t chunk) {
+    uint8_t *ptr, *wrap_ptr;
+    uint32_t wrap_len;
+    uint32_t span = reserve(&ptr, &wrap_ptr, &wrap_len);
+    if (chunk > span + wrap_len) return;
+    for (uint32_t i = 0; i < chunk; i++) (i < span ? ptr[i] : wrap_ptr[i - span]) = Pattern(start + i);
+    commit(chunk);
+}
+
+// 单线程随机长度原地写入、随机长度读出, 校验字节序列 (覆盖折返)
+template <typename Reserve, typename Commit, typename Get>
+bool CheckInPlace(const char *name, Reserve reserve, Commit commit, Get get) {
+    std::mt19937 rng(3);
+    std::vector<uint8_t> out(1024);
+    uint64_t sent = 0, got = 0, errors = 0;
+    for (int k = 0; k < 200000; k++) {
+        uint32_t chunk = 1 + rng() % 300;
+        uint64_t before = sent;
+        WriteInPlace(reserve, [&](uint32_t n) { commit(n); sent += n; }, before, chunk);
+        uint32_t n = get(out.data(), 1 + rng() % 400);
+        for (uint32_t i = 0; i < n; i++) errors += out[i] != Pattern(got + i);
+        got += n;
+    }
+    std::printf("  %-34s %llu KB checked, %llu errors\n", name, static_cast<unsigned long long>(got >> 10),
+                static_cast<unsigned long long>(errors));
+    return errors == 0 && got > 0;
+}
+
+// Spsc 两个线程并发吞吐量
+double TwoThreadSpscMBs(uint32_t ring_size, uint32_t chunk) {
+    std::vector<uint8_t> pool(ring_size);
+    Spsc_T ring;
+    spsc_init(&ring, pool.data(), ring_size);
+    const uint64_t total = 1ull << 31;
+
+    auto start = Clock::now();
+    std::thread producer([&] {
+        std::vector<uint8_t> in(chunk, 0x5a);
+        for (uint64_t sent = 0; sent < total;) {
+            uint32_t n = spsc_write(&ring, in.data(), chunk);
+            if (n == 0) std::this_thread::yield();
+            sent += n;
+        }
+    });
+    std::vector<uint8_t> out(chunk);
+    for (uint64_t got = 0; got < total;) {
+        uint32_t n = spsc_read(&ring, out.data(), chunk);
+        if (n == 0) std::this_thread::yield();
+        got += n;
+    }
+    producer.join();
+    return total / Seconds(start) / 1e6;
+}
+
+// rt_ringbuffer 两个线程并发 (原串口驱动的用法), 统计序列错误; 限时运行
+void RaceRtRingbuffer(double seconds) {
+    static uint8_t pool[1024];
+    struct rt_ringbuffer rb;
+    rt_ringbuffer_init(&rb, pool, sizeof(pool));
+    std::atomic<bool> stop{false};
+    uint64_t errors = 0, got = 0;
+
+    std::thread producer([&] {
+        uint8_t chunk[64];
+        uint64_t sent = 0;
+        while (!stop) {
+            for (uint32_t i = 0; i < sizeof(chunk); i++) chunk[i] = Pattern(sent + i);
+            rt_size_t n = rt_ringbuffer_put(&rb, chunk, sizeof(chunk));
+            if (n == 0) std::this_thread::yield();
+            sent += n;
+        }
+    });
+
+    auto start = Clock::now();
+    uint8_t chunk[64];
+    while (Seconds(start) < seconds) {
+        rt_size_t n = rt_ringbuffer_get(&rb, chunk, sizeof(chunk));
+        for (rt_size_t i = 0; i < n; i++) {
+            if (chunk[i] != Pattern(got + i)) errors++;
+        }
+        if (n == 0) std::this_thread::yield();
+        got += n;
+    }
+    stop = true;
+    producer.join();
+    std::printf("  rt_ringbuffer 2 threads: %llu MB read, %llu sequence errors\n",
+                static_cast<unsigned long long>(got >> 20), static_cast<unsigned long long>(errors));
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    uint64_t total = argc > 1 ? std::strtoull(argv[1], nullptr, 0) : 1000000000ull;
+    bool ok = true;
+    std::setvbuf(stdout, nullptr, _IOLBF, 0);
+
+    std::printf("stress (2 threads, mixed bulk/span):\n");
+    for (uint32_t size : {16u, 64u, 1024u}) ok &= StressSpsc(size, total / 4);
+
+    std::printf("single thread, put+get (MB/s):\n");
+    std::printf("  chunk   rt_ringbuffer   spsc\n");
+    for (uint32_t chunk : {1u, 16u, 64u, 256u}) {
+        static uint8_t rt_pool[1024], spsc_pool[1024];
+        struct rt_ringbuffer rb;
+        Spsc_T ring;
+        rt_ringbuffer_init(&rb, rt_pool, sizeof(rt_pool));
+        spsc_init(&ring, spsc_pool, sizeof(spsc_pool));
+        double rt = SingleThreadMBs(
+            chunk, [&](const uint8_t *p, uint32_t n) { rt_ringbuffer_put(&rb, p, n); },
+            [&](uint8_t *p, uint32_t n) { rt_ringbuffer_get(&rb, p, n); });
+        double sp = SingleThreadMBs(
+            chunk, [&](const uint8_t *p, uint32_t n) { spsc_write(&ring, p, n); },
+            [&](uint8_t *p, uint32_t n) { spsc_read(&ring, p, n); });
+        std::printf("  %5u   %13.0f   %6.0f\n", chunk, rt, sp);
+    }
+
+    std::printf("in-place write check:\n");
+    {
+        static uint8_t rt_pool[1024], spsc_pool[1024];
+        struct rt_ringbuffer rb;
+        Spsc_T ring;
+        rt_ringbuffer_init(&rb, rt_pool, sizeof(rt_pool));
+        spsc_init(&ring, spsc_pool, sizeof(spsc_pool));
+        ok &= CheckInPlace(
+            "rt_ringbuffer_reserve/commit",
+            [&](uint8_t **p, uint8_t **w, uint32_t *wl) {
+                rt_size_t len;
+                rt_size_t n = rt_ringbuffer_reserve(&rb, p, w, &len);
+                *wl = static_cast<uint32_t>(len);
+                return static_cast<uint32_t>(n);
+            },
+            [&](uint32_t n) { rt_ringbuffer_commit(&rb, static_cast<rt_uint16_t>(n)); },
+            [&](uint8_t *p, uint32_t n) { return static_cast<uint32_t>(rt_ringbuffer_get(&rb, p, static_cast<rt_uint16_t>(n))); });
+        ok &= CheckInPlace(
+            "spsc_write_span/commit",
+            [&](uint8_t **p, uint8_t **w, uint32_t *wl) { return spsc_write_span(&ring, p, w, wl); },
+            [&](uint32_t n) { spsc_write_commit(&ring, n); },
+            [&](uint8_t *p, uint32_t n) { return spsc_read(&ring, p, n); });
+    }
+
+    std::printf("zero-copy read check (in-place write, read from the contiguous span):\n");
+    {
+        static uint8_t rt_pool[1024], spsc_pool[1024];
+        struct rt_ringbuffer rb;
+        Spsc_T ring;
+        rt_ringbuffer_init(&rb, rt_pool, sizeof(rt_pool));
+        spsc_init(&ring, spsc_pool, sizeof(spsc_pool));
+        ok &= CheckInPlace(
+            "rt_ringbuffer_peek_linear/discard",
+            [&](uint8_t **p, uint8_t **w, uint32_t *wl) {
+                rt_size_t len;
+                rt_size_t n = rt_ringbuffer_reserve(&rb, p, w, &len);
+                *wl = static_cast<uint32_t>(len);
+                return static_cast<uint32_t>(n);
+            },
+            [&](uint32_t n) { rt_ringbuffer_commit(&rb, static_cast<rt_uint16_t>(n)); },
+            [&](uint8_t *p, uint32_t n) {
+                rt_uint8_t *span;
+                uint32_t len = static_cast<uint32_t>(rt_ringbuffer_peek_linear(&rb, &span));
+                if (len > n) len = n;
+                std::memcpy(p, span, len);
+                rt_ringbuffer_discard(&rb, static_cast<rt_uint16_t>(len));
+                return len;
+            });
+        ok &= CheckInPlace(
+            "spsc_read_span/release",
+            [&](uint8_t **p, uint8_t **w, uint32_t *wl) { return spsc_write_span(&ring, p, w, wl); },
+            [&](uint32_t n) { spsc_write_commit(&ring, n); },
+            [&](uint8_t *p, uint32_t n) {
+                uint8_t *span;
+                uint32_t len = spsc_read_span(&ring, &span);
+                if (len > n) len = n;
+                std::memcpy(p, span, len);
+                spsc_read_release(&ring, len);
+                return len;
+            });
+    }
+
+    std::printf("single thread, in-place write + get (MB/s):\n");
+    std::printf("  chunk   rt_ringbuffer   spsc\n");
+    for (uint32_t chunk : {16u, 64u, 256u}) {
+        static uint8_t rt_pool[1024], spsc_pool[1024];
+        struct rt_ringbuffer rb;
+        Spsc_T ring;
+        rt_ringbuffer_init(&rb, rt_pool, sizeof(rt_pool));
+        spsc_init(&ring, spsc_pool, sizeof(spsc_pool));
+        double rt = SingleThreadMBs(
+            chunk,
+            [&](const uint8_t *, uint32_t n) {
+                WriteInPlace([&](uint8_t **p, uint8_t **w, uint32_t *wl) {
+                    rt_size_t len;
+                    rt_size_t span = rt_ringbuffer_reserve(&rb, p, w, &len);
+                    *wl = static_cast<uint32_t>(len);
+                    return static_cast<uint32_t>(span);
+                }, [&](uint32_t c) { rt_ringbuffer_commit(&rb, static_cast<rt_uint16_t>(c)); }, 0, n);
+            },
+            [&](uint8_t *p, uint32_t n) { rt_ringbuffer_get(&rb, p, n); });
+        double sp = SingleThreadMBs(
+            chunk,
+            [&](const uint8_t *, uint32_t n) {
+                WriteInPlace([&](uint8_t **p, uint8_t **w, uint32_t *wl) { return spsc_write_span(&ring, p, w, wl); },
+                             [&](uint32_t c) { spsc_write_commit(&ring, c); }, 0, n);
+            },
+            [&](uint8_t *p, uint32_t n) { spsc_read(&ring, p, n); });
+        std::printf("  %5u   %13.0f   %6.0f\n", chunk, rt, sp);
+    }
+
+    std::printf("spsc 2 threads, ring 1024 B (MB/s):\n");
+    for (uint32_t chunk : {16u, 64u, 256u}) std::printf("  chunk %3u: %.0f\n", chunk, TwoThreadSpscMBs(1024, chunk));
+
+    std::printf("race check:\n");
+    RaceRtRingbuffer(2.0);
+
+    std::printf(ok ? "PASS\n" : "FAIL\n");
+    return ok ? 0 : 1;
+}
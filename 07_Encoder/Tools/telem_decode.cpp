@@ -0,0 +1,168 @@
+// 二进制遥测解码 (主机端工具)
+//
+// 从串口数据中按 0x00 分帧, COBS解码并校验CRC (User/Module/Frame), 把遥测采样写成CSV;
+// 校验不通过的一段按文本处理 (命令回显等), 原样输出到 stderr; 其他类型的帧 (如日志) 忽略
+// 帧格式见 User/App/telem_app.h
+//
+// 编译 (在 07_Encoder 目录下):
+//   gcc -O2 -c User/Module/Frame/frame.c
+//   g++ -std=c++17 -O2 -IUser/Module/Frame -o telem_decode Tools/telem_decode.cpp frame.o
+// 用法:
+//   stty -F /dev/ttyUSB0 921600 raw -echo
+//   echo "telem" > /dev/ttyUSB0            # "telem N" 每N个控制周期一个采样, "telem off" 停止
+//   ./telem_decode /dev/ttyUSB0 > run.csv   # 不带参数时从 stdin 读取, Ctrl+C 结束
+
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "frame.h"
+
+namespace {
+
+constexpr uint8_t kFrameSamples = 0x54;  // TELEM_FRAME_SAMPLES
+constexpr size_t kFrameHeader = 4;       // type, decimation, period_us
+constexpr size_t kSampleHeader = 8;      // seq, flags, axis_count, sync_error
+constexpr size_t kAxisSize = 28;         // TelemAxis_t
+
+volatile std::sig_atomic_t g_stop = 0;
+
+uint16_t U16(const uint8_t *p) { return static_cast<uint16_t>(p[0] | p[1] << 8); }
+uint32_t U32(const uint8_t *p) { return U16(p) | static_cast<uint32_t>(U16(p + 2)) << 16; }
+float F32(const uint8_t *p) {
+    uint32_t bits = U32(p);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+struct Stats {
+    uint64_t frames = 0;
+    uint64_t samples = 0;
+    uint64_t missing = 0;   // 按 seq 间断推算的丢失采样数
+    uint64_t bad = 0;       // 以二进制开头但校验不通过的段
+};
+
+class Decoder {
+public:
+    explicit Decoder(FILE *csv) : csv_(csv) {}
+
+    // 两个分隔符之间的一段
+    void Chunk(const std::vector<uint8_t> &chunk) {
+        if (chunk.empty()) return;
+        payload_.resize(chunk.size());
+        int32_t len = frame_decode(chunk.data(), static_cast<uint32_t>(chunk.size()), payload_.data());
+        if (len >= 0) {
+            // 其他类型的帧 (如日志) 忽略
+            if (len >= static_cast<int32_t>(kFrameHeader) && payload_[0] == kFrameSamples) {
+                Frame(payload_.data(), static_cast<size_t>(len));
+            }
+        } else if (IsText(chunk)) {
+            std::fwrite(chunk.data(), 1, chunk.size(), stderr);
+        } else {
+            stats_.bad++;
+        }
+    }
+
+    const Stats &stats() const { return stats_; }
+
+private:
+    static bool IsText(const std::vector<uint8_t> &chunk) {
+        for (uint8_t c : chunk) {
+            if (c < 0x20 && c != '\r' && c != '\n' && c != '\t') return false;
+            if (c >= 0x7f) return false;
+        }
+        return true;
+    }
+
+    void Header(unsigned axis_count) {
+        std::fprintf(csv_, "t_s,seq,running,sync_error");
+        for (unsigned a = 0; a < axis_count; a++) {
+            std::fprintf(csv_, ",a%u_position,a%u_count,a%u_pwm,a%u_rpm,a%u_target,a%u_p,a%u_i,a%u_d", a, a, a, a,
+                         a, a, a, a);
+        }
+        std::fprintf(csv_, "\n");
+        axis_count_ = axis_count;
+    }
+
+    void Frame(const uint8_t *p, size_t len) {
+        unsigned decimation = p[1] ? p[1] : 1;
+        double period_s = U16(p + 2) * 1e-6;
+        size_t pos = kFrameHeader;
+
+        stats_.frames++;
+        while (pos + kSampleHeader <= len) {
+            const uint8_t *s = p + pos;
+            unsigned axis_count = s[5];
+            size_t size = kSampleHeader + axis_count * kAxisSize;
+            if (axis_count == 0 || pos + size > len) {
+                stats_.bad++;
+                return;
+            }
+            if (axis_count_ == 0) Header(axis_count);
+            if (axis_count != axis_count_) {
+                stats_.bad++;
+                return;
+            }
+            Sample(s, decimation, period_s);
+            pos += size;
+        }
+    }
+
+    void Sample(const uint8_t *s, unsigned decimation, double period_s) {
+        uint32_t seq = U32(s);
+        if (have_seq_ && seq - last_seq_ > decimation) stats_.missing += (seq - last_seq_) / decimation - 1;
+        last_seq_ = seq;
+        have_seq_ = true;
+        stats_.samples++;
+
+        std::fprintf(csv_, "%.6f,%u,%u,%d", seq * period_s, seq, s[4] & 1u, static_cast<int16_t>(U16(s + 6)));
+        for (unsigned a = 0; a < axis_count_; a++) {
+            const uint8_t *x = s + kSampleHeader + a * kAxisSize;
+            std::fprintf(csv_, ",%d,%d,%d,%.3f,%.3f,%.3f,%.3f,%.3f", static_cast<int32_t>(U32(x)),
+                         static_cast<int16_t>(U16(x + 4)), static_cast<int16_t>(U16(x + 6)), F32(x + 8), F32(x + 12),
+                         F32(x + 16), F32(x + 20), F32(x + 24));
+        }
+        std::fprintf(csv_, "\n");
+    }
+
+    FILE *csv_;
+    std::vector<uint8_t> payload_;
+    unsigned axis_count_ = 0;
+    uint32_t last_seq_ = 0;
+    bool have_seq_ = false;
+    Stats stats_;
+};
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    FILE *in = argc > 1 ? std::fopen(argv[1], "rb") : stdin;
+    if (!in) {
+        std::perror(argv[1]);
+        return 1;
+    }
+    std::signal(SIGINT, [](int) { g_stop = 1; });
+
+    Decoder decoder(stdout);
+    std::vector<uint8_t> chunk;
+    int c;
+    while (!g_stop && (c = std::fgetc(in)) != EOF) {
+        if (c == FRAME_DELIMITER) {
+            decoder.Chunk(chunk);
+            chunk.clear();
+        } else if (chunk.size() < 4096) {
+            chunk.push_back(static_cast<uint8_t>(c));
+        }
+    }
+    decoder.Chunk(chunk);
+    std::fflush(stdout);
+
+    const Stats &s = decoder.stats();
+    std::fprintf(stderr, "\nframes %llu, samples %llu, missing %llu, bad %llu\n",
+                 static_cast<unsigned long long>(s.frames), static_cast<unsigned long long>(s.samples),
+                 static_cast<unsigned long long>(s.missing), static_cast<unsigned long long>(s.bad));
+    return 0;
+}
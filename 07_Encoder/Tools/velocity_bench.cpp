@@ -0,0 +1,260 @@
+// 速度估计器对比 (主机端工具)
+//
+// 模拟编码器 (4倍频计数 + A相边沿DWT时间戳), 按 Encoder_Driver_Update 的方式在1kHz控制周期取测量,
+// 喂给 User/Module/Filter 的各个估计器, 统计每个场景的滞后 (真值 - 估计值的平均) 和噪声 (误差的标准差):
+//   IIR      一阶低通, 输入 M/T 法转速 (原默认)
+//   PLL      二阶位置锁相环, 输入周期末计数值
+//   ABG      alpha-beta-gamma, 输入周期末计数值
+//   ABG+edge alpha-beta-gamma, 有近期边沿时输入边沿时刻的位置 (固件当前方式)
+// 计数边界带固定的刻线误差 (±kLineError 脉冲), A相占空比误差也包含在内
+// 最后检查 ABG+edge 在低速的噪声低于 ABG, 且斜坡滞后不超过限值, 不满足时返回1
+//
+// 编译 (在 07_Encoder 目录下):
+//   gcc -O2 -c User/Module/Filter/velocity_filter.c
+//   g++ -std=c++17 -O2 -IUser/Module/Filter -o velocity_bench Tools/velocity_bench.cpp velocity_filter.o
+// 用法: velocity_bench
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "velocity_filter.h"
+
+namespace {
+
+constexpr double kPpr = 1551.0;          // ENCODER_PPR
+constexpr double kDt = 0.001;            // 控制周期 (CONTROL_RATE_HZ = 1000)
+constexpr double kCpuHz = 168e6;         // DWT时钟
+constexpr double kStep = 1e-6;           // 仿真步长
+constexpr double kLineError = 0.05;      // 刻线误差 (脉冲)
+constexpr double kMtTimeout = 0.2;       // ENCODER_MT_TIMEOUT_S
+constexpr double kEdgeHold = 0.01;       // ENCODER_EDGE_HOLD_S
+constexpr float kIirAlpha = 0.3f;        // ENCODER_IIR_ALPHA
+constexpr float kAbgAlpha = 0.8f, kAbgBeta = 0.5f, kAbgGamma = 0.02f, kAbgRefDt = 0.01f;  // ENCODER_ABG_*
+constexpr float kPllWn = 60.0f, kPllZeta = 0.9f;
+
+double RpmToCps(double rpm) { return rpm * kPpr / 60.0; }
+
+// 一段运动: 速度从 rpm0 匀加速到 rpm1
+struct Segment {
+    double duration;
+    double rpm0, rpm1;
+    bool measure;       // 计入统计 (跳过起始的收敛段)
+};
+
+struct Scenario {
+    const char *name;
+    std::vector<Segment> segments;
+};
+
+// 编码器: 真实位置 → 计数值和A相边沿 (计数值 n 对应 [n-0.5, n+0.5))
+class EncoderModel {
+public:
+    EncoderModel() {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<double> err(-kLineError, kLineError);
+        line_error_.resize(static_cast<size_t>(kPpr));
+        for (double &e : line_error_) e = err(rng);
+    }
+
+    // 推进到位置 theta (单步内最多越过一个边界)
+    void Move(double theta, uint32_t cycles) {
+        for (;;) {
+            if (theta >= Boundary(count_)) {
+                count_++;
+                Edge(cycles);
+            } else if (theta < Boundary(count_ - 1)) {
+                count_--;
+                Edge(cycles);
+            } else {
+                break;
+            }
+        }
+    }
+
+    int64_t count() const { return count_; }
+
+    // 边沿捕获 (Encoder_Driver_EdgeIRQ)
+    bool edge_flag = false;
+    int64_t edge_count = 0;
+    uint32_t edge_cycles = 0;
+
+private:
+    // 计数值 n 与 n+1 之间的边界
+    double Boundary(int64_t n) const {
+        int64_t k = ((n % static_cast<int64_t>(kPpr)) + static_cast<int64_t>(kPpr)) % static_cast<int64_t>(kPpr);
+        return static_cast<double>(n) + 0.5 + line_error_[static_cast<size_t>(k)];
+    }
+
+    // 计数值每变化2为一个A相边沿 (偶数边界为A相, 奇数为B相)
+    void Edge(uint32_t cycles) {
+        if ((count_ & 1) == 0) {
+            edge_flag = true;
+            edge_count = count_;
+            edge_cycles = cycles;
+        }
+    }
+
+    int64_t count_ = 0;
+    std::vector<double> line_error_;
+};
+
+// 与 Encoder_Driver_Update / Encoder_MT_Calculate 相同的测量
+struct Measurement {
+    int64_t position;
+    float offset;
+    float age;
+    float rpm;
+};
+
+class Frontend {
+public:
+    Measurement Sample(EncoderModel &enc, uint32_t now) {
+        int64_t position = enc.count();
+        double rpm = static_cast<double>(position - last_position_) / kPpr * 60.0 / kDt;
+        last_position_ = position;
+        Measurement m{position, 0.0f, 0.0f, 0.0f};
+
+        if (enc.edge_flag) {
+            enc.edge_flag = false;
+            int dir = 0;
+            if (last_edge_valid_ && enc.edge_count != last_edge_position_) {
+                double dt = static_cast<uint32_t>(enc.edge_cycles - last_edge_cycles_) / kCpuHz;
+                double pulses = static_cast<double>(enc.edge_count - last_edge_position_);
+                rpm = pulses / kPpr * 60.0 / dt;
+                dir = pulses > 0 ? 1 : -1;
+            }
+            last_edge_position_ = enc.edge_count;
+            last_edge_cycles_ = enc.edge_cycles;
+            last_edge_valid_ = true;
+            last_edge_dir_ = dir;
+        } else if (last_edge_valid_) {
+            double elapsed = static_cast<uint32_t>(now - last_edge_cycles_) / kCpuHz;
+            if (elapsed >= kMtTimeout) {
+                last_edge_valid_ = false;
+                rpm = 0.0;
+            } else {
+                double bound = 2.0 / kPpr * 60.0 / elapsed;
+                rpm = std::fmax(-bound, std::fmin(bound, last_rpm_));
+            }
+        }
+        last_rpm_ = rpm;
+        m.rpm = static_cast<float>(rpm);
+
+        if (last_edge_valid_ && last_edge_dir_ != 0) {
+            double age = static_cast<uint32_t>(now - last_edge_cycles_) / kCpuHz;
+            if (age < kEdgeHold) {
+                m.position = last_edge_position_;
+                m.offset = last_edge_dir_ > 0 ? -0.5f : 0.5f;
+                m.age = static_cast<float>(age);
+            }
+        }
+        return m;
+    }
+
+private:
+    int64_t last_position_ = 0;
+    int64_t last_edge_position_ = 0;
+    uint32_t last_edge_cycles_ = 0;
+    bool last_edge_valid_ = false;
+    int last_edge_dir_ = 0;
+    double last_rpm_ = 0.0;
+};
+
+enum Kind { kIir, kPll, kAbg, kAbgEdge, kKinds };
+const char *const kKindName[kKinds] = {"IIR", "PLL", "ABG", "ABG+edge"};
+
+struct Stats {
+    double sum = 0, sum2 = 0;
+    uint64_t n = 0;
+    void Add(double e) {
+        sum += e;
+        sum2 += e * e;
+        n++;
+    }
+    double Mean() const { return n ? sum / n : 0.0; }
+    double Std() const { return n ? std::sqrt(std::fmax(0.0, sum2 / n - Mean() * Mean())) : 0.0; }
+};
+
+// 运行一个场景, 返回各估计器误差 (估计 - 真值, rpm)
+std::vector<Stats> Run(const Scenario &sc) {
+    VelFilter_T filters[kKinds];
+    float alpha = kAbgAlpha, beta = kAbgBeta, gamma = kAbgGamma;
+    vel_filter_abg_rescale(&alpha, &beta, &gamma, kAbgRefDt, static_cast<float>(kDt));
+    vel_filter_init_iir(&filters[kIir], kIirAlpha);
+    vel_filter_init_pll(&filters[kPll], kPllWn, kPllZeta);
+    vel_filter_init_abg(&filters[kAbg], alpha, beta, gamma);
+    vel_filter_init_abg(&filters[kAbgEdge], alpha, beta, gamma);
+
+    EncoderModel enc;
+    Frontend frontend;
+    std::vector<Stats> stats(kKinds);
+    const float cps = static_cast<float>(kPpr / 60.0);
+    const int steps_per_tick = static_cast<int>(std::lround(kDt / kStep));
+    double t = 0.0, theta = 0.0;
+
+    for (const Segment &seg : sc.segments) {
+        const double accel = RpmToCps(seg.rpm1 - seg.rpm0) / seg.duration;
+        const int64_t ticks = std::lround(seg.duration / kDt);
+        double seg_t = 0.0;
+        for (int64_t tick = 0; tick < ticks; tick++) {
+            for (int i = 0; i < steps_per_tick; i++) {
+                seg_t += kStep;
+                t += kStep;
+                theta += (RpmToCps(seg.rpm0) + accel * (seg_t - 0.5 * kStep)) * kStep;
+                enc.Move(theta, static_cast<uint32_t>(std::llround(t * kCpuHz)));
+            }
+            uint32_t now = static_cast<uint32_t>(std::llround(t * kCpuHz));
+            double true_rpm = seg.rpm0 + (seg.rpm1 - seg.rpm0) * seg_t / seg.duration;
+            Measurement m = frontend.Sample(enc, now);
+
+            float v[kKinds];
+            v[kIir] = vel_filter_update(&filters[kIir], m.position, m.rpm * cps, static_cast<float>(kDt));
+            v[kPll] = vel_filter_update(&filters[kPll], enc.count(), m.rpm * cps, static_cast<float>(kDt));
+            v[kAbg] = vel_filter_update(&filters[kAbg], enc.count(), m.rpm * cps, static_cast<float>(kDt));
+            v[kAbgEdge] = vel_filter_update_at(&filters[kAbgEdge], m.position, m.offset, m.age, m.rpm * cps,
+                                               static_cast<float>(kDt));
+            if (!seg.measure) continue;
+            for (int k = 0; k < kKinds; k++) stats[k].Add(v[k] / cps - true_rpm);
+        }
+    }
+    return stats;
+}
+
+}  // namespace
+
+int main() {
+    const Scenario scenarios[] = {
+        {"hold 16 rpm", {{1.0, 16, 16, false}, {10.0, 16, 16, true}}},
+        {"hold 120 rpm", {{1.0, 120, 120, false}, {10.0, 120, 120, true}}},
+        {"ramp 16->216 rpm @ 20 rpm/s", {{1.0, 16, 16, false}, {0.5, 16, 26, false}, {9.5, 26, 216, true}}},
+        {"ramp 0->300 rpm @ 600 rpm/s", {{0.5, 0, 0, false}, {0.1, 0, 60, false}, {0.4, 60, 300, true}}},
+        {"decel 120->0 rpm in 0.5 s", {{1.0, 120, 120, false}, {0.5, 120, 0, true}}},
+        {"stopped after decel", {{1.0, 120, 120, false}, {0.5, 120, 0, false}, {2.0, 0, 0, true}}},
+        {"reverse +30->-30 rpm in 2 s", {{1.0, 30, 30, false}, {2.0, 30, -30, true}}},
+    };
+
+    std::printf("%-30s %-9s %10s %10s\n", "scenario", "estimator", "lag(rpm)", "noise(rpm)");
+    std::vector<std::vector<Stats>> results;
+    for (const Scenario &sc : scenarios) {
+        results.push_back(Run(sc));
+        for (int k = 0; k < kKinds; k++) {
+            const Stats &s = results.back()[k];
+            std::printf("%-30s %-9s %10.3f %10.3f\n", k == 0 ? sc.name : "", kKindName[k], -s.Mean(), s.Std());
+        }
+    }
+
+    // 边沿时刻的位置应降低低速噪声, 且不引入滞后
+    bool ok = true;
+    auto check = [&](bool cond, const char *what) {
+        std::printf("%s: %s\n", cond ? "PASS" : "FAIL", what);
+        ok &= cond;
+    };
+    check(results[0][kAbgEdge].Std() < 0.5 * results[0][kAbg].Std(), "ABG+edge noise at 16 rpm below half of ABG");
+    check(results[1][kAbgEdge].Std() < results[1][kAbg].Std(), "ABG+edge noise at 120 rpm below ABG");
+    check(std::fabs(results[2][kAbgEdge].Mean()) < 0.2, "ABG+edge lag on 20 rpm/s ramp under 0.2 rpm");
+    check(std::fabs(results[2][kAbgEdge].Mean()) < std::fabs(results[2][kIir].Mean()), "ABG+edge lag below IIR");
+    return ok ? 0 : 1;
+}
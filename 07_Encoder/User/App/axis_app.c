@@ -0,0 +1,45 @@
+#include "axis_app.h"
+
+// ============================= 轴布局表 =============================
+
+/**
+ * @brief 各轴硬件映射
+ * @note TIM1 的4路PWM: CH4/CH3(PE14/PE13) 给右电机, CH2/CH1(PE11/PE9) 给左电机;
+ *       TIM2 是1ms调度时基, 不能再作为电机PWM
+ *       DMA采样时每个轴占用一个独立的TIM2 DMA请求, 请求之间互不抢占
+ */
+const AxisConfig axis_config[AXIS_COUNT] = {
+    [AXIS_RIGHT] = {
+        .name = "R",
+        .pwm_htim = &htim1,
+        .pwm_in1_channel = TIM_CHANNEL_4,
+        .pwm_in2_channel = TIM_CHANNEL_3,
+        .motor_reverse = 0,
+        .enc_htim = &htim4,
+        .enc_reverse = 1,
+        .edge_port = GPIOD,
+        .edge_pin = GPIO_PIN_12,            // TIM4_CH1
+        .dma_stream = DMA1_Stream1,         // TIM2_UP
+        .dma_channel = DMA_CHANNEL_3,
+        .dma_request = TIM_DMA_UPDATE,
+    },
+#if AXIS_LAYOUT == AXIS_LAYOUT_DIFF
+    [AXIS_LEFT] = {
+        .name = "L",
+        .pwm_htim = &htim1,
+        .pwm_in1_channel = TIM_CHANNEL_2,
+        .pwm_in2_channel = TIM_CHANNEL_1,
+        .motor_reverse = 0,
+        .enc_htim = &htim3,
+        .enc_reverse = 1,
+        .edge_port = GPIOB,
+        .edge_pin = GPIO_PIN_4,             // TIM3_CH1
+        .dma_stream = DMA1_Stream5,         // TIM2_CH1
+        .dma_channel = DMA_CHANNEL_3,
+        .dma_request = TIM_DMA_CC1,
+    },
+#endif
+};
+
+// ============================= 轴运行状态 =============================
+Axis axes[AXIS_COUNT];
@@ -0,0 +1,72 @@
+#ifndef __AXIS_APP_H__
+#define __AXIS_APP_H__
+
+#include "MyDefine.h"
+
+// ============================= 板级轴布局 =============================
+
+/**
+ * @brief 轴布局选择
+ * @note AXIS_LAYOUT_SINGLE = 仅右电机 (当前)
+ *       AXIS_LAYOUT_DIFF   = 差速底盘, 右电机 + 左电机
+ *       新增一个轴: 在 axis_app.c 的布局表中追加一项, 并修改对应的 AXIS_COUNT
+ */
+#define AXIS_LAYOUT_SINGLE  1
+#define AXIS_LAYOUT_DIFF    2
+
+#define AXIS_LAYOUT  AXIS_LAYOUT_SINGLE
+
+#if AXIS_LAYOUT == AXIS_LAYOUT_DIFF
+#define AXIS_COUNT 2
+#else
+#define AXIS_COUNT 1
+#endif
+
+// 轴编号 (布局表中的下标)
+#define AXIS_RIGHT 0    // 右轮, 所有布局都存在
+#define AXIS_LEFT  1    // 左轮, 仅差速布局
+
+// ============================= 轴描述 =============================
+
+/**
+ * @brief 单个轴的硬件描述 (只读, 编译期确定)
+ */
+typedef struct {
+    const char *name;                   // 显示名
+
+    // 电机 (DRV8871 两路PWM)
+    TIM_HandleTypeDef *pwm_htim;        // PWM定时器
+    uint32_t pwm_in1_channel;           // IN1 通道
+    uint32_t pwm_in2_channel;           // IN2 通道
+    uint8_t motor_reverse;              // 电机方向反转
+
+    // 编码器 (定时器编码器模式)
+    TIM_HandleTypeDef *enc_htim;        // 编码器定时器
+    uint8_t enc_reverse;                // 计数方向反转
+    GPIO_TypeDef *edge_port;            // A相引脚, M/T法边沿捕获
+    uint16_t edge_pin;
+
+    // DMA批量采样 (ENCODER_DMA_SAMPLING=1 时使用, 由TIM2触发)
+    DMA_Stream_TypeDef *dma_stream;     // DMA数据流
+    uint32_t dma_channel;               // DMA通道
+    uint32_t dma_request;               // TIM2 DMA请求源 (TIM_DMA_UPDATE / TIM_DMA_CCx)
+} AxisConfig;
+
+/**
+ * @brief 单个轴的运行状态
+ * @note 所有轴的状态连续存放在 axes[] 中, 控制循环按下标顺序遍历
+ */
+typedef struct {
+    Encoder encoder;                    // 编码器及速度估计器
+    MOTOR motor;                        // 电机驱动
+    int64_t sync_base;                  // 同步起点位置 (PID_Start 后内环第一个周期记录)
+    float sync_error;                   // 同步误差: 相对各轴平均位置的超前量(脉冲)
+    EncoderDMA dma;                     // DMA采样缓冲 (仅 ENCODER_DMA_SAMPLING=1 时使用)
+} Axis;
+
+// ============================= 外部接口 =============================
+
+extern const AxisConfig axis_config[AXIS_COUNT];
+extern Axis axes[AXIS_COUNT];
+
+#endif
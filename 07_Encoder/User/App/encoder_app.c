@@ -1,31 +1,146 @@
 #include "encoder_app.h"
+#include "axis_app.h"
+#include "handoff.h"
 
-// 编码器实例
-Encoder left_encoder;
-Encoder right_encoder;
+#if ENCODER_DMA_SAMPLING && (CONTROL_TIMEBASE_DIV < 4 || CONTROL_TIMEBASE_DIV > ENCODER_DMA_BUFFER_SIZE / 4)
+#error "DMA采样每个控制周期需要4个以上样本, 且不超过缓冲区的1/4"
+#endif
+
+// 每圈脉冲数 (可由参数存储覆盖, 在 Encoder_Init 前加载)
+uint16_t encoder_ppr = ENCODER_PPR;
+
+// 各轴反馈交接: 内环(TIM2中断)写, 外环(前台)读
+static EncoderFeedback_t feedback_slot[AXIS_COUNT][2];
+static Handoff_T feedback_handoff[AXIS_COUNT];
+
+#if ENCODER_DMA_SAMPLING
+/**
+ * @brief TIM2 DMA请求对应的比较通道
+ * @param request TIM_DMA_CCx
+ * @return TIM_CHANNEL_x
+ */
+static uint32_t Encoder_DMA_RequestChannel(uint32_t request)
+{
+    switch (request) {
+        case TIM_DMA_CC2: return TIM_CHANNEL_2;
+        case TIM_DMA_CC3: return TIM_CHANNEL_3;
+        case TIM_DMA_CC4: return TIM_CHANNEL_4;
+        default:          return TIM_CHANNEL_1;
+    }
+}
+
+/**
+ * @brief 配置TIM2的DMA请求, 每个TIM2周期触发一次CNT搬运
+ * @note 每个轴使用布局表中的独立请求 (UP 或 CCx 比较匹配),
+ *       比较匹配与UP错开半个周期, 各路请求不会互相抢占对方的DMA应答
+ */
+static void Encoder_DMA_Trigger_Init(void)
+{
+    __HAL_RCC_DMA1_CLK_ENABLE();
+
+    for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+        uint32_t request = axis_config[i].dma_request;
+
+        if (request != TIM_DMA_UPDATE) {
+            TIM_OC_InitTypeDef sConfigOC = {0};
+            sConfigOC.OCMode = TIM_OCMODE_TIMING;
+            sConfigOC.Pulse = (htim2.Init.Period + 1) / 2;
+            HAL_TIM_OC_ConfigChannel(&htim2, &sConfigOC, Encoder_DMA_RequestChannel(request));
+        }
+        __HAL_TIM_ENABLE_DMA(&htim2, request);
+    }
+}
+#endif
 
 /**
  * @brief 初始化编码器应用
+ * @note 按布局表初始化每个轴的编码器
  */
 void Encoder_Init(void)
 {
-#if MOTOR_COUNT == 2
-    // 初始化左编码器 (TIM3)
-    Encoder_Driver_Init(&left_encoder, &htim3, 1);
+    for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+        const AxisConfig *cfg = &axis_config[i];
+        Encoder *encoder = &axes[i].encoder;
+
+        Encoder_Driver_Init(encoder, cfg->enc_htim, cfg->enc_reverse);
+        encoder->ppr = encoder_ppr;
+
+        // 速度估计器: 速度环使用低滞后的 alpha-beta-gamma 跟踪器, 增益按控制周期换算
+        float alpha = ENCODER_ABG_ALPHA;
+        float beta = ENCODER_ABG_BETA;
+        float gamma = ENCODER_ABG_GAMMA;
+        vel_filter_abg_rescale(&alpha, &beta, &gamma, ENCODER_ABG_REF_DT, SAMPLING_TIME_S);
+        vel_filter_init_abg(&encoder->filter, alpha, beta, gamma);
+
+#if ENCODER_DMA_SAMPLING
+        // DMA批量采样 (TIM2由 System_Init 最后启动, 启动前不会产生请求)
+        Encoder_Driver_DMA_Init(&axes[i].dma, encoder, cfg->dma_stream, cfg->dma_channel,
+                                ENCODER_DMA_SAMPLE_TIME_S);
+#else
+        // A相边沿捕获
+        Encoder_Driver_EdgeCapture_Init(encoder, cfg->edge_port, cfg->edge_pin);
+#endif
+
+        feedback_slot[i][0].position = encoder->position;
+        handoff_init(&feedback_handoff[i], &feedback_slot[i][0], &feedback_slot[i][1], sizeof(EncoderFeedback_t));
+    }
+
+#if ENCODER_DMA_SAMPLING
+    Encoder_DMA_Trigger_Init();
 #endif
-    // 初始化右编码器 (TIM4)
-    Encoder_Driver_Init(&right_encoder, &htim4, 1);
 }
 
 /**
- * @brief 编码器应用运行任务
+ * @brief 编码器应用运行任务 (控制内环, TIM2中断)
+ * @note 更新后发布反馈, 前台外环通过 Encoder_GetFeedback 读取完整的一组数据
  */
 void Encoder_Task(void)
 {
-#if MOTOR_COUNT == 2
-    // 更新左编码器
-    Encoder_Driver_Update(&left_encoder);
+    for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+        Encoder *encoder = &axes[i].encoder;
+
+#if ENCODER_DMA_SAMPLING
+        Encoder_Driver_UpdateBatch(encoder, &axes[i].dma);
+#else
+        Encoder_Driver_Update(encoder);
 #endif
-    // 更新右编码器
-    Encoder_Driver_Update(&right_encoder);
+
+        EncoderFeedback_t feedback = {
+            .position = encoder->position,
+            .rpm = encoder->rpm_filtered,
+            .accel_rpm_s = encoder->accel_rpm_s,
+            .rpm_raw = encoder->rpm,
+            .speed_cm_s = encoder->speed_cm_s,
+        };
+        handoff_write(&feedback_handoff[i], &feedback);
+    }
+}
+
+/**
+ * @brief 读取单轴最新反馈 (前台调用)
+ * @param axis 轴编号
+ * @param feedback 输出
+ * @note axes[].encoder 属于中断上下文, 前台 (外环、UI、串口遥测) 只能经由此接口读取,
+ *       直接读取可能读到一半新一半旧的64位位置, 或不同周期的位置与转速
+ */
+void Encoder_GetFeedback(uint8_t axis, EncoderFeedback_t *feedback)
+{
+    handoff_read(&feedback_handoff[axis], feedback);
+}
+
+/**
+ * @brief EXTI回调 - 编码器A相边沿时间戳
+ */
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+    PERF_MARK(mark);
+    PERF_BEGIN(mark);
+
+    for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+        if (GPIO_Pin == axis_config[i].edge_pin) {
+            Encoder_Driver_EdgeIRQ(&axes[i].encoder);
+        }
+    }
+
+    PERF_END_ISR(mark, PERF_ISR_ENCODER_EDGE);
 }
@@ -3,7 +3,38 @@
 
 #include "MyDefine.h"
 
+// 编码器采样方式 ENCODER_DMA_SAMPLING 在 control_rate.h 中设置 (DMA采样决定TIM2时基)
+
+// DMA采样间隔, 与TIM2更新周期一致
+#define ENCODER_DMA_SAMPLE_TIME_S (1.0f / CONTROL_TIMEBASE_HZ)
+
+/**
+ * @brief 速度估计器参数 (alpha-beta-gamma 稳态卡尔曼)
+ * @note 在10ms更新下整定: 匀加速时无稳态滞后, 带宽足够高, 速度环 (kp=3, ki=50) 在电机时间常数
+ *       10~500ms 范围内不产生极限环, 增益加倍仍稳定; gamma 过小 (如0.004) 时加速度状态收敛慢,
+ *       估计值过冲, 与速度环耦合后在死区附近振荡
+ *       其他控制周期由 vel_filter_abg_rescale 换算, 连续时间带宽和阻尼不变
+ */
+#define ENCODER_ABG_ALPHA 0.8f
+#define ENCODER_ABG_BETA  0.5f
+#define ENCODER_ABG_GAMMA 0.02f
+#define ENCODER_ABG_REF_DT 0.01f
+
+/**
+ * @brief 编码器反馈 (内环每个控制周期发布一次, 供前台外环读取)
+ */
+typedef struct {
+    int64_t position;       // 累计位置(脉冲)
+    float rpm;              // 速度估计器输出(rpm)
+    float accel_rpm_s;      // 估计角加速度(rpm/s)
+    float rpm_raw;          // 本周期测量转速(rpm), 未滤波
+    float speed_cm_s;       // 线速度(cm/s)
+} EncoderFeedback_t;
+
 void Encoder_Init(void);
 void Encoder_Task(void);
+void Encoder_GetFeedback(uint8_t axis, EncoderFeedback_t *feedback);
+
+extern uint16_t encoder_ppr;
 
 #endif
@@ -10,7 +10,12 @@ void Gray_Init(void)
 void Gray_Task(void)
 {
     //ȡ
-    gray_digtal = ~IIC_Get_Digtal();
+    unsigned char dat;
+
+    // ȡʧ (I2C æӦ) ʱϴεֵ, ʹδд
+    if (IIC_ReadBytes(GW_GRAY_ADDR_DEF << 1, GW_GRAY_DIGITAL_MODE, &dat, 1)) {
+        gray_digtal = ~dat;
+    }
 //    Uart_Printf(DEBUG_UART, "Digtal %d-%d-%d-%d-%d-%d-%d-%d\r\n",(gray_digtal>>0)&0x01,(gray_digtal>>1)&0x01,(gray_digtal>>2)&0x01,(gray_digtal>>3)&0x01,
 //                                                              (gray_digtal>>4)&0x01,(gray_digtal>>5)&0x01,(gray_digtal>>6)&0x01,(gray_digtal>>7)&0x01);
 }
@@ -47,9 +47,6 @@ KeyEvent Key_ConvertToUIEvent(uint16_t key_id, ebtn_evt_t evt)
 
 // ============================= 按键事件回调函数 =============================
 
-extern MOTOR left_motor;
-extern MOTOR right_motor;
-
 /* 按键事件处理的回调函数 */
 void my_handle_key_event(struct ebtn_btn *btn, ebtn_evt_t evt) {
     uint16_t key_id = btn->key_id;
@@ -75,6 +72,6 @@ void my_handle_key_event(struct ebtn_btn *btn, ebtn_evt_t evt) {
     // ============================= 调试输出 =============================
 
     if (evt == EBTN_EVT_ONPRESS) {
-        Uart_Printf(DEBUG_UART, "Key%d Down\r\n", (int)key_id);
+        LOG_D("Key%d Down", (int)key_id);
     }
 }
@@ -0,0 +1,127 @@
+#include "log_app.h"
+#include "log.h"
+#include "frame.h"
+
+// 日志缓冲区 (写端: 任意任务/中断, 关中断写入整条; 读端: Log_Task)
+// 每条: 1字节长度 + 帧负载
+static uint8_t log_ring_buffer[LOG_RING_SIZE];
+static Spsc_T log_ring;
+
+static volatile uint8_t log_output = LOG_OUTPUT_DEFAULT;   // 输出方式 (前台写, Log_Task 读)
+static volatile uint32_t log_dropped = 0;                   // 缓冲区放不下而丢弃的条数
+static uint32_t log_dropped_reported = 0;                   // 已报告的丢弃条数 (只在 Log_Task 读写)
+
+static const char log_level_name[] = "EWID";
+
+/**
+ * @brief 初始化日志缓冲区
+ * @note 在其他模块初始化之前调用, 之前的日志丢失; 初始化期间的日志由 Log_Task 开始运行后输出
+ */
+void Log_Init(void)
+{
+    spsc_init(&log_ring, log_ring_buffer, LOG_RING_SIZE);
+}
+
+/**
+ * @brief 设置输出方式
+ * @param output LOG_OUTPUT_BINARY / LOG_OUTPUT_TEXT
+ */
+void Log_SetOutput(uint8_t output)
+{
+    log_output = output;
+}
+
+/**
+ * @brief 写一条日志 (由 LOG_x 宏调用)
+ * @param level 日志级别
+ * @param fmt 格式串 (须为 LOG_x 宏中的静态常量, 地址即编号)
+ * @param ... 参数
+ * @note 只打包参数, 不格式化; 关中断的时间只有一次拷贝 (不超过 LOG_FRAME_HEADER + LOG_ARGS_MAX 字节),
+ *       缓冲区放不下时丢弃并计数, 可在中断中调用
+ */
+void Log_Write(uint8_t level, const char *fmt, ...)
+{
+    uint8_t record[1 + LOG_FRAME_HEADER + LOG_ARGS_MAX];
+    uint32_t tick = HAL_GetTick();
+    uint32_t id = (uint32_t)(uintptr_t)fmt;
+    va_list args;
+    uint32_t len;
+
+    va_start(args, fmt);
+    len = LOG_FRAME_HEADER + log_pack(&record[1 + LOG_FRAME_HEADER], LOG_ARGS_MAX, fmt, args);
+    va_end(args);
+
+    record[0] = (uint8_t)len;
+    record[1] = LOG_FRAME_RECORD;
+    record[2] = level;
+    memcpy(&record[3], &tick, 4);
+    memcpy(&record[7], &id, 4);
+
+    // 写端可能有多个 (各优先级任务和中断), 整条写入期间关中断
+    uint32_t state = kernel_port_irq_save();
+    if (spsc_space_len(&log_ring) >= 1 + len) {
+        spsc_write(&log_ring, record, 1 + len);
+    } else {
+        log_dropped++;
+    }
+    kernel_port_irq_restore(state);
+}
+
+/**
+ * @brief 输出一条日志
+ * @param payload 帧负载
+ * @param len 负载字节数
+ */
+static void Log_Emit(const uint8_t *payload, uint32_t len)
+{
+    static uint8_t frame[1 + FRAME_ENCODED_MAX(LOG_FRAME_HEADER + LOG_ARGS_MAX)];
+    static char text[160];
+
+    if (log_output == LOG_OUTPUT_BINARY) {
+        // 帧前后各一个分隔符, 与文本输出分开
+        frame[0] = FRAME_DELIMITER;
+        Uart_Write(DEBUG_UART, frame, 1 + frame_encode(payload, len, &frame[1]));
+    } else {
+        uint32_t tick, id;
+        memcpy(&tick, &payload[2], 4);
+        memcpy(&id, &payload[6], 4);
+
+        int n = snprintf(text, sizeof(text), "[%c %lu] ", log_level_name[payload[1] & 3], (unsigned long)tick);
+        n += log_format(&text[n], sizeof(text) - 2 - n, (const char *)(uintptr_t)id,
+                        &payload[LOG_FRAME_HEADER], len - LOG_FRAME_HEADER);
+        text[n++] = '\r';
+        text[n++] = '\n';
+        Uart_Write(DEBUG_UART, (const uint8_t *)text, n);
+    }
+}
+
+/**
+ * @brief 取走缓冲区中的所有日志并输出
+ */
+static void Log_Drain(void)
+{
+    static uint8_t payload[LOG_FRAME_HEADER + LOG_ARGS_MAX];
+    uint8_t len;
+
+    while (spsc_read(&log_ring, &len, 1) == 1) {
+        spsc_read(&log_ring, payload, len);  // 整条一起写入, 长度可见时内容已完整
+        Log_Emit(payload, len);
+    }
+}
+
+/**
+ * @brief 日志输出任务: 取走缓冲区中的日志, 按输出方式编码或格式化后放入串口发送队列
+ * @note 文本方式的格式化在这里完成 (最低优先级), 不占用调用处的时间和栈
+ *       有日志被丢弃时, 取空缓冲区后补一条丢弃条数
+ */
+void Log_Task(void)
+{
+    Log_Drain();
+
+    uint32_t dropped = log_dropped;
+    if (dropped != log_dropped_reported) {
+        LOG_W("log: %lu records dropped", (unsigned long)(dropped - log_dropped_reported));
+        log_dropped_reported = dropped;
+        Log_Drain();
+    }
+}
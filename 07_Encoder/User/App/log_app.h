@@ -0,0 +1,85 @@
+#ifndef __LOG_APP_H__
+#define __LOG_APP_H__
+
+#include "MyDefine.h"
+
+/**
+ * @brief 日志级别
+ */
+#define LOG_LEVEL_ERROR 0
+#define LOG_LEVEL_WARN  1
+#define LOG_LEVEL_INFO  2
+#define LOG_LEVEL_DEBUG 3
+
+// 编译期级别: 高于此级别的 LOG_x 调用编译为空
+#define LOG_LEVEL LOG_LEVEL_DEBUG
+
+/**
+ * @brief 输出方式 (可用串口命令 "log bin" / "log text" 切换)
+ * @note LOG_OUTPUT_BINARY = 二进制帧 (格式串地址 + 参数), 由主机端 Tools/log_decode 对照固件中的格式串还原文本
+ *       LOG_OUTPUT_TEXT   = Log_Task 在设备上格式化为文本, 没有主机工具时使用
+ */
+#define LOG_OUTPUT_BINARY 0
+#define LOG_OUTPUT_TEXT   1
+
+#define LOG_OUTPUT_DEFAULT LOG_OUTPUT_BINARY
+
+// 日志缓冲区大小(字节, 2的幂)
+#define LOG_RING_SIZE 1024
+// 单条日志参数最多字节数, 放不下的参数显示为 ?
+#define LOG_ARGS_MAX 48
+
+// 帧类型 (负载第一个字节)
+#define LOG_FRAME_RECORD 0x4C
+
+/*
+    帧负载 (小端):
+      uint8_t  type     LOG_FRAME_RECORD
+      uint8_t  level    日志级别
+      uint32_t tick     HAL_GetTick (ms)
+      uint32_t fmt      格式串地址 (主机端在固件 .axf 的符号表中按 log_fmt_ 查找)
+      uint8_t  args[]   参数, 编码见 Module/Log
+*/
+#define LOG_FRAME_HEADER 10
+
+/**
+ * @brief 写一条日志
+ * @note 格式串放在名为 log_fmt_ 的静态常量中, 地址即格式串编号;
+ *       调用处只打包参数 (不格式化), 可在中断中调用, 不阻塞
+ *       格式串末尾不需要 "\r\n", 输出时每条自动换行
+ */
+#define LOG_RECORD(level, fmt, ...) do { \
+        static const char log_fmt_[] = fmt; \
+        Log_Write((level), log_fmt_, ##__VA_ARGS__); \
+    } while (0)
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_E(fmt, ...) LOG_RECORD(LOG_LEVEL_ERROR, fmt, ##__VA_ARGS__)
+#else
+#define LOG_E(fmt, ...) ((void)0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_W(fmt, ...) LOG_RECORD(LOG_LEVEL_WARN, fmt, ##__VA_ARGS__)
+#else
+#define LOG_W(fmt, ...) ((void)0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_I(fmt, ...) LOG_RECORD(LOG_LEVEL_INFO, fmt, ##__VA_ARGS__)
+#else
+#define LOG_I(fmt, ...) ((void)0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_D(fmt, ...) LOG_RECORD(LOG_LEVEL_DEBUG, fmt, ##__VA_ARGS__)
+#else
+#define LOG_D(fmt, ...) ((void)0)
+#endif
+
+void Log_Init(void);
+void Log_Task(void);
+void Log_Write(uint8_t level, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+void Log_SetOutput(uint8_t output);
+
+#endif
@@ -1,85 +1,69 @@
 #include "motor_app.h"
 #include "pid_app.h"
 #include "encoder_app.h"
+#include "axis_app.h"
 
-// ============================= 外部变量引用 =============================
-extern Encoder left_encoder;
-extern Encoder right_encoder;
-extern PID_T pid_speed_left;
-extern PID_T pid_speed_right;
-extern unsigned char pid_running;
+// 选择用于圈数控制的轴 (右轮在所有布局中都存在)
+#define CIRCLE_CONTROL_AXIS     AXIS_RIGHT
+#define CIRCLE_CONTROL_ENCODER  axes[CIRCLE_CONTROL_AXIS].encoder
 
-// 选择用于圈数控制的编码器 (只有右轮电机,使用右轮编码器)
-#define CIRCLE_CONTROL_ENCODER  right_encoder
+// 圈数控制到位判据
+#define CIRCLE_POS_TOLERANCE    3       // 到位误差(脉冲), 约0.7°
+#define CIRCLE_STILL_RPM        1.0f    // 不刹车保持时, 到位还要求转速低于该值
+#define CIRCLE_SETTLE_TIMEOUT   CONTROL_OUTER_MS_TO_TICKS(1000)  // 收敛超时1s, 超时按当前误差结束
 
-// ============================= 电机硬件实例 =============================
-#if MOTOR_COUNT == 2
-MOTOR left_motor;   // 左电机
-#endif
-MOTOR right_motor;  // 右电机
+// 标定使用的轴
+#define CALIB_AXIS              AXIS_RIGHT
+
+// 驱动层默认死区补偿PWM (未标定时使用)
+#define MOTOR_DEAD_BAND_PWM     550
+
+// 标定扫描范围: 从死区以下开始, 覆盖常用转速
+#define MOTOR_CALIB_PWM_START   450
+#define MOTOR_CALIB_PWM_END     900
+#define MOTOR_CALIB_PWM_STEP    25
 
 // ============================= 电机状态 =============================
 static MotorState motor_state = {
     .mode = MOTOR_MODE_IDLE,
     .is_running = 0,
+    .control_mode = MOTOR_CTRL_CLOSED_LOOP,
     .direction = MOTOR_DIR_FORWARD,
-    .basic_speed = 40.0f,
+    .basic_speed = 30.0f,
     .current_gear = SPEED_GEAR_LOW,
     .target_rpm = 30.0f,
     .accel_mode = ACCEL_MODE_LOW,
     .accel_target_rpm = 30.0f,
     .trapezoid_phase = TRAPEZOID_IDLE,
-    .trapezoid_timer = 0,
     .trapezoid_current_rpm = 30.0f,
+    .profile_ticks = 0,
+    .profile_time = 0.0f,
+    .profile_total_time = 0.0f,
+    .profile_distance = 0.0f,
     .circle_state = CIRCLE_IDLE,
-    .target_circles = 5,
-    .start_total_count = 0,
+    .target_circles = 5.0f,
     .current_circles = 0.0f,
     .remain_circles = 0.0f,
-    .current_rpm = 0.0f,
-    .right_rpm = 0.0f
+    .circle_target_pulses = 0,
+    .circle_final_error = 0,
+    .circle_settle_timer = 0,
+    .current_rpm = 0.0f
 };
 
-// ============================= PWM配置表(集中管理) =============================
-
-/**
- * @brief PWM配置表 - 所有参数集中管理
- */
-typedef struct {
-    // 基本运行模式
-    int basic_run_pwm;           // 正转PWM值
-    int basic_run_reverse_pwm;   // 反转PWM值
+// 内环发布的编码器反馈, 外环每个周期开始时读取一次
+static EncoderFeedback_t motor_feedback[AXIS_COUNT];
 
-    // 三档变速模式
-    int gear_low_pwm;            // 低速档 (30rpm)
-    int gear_mid_pwm;            // 中速档 (50rpm)
-    int gear_high_pwm;           // 高速档 (80rpm)
+// 圈数控制起点位置 (脉冲)
+static int64_t circle_marker_position = 0;
 
-    // 加速度测试模式
-    float accel_start_rpm;       // 起始转速
-    float accel_max_rpm;         // 最大转速
-    float accel_rate_low;        // 低加速度 (rpm/s)
-    float accel_rate_high;       // 高加速度 (rpm/s)
-
-    // 梯形曲线模式
-    float trapezoid_start_rpm;   // 起始转速
-    float trapezoid_max_rpm;     // 最大转速
-    float trapezoid_accel_rate;  // 加速度 (rpm/s)
-    float trapezoid_decel_rate;  // 减速度 (rpm/s)
-    uint16_t trapezoid_accel_time_ms;  // 加速时间(ms)
-    uint16_t trapezoid_const_time_ms;  // 恒速时间(ms)
-    uint16_t trapezoid_decel_time_ms;  // 减速时间(ms)
-
-    // 圈数控制模式
-    float circle_control_rpm;    // 运行转速
-    int16_t encoder_ppr;         // 编码器PPR
-} MotorPWMConfig;
+// ============================= PWM配置表(集中管理) =============================
 
 /**
  * @brief PWM配置参数 (根据实测校准)
  * @note 线性关系: PWM = 1.30 * rpm + 529.2
+ *       上电时可被参数存储中的记录覆盖 (见 param_app)
  */
-static const MotorPWMConfig pwm_config = {
+MotorPWMConfig pwm_config = {
     // 基本运行 (30rpm)
     .basic_run_pwm = 568,
     .basic_run_reverse_pwm = 568,
@@ -94,37 +78,49 @@ static const MotorPWMConfig pwm_config = {
     .accel_max_rpm = 200.0f,
     .accel_rate_low = 5.0f,    // 5 rpm/s
     .accel_rate_high = 20.0f,  // 20 rpm/s
+    .accel_jerk = 40.0f,       // 起步0.125s/0.5s内建立加速度
 
     // 梯形曲线 (第四问)
     .trapezoid_start_rpm = 15.0f,
     .trapezoid_max_rpm = 115.0f,
     .trapezoid_accel_rate = 20.0f,
     .trapezoid_decel_rate = 20.0f,
-    .trapezoid_accel_time_ms = 5000,
+    .trapezoid_jerk = 40.0f,   // 阶段切换处0.5s过渡, 消除加速度阶跃
     .trapezoid_const_time_ms = 10000,
-    .trapezoid_decel_time_ms = 5000,
 
     // 圈数控制
-    .circle_control_rpm = 16.0f,
-    .encoder_ppr = 1551
+    .circle_control_rpm = 120.0f,
+    .circle_accel_rate = 240.0f,   // 0.5s加到最大转速
+    .circle_jerk = 2400.0f,
+    .circle_pos_kp = 8.0f,
+    .circle_brake_hold = 1
 };
 
 // 三档转速定义(仅用于显示) - 根据实测PWM校准
 static const float gear_speeds[] = {30.0f, 50.0f, 80.0f};
 
+// ============================= 速度曲线 =============================
+static SCurve_T motor_profile;     // Acceleration / Trapezoid 模式的S曲线
+
+// ============================= PWM→转速标定 =============================
+CalibTable_T calib_table;          // 标定结果, valid=1 后替代线性公式
+static CalibSweep_T calib_sweep;   // 扫描状态机
+
 // ============================= 初始化函数 =============================
 
 /**
  * @brief 初始化电机硬件
+ * @note 按布局表绑定每个轴的PWM通道
  */
 void Motor_Init(void)
 {
-#if MOTOR_COUNT == 2
-    // 初始化左电机 (TIM2)
-    Motor_Config_Init(&left_motor, &htim2, TIM_CHANNEL_3, &htim2, TIM_CHANNEL_4, 0, 550);
-#endif
-    // 初始化右电机 (TIM1)
-    Motor_Config_Init(&right_motor, &htim1, TIM_CHANNEL_4, &htim1, TIM_CHANNEL_3, 0, 550);
+    for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+        const AxisConfig *cfg = &axis_config[i];
+        Motor_Config_Init(&axes[i].motor,
+                          cfg->pwm_htim, cfg->pwm_in1_channel,
+                          cfg->pwm_htim, cfg->pwm_in2_channel,
+                          cfg->motor_reverse, MOTOR_DEAD_BAND_PWM);
+    }
 }
 
 // ============================= 内部辅助函数 =============================
@@ -134,39 +130,33 @@ void Motor_Init(void)
  */
 static void Motor_UpdateFeedback(void)
 {
-#if MOTOR_COUNT == 2
-    motor_state.left_rpm = left_encoder.rpm;
-#endif
-    motor_state.right_rpm = right_encoder.rpm;
-
-#if MOTOR_COUNT == 2
-    // 双电机:取平均值
-    motor_state.current_rpm = (left_encoder.rpm_filtered + right_encoder.rpm_filtered) * 0.5f;
-#else
-    // 单电机:仅用右电机
-    motor_state.current_rpm = right_encoder.rpm_filtered;
-#endif
-}
-
-/**
- * @brief 更新PID目标值 (当前使用开环控制,保留接口)
- */
-static void Motor_UpdatePIDTarget(float target_rpm)
-{
-    (void)target_rpm;
+    // 所有轴取平均值 (单电机布局即右轮转速)
+    float sum = 0.0f;
+    for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+        Encoder_GetFeedback(i, &motor_feedback[i]);
+        sum += motor_feedback[i].rpm;
+    }
+    motor_state.current_rpm = sum / AXIS_COUNT;
 }
 
 /**
  * @brief RPM转换为PWM值
  * @param rpm 目标转速
  * @return PWM值
- * @note 线性关系: 1.30 PWM/rpm
+ * @note 已标定: 标定表分段线性插值(含死区边缘)
+ *       未标定: 线性关系 1.30 PWM/rpm
  *       基准点: PWM=550 对应 RPM=16
  *       公式: PWM = 550 + (rpm - 16) * 1.30 = 1.30 * rpm + 529.2
  */
 static int Motor_RPM_to_PWM(float rpm)
 {
-    int pwm = (int)(1.30f * rpm + 529.2f);
+    int pwm;
+
+    if (calib_table.valid) {
+        pwm = calib_table_rpm_to_pwm(&calib_table, rpm);
+    } else {
+        pwm = (int)(1.30f * rpm + 529.2f);
+    }
 
     // PWM限幅 (最小100, 最大999)
     if (pwm < 100) pwm = 100;
@@ -175,16 +165,48 @@ static int Motor_RPM_to_PWM(float rpm)
     return pwm;
 }
 
+/**
+ * @brief 有符号转速转换为前馈PWM
+ * @param rpm 目标转速(正数=正转,负数=反转, 0=停止)
+ * @return 前馈PWM值
+ */
+static int Motor_RPM_to_FeedforwardPWM(float rpm)
+{
+    if (rpm > 0.0f) return Motor_RPM_to_PWM(rpm);
+    if (rpm < 0.0f) return -Motor_RPM_to_PWM(-rpm);
+    return 0;
+}
+
+/**
+ * @brief 更新PID目标值
+ * @param target_rpm 目标转速(正数=正转,负数=反转)
+ * @note 线性拟合只作为前馈, 剩余误差由速度环补偿
+ */
+static void Motor_UpdatePIDTarget(float target_rpm)
+{
+    PID_SetSpeedTarget(target_rpm, (float)Motor_RPM_to_FeedforwardPWM(target_rpm));
+}
+
 /**
  * @brief 集中化的电机PWM设置函数
  * @param pwm_value PWM值(正数=正转,负数=反转)
  */
 static void Motor_SetPWM(int pwm_value)
 {
-#if MOTOR_COUNT == 2
-    Motor_Set_Speed(&left_motor, pwm_value);
-#endif
-    Motor_Set_Speed(&right_motor, pwm_value);
+    for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+        Motor_Set_Speed(&axes[i].motor, pwm_value);
+    }
+}
+
+/**
+ * @brief 设置驱动层死区补偿PWM
+ * @param dead_band 死区PWM(0=关闭补偿)
+ */
+static void Motor_SetDeadBand(int dead_band)
+{
+    for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+        axes[i].motor.dead_band_speed = dead_band;
+    }
 }
 
 /**
@@ -231,11 +253,6 @@ static int Motor_GetCurrentModePWM(void)
             pwm_value = Motor_RPM_to_PWM(motor_state.trapezoid_current_rpm);
             break;
 
-        case MOTOR_MODE_CIRCLE_CONTROL:
-            // 圈数控制模式使用固定转速
-            pwm_value = Motor_RPM_to_PWM(pwm_config.circle_control_rpm);
-            break;
-
         default:
             pwm_value = 0;
             break;
@@ -244,11 +261,209 @@ static int Motor_GetCurrentModePWM(void)
     return pwm_value;
 }
 
+/**
+ * @brief 根据当前模式获取对应的目标转速
+ * @return 目标转速(rpm, 负数=反转)
+ * @note 闭环模式下作为速度环设定值
+ */
+static float Motor_GetCurrentModeRPM(void)
+{
+    float rpm = 0.0f;
+
+    switch (motor_state.mode) {
+        case MOTOR_MODE_BASIC_RUN:
+            rpm = motor_state.basic_speed;
+            if (motor_state.direction == MOTOR_DIR_REVERSE) {
+                rpm = -rpm;
+            }
+            break;
+
+        case MOTOR_MODE_SPEED_GEAR:
+            rpm = gear_speeds[motor_state.current_gear];
+            break;
+
+        case MOTOR_MODE_ACCELERATION:
+            rpm = motor_state.accel_target_rpm;
+            break;
+
+        case MOTOR_MODE_TRAPEZOID:
+            rpm = motor_state.trapezoid_current_rpm;
+            break;
+
+        default:
+            rpm = 0.0f;
+            break;
+    }
+
+    return rpm;
+}
+
+/**
+ * @brief 圈数控制已走过的脉冲数 (自启动时的起点)
+ */
+static int64_t Motor_Circle_Delta(void)
+{
+    return motor_feedback[CIRCLE_CONTROL_AXIS].position - circle_marker_position;
+}
+
+/**
+ * @brief 圈数控制位置环 (位置环 → 速度环串级)
+ * @note 速度目标 = 曲线速度前馈 + kp × (曲线位置 - 实际位置),
+ *       曲线结束后曲线位置停在目标处, 位置环把剩余误差收敛到零
+ */
+static void Motor_Circle_PositionLoop(void)
+{
+    SCurvePoint_T sp;
+    float counts_to_rpm = 60.0f / CIRCLE_CONTROL_ENCODER.ppr;
+    float rpm_limit = pwm_config.circle_control_rpm * 1.2f;
+
+    scurve_eval(&motor_profile, motor_state.profile_time, &sp);
+    if (motor_state.circle_state != CIRCLE_RUNNING) {
+        // 收敛阶段: 参考点固定在目标处, 用整数误差避免大圈数时的浮点截断
+        sp.p = 0.0f;
+        sp.v = 0.0f;
+    } else {
+        sp.p -= (float)motor_state.circle_target_pulses;
+    }
+
+    // 位置误差(脉冲) = 曲线位置 - 实际位置
+    int64_t to_target = motor_state.circle_target_pulses - Motor_Circle_Delta();
+    float error = sp.p + (float)to_target;
+
+    float rpm = (sp.v + pwm_config.circle_pos_kp * error) * counts_to_rpm;
+    if (rpm > rpm_limit) rpm = rpm_limit;
+    if (rpm < -rpm_limit) rpm = -rpm_limit;
+
+    Motor_UpdatePIDTarget(rpm);
+}
+
+/**
+ * @brief 输出当前模式的设定值
+ * @note 开环: 直接查表/线性换算输出PWM
+ *       闭环: 更新速度环目标, PWM由 PID_Task 输出
+ *       圈数控制始终为位置环+速度环, 与控制方式无关
+ */
+static void Motor_ApplySetpoint(void)
+{
+    if (motor_state.mode == MOTOR_MODE_CALIBRATION) {
+        // 标定: 始终开环输出扫描PWM
+        Motor_SetPWM(calib_sweep.pwm);
+    } else if (motor_state.mode == MOTOR_MODE_CIRCLE_CONTROL) {
+        Motor_Circle_PositionLoop();
+    } else if (motor_state.control_mode == MOTOR_CTRL_CLOSED_LOOP) {
+        Motor_UpdatePIDTarget(Motor_GetCurrentModeRPM());
+    } else if (calib_table.valid) {
+        // 已标定: 开环也按标定表换算, 不再使用固定PWM表
+        Motor_SetPWM(Motor_RPM_to_FeedforwardPWM(Motor_GetCurrentModeRPM()));
+    } else {
+        Motor_SetPWM(Motor_GetCurrentModePWM());
+    }
+}
+
+/**
+ * @brief 规划速度曲线并从头开始执行
+ * @param limits 起止/最大速度及加速度约束(rpm, rpm/s, rpm/s²)
+ * @param cruise_time 最大速度保持时间(s)
+ */
+static void Motor_Profile_Start(const SCurveLimits_T *limits, float cruise_time)
+{
+    scurve_plan_velocity(&motor_profile, limits, cruise_time);
+    motor_state.profile_ticks = 0;
+    motor_state.profile_time = 0.0f;
+    motor_state.profile_total_time = motor_profile.total_time;
+    motor_state.profile_distance = motor_profile.distance / 60.0f;  // rpm·s → 圈
+}
+
+/**
+ * @brief 曲线时间前进一个外环周期
+ * @note 由整数周期数换算时间, 不累加浮点步长, 各控制频率下曲线时间一致
+ */
+static void Motor_Profile_Tick(void)
+{
+    motor_state.profile_ticks++;
+    motor_state.profile_time = (float)motor_state.profile_ticks / CONTROL_OUTER_RATE_HZ;
+}
+
+/**
+ * @brief 速度曲线前进一个外环周期
+ * @return 当前目标转速(rpm)
+ */
+static float Motor_Profile_Step(void)
+{
+    SCurvePoint_T sp;
+
+    Motor_Profile_Tick();
+    scurve_eval(&motor_profile, motor_state.profile_time, &sp);
+    return sp.v;
+}
+
+/**
+ * @brief 按当前档位规划加速度测试曲线
+ * @param start_rpm 起始转速(运行中切换档位时从当前转速继续)
+ */
+static void Motor_Acceleration_Plan(float start_rpm)
+{
+    float rate = (motor_state.accel_mode == ACCEL_MODE_LOW) ?
+                 pwm_config.accel_rate_low : pwm_config.accel_rate_high;
+    SCurveLimits_T limits = {
+        .v_start = start_rpm,
+        .v_max = pwm_config.accel_max_rpm,
+        .v_end = pwm_config.accel_max_rpm,  // 加到最大转速后保持
+        .accel = rate,
+        .decel = rate,
+        .jerk = pwm_config.accel_jerk,
+    };
+
+    Motor_Profile_Start(&limits, 0.0f);
+}
+
+/**
+ * @brief 圈数控制到位: 记录最终误差, 停机并按配置刹车保持
+ * @param error 到位时的误差(脉冲, 目标-实际)
+ */
+static void Motor_Circle_Finish(int64_t error)
+{
+    motor_state.circle_final_error = (int32_t)error;
+    motor_state.circle_state = CIRCLE_FINISHED;
+    MotorApp_Stop();
+
+    if (pwm_config.circle_brake_hold) {
+        for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+            Motor_Brake(&axes[i].motor);
+        }
+    }
+}
+
+/**
+ * @brief 规划圈数控制的位置曲线 (单位: 脉冲, 脉冲/s)
+ */
+static void Motor_Circle_Plan(void)
+{
+    float rpm_to_cps = CIRCLE_CONTROL_ENCODER.ppr / 60.0f;
+    SCurveLimits_T limits = {
+        .v_start = 0.0f,
+        .v_max = pwm_config.circle_control_rpm * rpm_to_cps,
+        .v_end = 0.0f,
+        .accel = pwm_config.circle_accel_rate * rpm_to_cps,
+        .decel = pwm_config.circle_accel_rate * rpm_to_cps,
+        .jerk = pwm_config.circle_jerk * rpm_to_cps,
+    };
+
+    motor_state.circle_target_pulses =
+        (int64_t)(motor_state.target_circles * CIRCLE_CONTROL_ENCODER.ppr + 0.5f);
+
+    scurve_plan_distance(&motor_profile, &limits, (float)motor_state.circle_target_pulses);
+    motor_state.profile_ticks = 0;
+    motor_state.profile_time = 0.0f;
+    motor_state.profile_total_time = motor_profile.total_time;
+    motor_state.profile_distance = motor_state.target_circles;
+}
+
 // ============================= 任务函数 =============================
 
 /**
- * @brief 电机控制任务(每10ms调用一次)
- * @note 更新实时反馈数据,执行各模式的状态机逻辑
+ * @brief 电机控制任务 (控制外环, 前台调度器每 CONTROL_OUTER_PERIOD_MS 调用一次)
+ * @note 读取内环发布的反馈,执行各模式的状态机逻辑, 闭环时只向内环发布速度目标
  */
 void Motor_Task(void)
 {
@@ -269,109 +484,83 @@ void Motor_Task(void)
             break;
 
         case MOTOR_MODE_ACCELERATION:
-            // 加速度测试模式: 持续加速
-            {
-                // 获取当前加速度
-                float accel_rate = (motor_state.accel_mode == ACCEL_MODE_LOW) ?
-                                   pwm_config.accel_rate_low : pwm_config.accel_rate_high;
-
-                // 计算每10ms的增量
-                float delta_rpm = accel_rate * 0.01f;
-                motor_state.accel_target_rpm += delta_rpm;
-
-                // 限制最大转速
-                if (motor_state.accel_target_rpm > pwm_config.accel_max_rpm) {
-                    motor_state.accel_target_rpm = pwm_config.accel_max_rpm;
-                }
-
-                // 更新PWM
-                Motor_SetPWM(Motor_GetCurrentModePWM());
-            }
+            // 加速度测试模式: S曲线加速到最大转速后保持
+            motor_state.accel_target_rpm = Motor_Profile_Step();
+            Motor_ApplySetpoint();
             break;
 
         case MOTOR_MODE_TRAPEZOID:
-            // 梯形曲线模式: 加速 → 恒速 → 减速
+            // 梯形曲线模式: 加速 → 恒速 → 减速 (S曲线, jerk=0时即原梯形)
             {
-                motor_state.trapezoid_timer += 10;  // 递增10ms
-
-                switch (motor_state.trapezoid_phase) {
-                    case TRAPEZOID_ACCEL:
-                        // 加速阶段
-                        {
-                            float delta_rpm = pwm_config.trapezoid_accel_rate * 0.01f;
-                            motor_state.trapezoid_current_rpm += delta_rpm;
-
-                            // 检查是否达到最大转速或超时
-                            if (motor_state.trapezoid_current_rpm >= pwm_config.trapezoid_max_rpm ||
-                                motor_state.trapezoid_timer >= pwm_config.trapezoid_accel_time_ms) {
-                                motor_state.trapezoid_current_rpm = pwm_config.trapezoid_max_rpm;
-                                motor_state.trapezoid_phase = TRAPEZOID_CONST;
-                                motor_state.trapezoid_timer = 0;
-                            }
-
-                            Motor_SetPWM(Motor_GetCurrentModePWM());
-                        }
-                        break;
-
-                    case TRAPEZOID_CONST:
-                        // 恒速阶段
-                        if (motor_state.trapezoid_timer >= pwm_config.trapezoid_const_time_ms) {
-                            motor_state.trapezoid_phase = TRAPEZOID_DECEL;
-                            motor_state.trapezoid_timer = 0;
-                        }
-                        // 保持最大转速(PWM已设置)
-                        break;
-
-                    case TRAPEZOID_DECEL:
-                        // 减速阶段
-                        {
-                            float delta_rpm = pwm_config.trapezoid_decel_rate * 0.01f;
-                            motor_state.trapezoid_current_rpm -= delta_rpm;
-
-                            // 检查是否降到起始转速或超时
-                            if (motor_state.trapezoid_current_rpm <= pwm_config.trapezoid_start_rpm ||
-                                motor_state.trapezoid_timer >= pwm_config.trapezoid_decel_time_ms) {
-                                motor_state.trapezoid_current_rpm = pwm_config.trapezoid_start_rpm;
-                                motor_state.trapezoid_phase = TRAPEZOID_FINISHED;
-                                motor_state.trapezoid_timer = 0;
-                                MotorApp_Stop();  // 自动停止
-                                return;  // 已停止,退出
-                            }
-
-                            if (motor_state.is_running) {  // 检查是否被Stop中断
-                                Motor_SetPWM(Motor_GetCurrentModePWM());
-                            }
-                        }
-                        break;
-
-                    default:
-                        break;
+                motor_state.trapezoid_current_rpm = Motor_Profile_Step();
+
+                uint8_t seg = scurve_segment(&motor_profile, motor_state.profile_time);
+                if (seg >= SCURVE_SEGMENTS) {
+                    motor_state.trapezoid_current_rpm = pwm_config.trapezoid_start_rpm;
+                    motor_state.trapezoid_phase = TRAPEZOID_FINISHED;
+                    MotorApp_Stop();  // 自动停止
+                    return;  // 已停止,退出
                 }
+
+                // 0~2段加速, 3段恒速, 4~6段减速
+                motor_state.trapezoid_phase = (seg < 3) ? TRAPEZOID_ACCEL :
+                                              (seg == 3) ? TRAPEZOID_CONST : TRAPEZOID_DECEL;
+                Motor_ApplySetpoint();
             }
             break;
 
         case MOTOR_MODE_CIRCLE_CONTROL:
-            // 圈数控制模式: 监控编码器脉冲数
-            if (motor_state.circle_state == CIRCLE_RUNNING) {
-                // 计算当前已转脉冲数
-                int32_t delta_count = CIRCLE_CONTROL_ENCODER.total_count - motor_state.start_total_count;
-
-                // 处理正反转(取绝对值)
-                if (delta_count < 0) delta_count = -delta_count;
+            // 圈数控制模式: 按位置曲线运行, 曲线结束后收敛到目标脉冲
+            {
+                int64_t delta_count = Motor_Circle_Delta();
 
                 // 计算当前圈数和剩余圈数(用于显示)
-                motor_state.current_circles = (float)delta_count / pwm_config.encoder_ppr;
+                motor_state.current_circles = (float)delta_count / CIRCLE_CONTROL_ENCODER.ppr;
                 motor_state.remain_circles = motor_state.target_circles - motor_state.current_circles;
                 if (motor_state.remain_circles < 0.0f) {
                     motor_state.remain_circles = 0.0f;
                 }
 
-                // 检查是否完成目标圈数
-                int32_t target_pulses = motor_state.target_circles * pwm_config.encoder_ppr;
-                if (delta_count >= target_pulses) {
-                    motor_state.circle_state = CIRCLE_FINISHED;
-                    MotorApp_Stop();
+                if (motor_state.circle_state == CIRCLE_RUNNING) {
+                    Motor_Profile_Tick();
+                    if (motor_state.profile_time >= motor_state.profile_total_time) {
+                        motor_state.circle_state = CIRCLE_SETTLING;
+                        motor_state.circle_settle_timer = 0;
+                    }
+                }
+
+                if (motor_state.circle_state == CIRCLE_SETTLING) {
+                    int64_t error = motor_state.circle_target_pulses - delta_count;
+                    float rpm = motor_feedback[CIRCLE_CONTROL_AXIS].rpm;
+
+                    // 进入误差带立即刹车, 避免死区补偿在目标附近来回修正
+                    uint8_t in_position = (error <= CIRCLE_POS_TOLERANCE && error >= -CIRCLE_POS_TOLERANCE) &&
+                                          (pwm_config.circle_brake_hold ||
+                                           (rpm < CIRCLE_STILL_RPM && rpm > -CIRCLE_STILL_RPM));
+
+                    if (in_position || ++motor_state.circle_settle_timer >= CIRCLE_SETTLE_TIMEOUT) {
+                        Motor_Circle_Finish(error);
+                        return;  // 已停止,退出
+                    }
+                }
+
+                Motor_ApplySetpoint();
+            }
+            break;
+
+        case MOTOR_MODE_CALIBRATION:
+            // 标定模式: 逐点升高PWM, 等待转速稳定后记录
+            {
+                int16_t pwm = calib_sweep_update(&calib_sweep, motor_feedback[CALIB_AXIS].rpm);
+
+                if (calib_sweep.state != CALIB_SETTLING) {
+                    MotorApp_Stop();  // 完成或失败, 停机并恢复死区补偿
+                    if (calib_sweep.state == CALIB_DONE) {
+                        Param_RequestSave();  // 标定结果写入flash
+                    }
+                    return;
                 }
+                Motor_SetPWM(pwm);
             }
             break;
 
@@ -410,21 +599,43 @@ void MotorApp_Start(void)
         case MOTOR_MODE_ACCELERATION:
             // 加速度模式: 从起始转速开始
             motor_state.accel_target_rpm = pwm_config.accel_start_rpm;
+            Motor_Acceleration_Plan(pwm_config.accel_start_rpm);
             break;
 
         case MOTOR_MODE_TRAPEZOID:
-            // 梯形曲线模式: 初始化状态机
+            // 梯形曲线模式: 预先规划整条曲线, 总时间/总路程用于显示
+            {
+                SCurveLimits_T limits = {
+                    .v_start = pwm_config.trapezoid_start_rpm,
+                    .v_max = pwm_config.trapezoid_max_rpm,
+                    .v_end = pwm_config.trapezoid_start_rpm,
+                    .accel = pwm_config.trapezoid_accel_rate,
+                    .decel = pwm_config.trapezoid_decel_rate,
+                    .jerk = pwm_config.trapezoid_jerk,
+                };
+                Motor_Profile_Start(&limits, pwm_config.trapezoid_const_time_ms * 0.001f);
+            }
             motor_state.trapezoid_phase = TRAPEZOID_ACCEL;
-            motor_state.trapezoid_timer = 0;
             motor_state.trapezoid_current_rpm = pwm_config.trapezoid_start_rpm;
             break;
 
         case MOTOR_MODE_CIRCLE_CONTROL:
-            // 圈数控制模式: 记录编码器起始脉冲数
+            // 圈数控制模式: 记录编码器起始脉冲数并规划位置曲线
             motor_state.circle_state = CIRCLE_RUNNING;
-            motor_state.start_total_count = CIRCLE_CONTROL_ENCODER.total_count;
+            Motor_UpdateFeedback();
+            circle_marker_position = motor_feedback[CIRCLE_CONTROL_AXIS].position;
             motor_state.current_circles = 0.0f;
             motor_state.remain_circles = motor_state.target_circles;
+            motor_state.circle_final_error = 0;
+            Motor_Circle_Plan();
+            break;
+
+        case MOTOR_MODE_CALIBRATION:
+            // 标定模式: 关闭驱动层死区补偿, 否则测不到真实起转点
+            Motor_SetDeadBand(0);
+            calib_sweep_start(&calib_sweep, &calib_table,
+                              MOTOR_CALIB_PWM_START, MOTOR_CALIB_PWM_END, MOTOR_CALIB_PWM_STEP,
+                              CONTROL_OUTER_DT_S);
             break;
 
         default:
@@ -432,8 +643,15 @@ void MotorApp_Start(void)
             break;
     }
 
-    // 统一设置PWM(通过集中化函数)
-    Motor_SetPWM(Motor_GetCurrentModePWM());
+    // 统一输出设定值(通过集中化函数), 闭环时即发布速度目标
+    Motor_ApplySetpoint();
+
+    // 闭环模式: 目标已发布, 再清除速度环历史状态并启用 (标定始终开环, 圈数控制始终闭环)
+    if ((motor_state.control_mode == MOTOR_CTRL_CLOSED_LOOP &&
+         motor_state.mode != MOTOR_MODE_CALIBRATION) ||
+        motor_state.mode == MOTOR_MODE_CIRCLE_CONTROL) {
+        PID_Start();
+    }
 }
 
 /**
@@ -444,19 +662,65 @@ void MotorApp_Stop(void)
     if (!motor_state.is_running) return;
 
     motor_state.is_running = 0;
+    PID_Stop();
     Motor_SetPWM(0);
     motor_state.current_rpm = 0.0f;
 
     // 重置状态机
     if (motor_state.mode == MOTOR_MODE_TRAPEZOID) {
         motor_state.trapezoid_phase = TRAPEZOID_IDLE;
-        motor_state.trapezoid_timer = 0;
     }
-    if (motor_state.mode == MOTOR_MODE_CIRCLE_CONTROL) {
-        motor_state.circle_state = CIRCLE_IDLE;
+    if (motor_state.mode == MOTOR_MODE_CIRCLE_CONTROL &&
+        motor_state.circle_state != CIRCLE_FINISHED) {
+        motor_state.circle_state = CIRCLE_IDLE;  // 中途停止
+    }
+    if (motor_state.mode == MOTOR_MODE_CALIBRATION) {
+        // 中途停止视为标定失败 (启动扫描时已清除旧表)
+        if (calib_sweep.state == CALIB_SETTLING) {
+            calib_sweep.state = CALIB_FAILED;
+            calib_table.valid = 0;
+        }
+        // 恢复死区补偿: 已标定时使用实测的死区边缘
+        Motor_SetDeadBand(calib_table.valid ? calib_table.pwm[0] : MOTOR_DEAD_BAND_PWM);
     }
 }
 
+// ============================= 控制方式接口 =============================
+
+/**
+ * @brief 设置控制方式(开环/闭环)
+ * @param ctrl 控制方式
+ * @note 运行中切换: 闭环→开环立即改为查表PWM; 开环→闭环从零积分启动速度环
+ *       标定(开环扫描)和圈数控制(级联位置环)不受控制方式影响, 这两种模式下只记录, 切换到其他模式后生效
+ */
+void MotorApp_SetControlMode(MotorControlMode ctrl)
+{
+    if (ctrl == motor_state.control_mode) return;
+
+    motor_state.control_mode = ctrl;
+
+    if (!motor_state.is_running) return;
+    if (motor_state.mode == MOTOR_MODE_CALIBRATION ||
+        motor_state.mode == MOTOR_MODE_CIRCLE_CONTROL) return;
+
+    if (ctrl == MOTOR_CTRL_CLOSED_LOOP) {
+        Motor_ApplySetpoint();
+        PID_Start();
+    } else {
+        PID_Stop();
+        Motor_ApplySetpoint();
+    }
+}
+
+/**
+ * @brief 切换控制方式(开环 ↔ 闭环), 用于A/B对比
+ */
+void MotorApp_ToggleControlMode(void)
+{
+    MotorApp_SetControlMode(motor_state.control_mode == MOTOR_CTRL_CLOSED_LOOP ?
+                            MOTOR_CTRL_OPEN_LOOP : MOTOR_CTRL_CLOSED_LOOP);
+}
+
 // ============================= Basic Run 模式接口 =============================
 
 /**
@@ -467,9 +731,9 @@ void MotorApp_BasicRun_SetDirection(MotorDirection dir)
 {
     motor_state.direction = dir;
 
-    // 如果正在运行,立即更新PWM
+    // 如果正在运行,立即更新设定值
     if (motor_state.is_running && motor_state.mode == MOTOR_MODE_BASIC_RUN) {
-        Motor_SetPWM(Motor_GetCurrentModePWM());
+        Motor_ApplySetpoint();
     }
 }
 
@@ -481,13 +745,9 @@ void MotorApp_BasicRun_SetSpeed(float speed_rpm)
 {
     motor_state.basic_speed = speed_rpm;
 
-    // 如果正在运行,立即更新PID目标
+    // 如果正在运行,立即更新设定值
     if (motor_state.is_running && motor_state.mode == MOTOR_MODE_BASIC_RUN) {
-        float target = speed_rpm;
-        if (motor_state.direction == MOTOR_DIR_REVERSE) {
-            target = -target;
-        }
-        Motor_UpdatePIDTarget(target);
+        Motor_ApplySetpoint();
     }
 }
 
@@ -504,9 +764,9 @@ void MotorApp_SpeedGear_SetGear(SpeedGear gear)
     motor_state.current_gear = gear;
     motor_state.target_rpm = gear_speeds[gear];
 
-    // 如果正在运行,立即更新PWM
+    // 如果正在运行,立即更新设定值
     if (motor_state.is_running && motor_state.mode == MOTOR_MODE_SPEED_GEAR) {
-        Motor_SetPWM(Motor_GetCurrentModePWM());
+        Motor_ApplySetpoint();
     }
 }
 
@@ -539,6 +799,11 @@ void MotorApp_SpeedGear_DecreaseGear(void)
 void MotorApp_Acceleration_SetMode(AccelMode mode)
 {
     motor_state.accel_mode = mode;
+
+    // 运行中切换: 从当前转速按新加速度重新规划
+    if (motor_state.is_running && motor_state.mode == MOTOR_MODE_ACCELERATION) {
+        Motor_Acceleration_Plan(motor_state.accel_target_rpm);
+    }
 }
 
 /**
@@ -546,43 +811,84 @@ void MotorApp_Acceleration_SetMode(AccelMode mode)
  */
 void MotorApp_Acceleration_ToggleMode(void)
 {
-    motor_state.accel_mode = (motor_state.accel_mode == ACCEL_MODE_LOW) ?
-                              ACCEL_MODE_HIGH : ACCEL_MODE_LOW;
+    MotorApp_Acceleration_SetMode((motor_state.accel_mode == ACCEL_MODE_LOW) ?
+                                  ACCEL_MODE_HIGH : ACCEL_MODE_LOW);
 }
 
 // ============================= Circle Control 模式接口 =============================
 
 /**
  * @brief 设置目标圈数
- * @param circles 目标圈数(1-20)
+ * @param circles 目标圈数(0.25-500, 可为小数)
  */
-void MotorApp_CircleControl_SetTarget(uint8_t circles)
+void MotorApp_CircleControl_SetTarget(float circles)
 {
-    // 限制范围 1-20
-    if (circles < 1) circles = 1;
-    if (circles > 20) circles = 20;
+    if (circles < CIRCLE_TARGET_MIN) circles = CIRCLE_TARGET_MIN;
+    if (circles > CIRCLE_TARGET_MAX) circles = CIRCLE_TARGET_MAX;
 
     motor_state.target_circles = circles;
 }
 
 /**
- * @brief 增加目标圈数(+1圈,最大20)
+ * @brief 目标圈数调节步长
+ * @note 2圈以下0.25圈, 20圈以下1圈, 以上10圈
+ */
+static float Motor_Circle_Step(float circles, uint8_t up)
+{
+    float edge = up ? circles : circles - 0.001f;  // 减少时按下一档区间取步长
+
+    if (edge < 2.0f) return 0.25f;
+    if (edge < 20.0f) return 1.0f;
+    return 10.0f;
+}
+
+/**
+ * @brief 增加目标圈数
  */
 void MotorApp_CircleControl_IncreaseTarget(void)
 {
-    if (motor_state.target_circles < 20) {
-        motor_state.target_circles++;
-    }
+    float circles = motor_state.target_circles;
+    MotorApp_CircleControl_SetTarget(circles + Motor_Circle_Step(circles, 1));
 }
 
 /**
- * @brief 减少目标圈数(-1圈,最小1)
+ * @brief 减少目标圈数
  */
 void MotorApp_CircleControl_DecreaseTarget(void)
 {
-    if (motor_state.target_circles > 1) {
-        motor_state.target_circles--;
-    }
+    float circles = motor_state.target_circles;
+    MotorApp_CircleControl_SetTarget(circles - Motor_Circle_Step(circles, 0));
+}
+
+// ============================= 标定接口 =============================
+
+/**
+ * @brief 启动PWM→转速自动标定
+ * @note 切换到标定模式并启动扫描, 完成后自动停机,
+ *       之后开环换算与闭环前馈都改用标定表
+ */
+void MotorApp_Calibration_Start(void)
+{
+    MotorApp_SetMode(MOTOR_MODE_CALIBRATION);
+    MotorApp_Start();
+}
+
+/**
+ * @brief 获取标定表
+ * @return 标定表指针 (valid=0 表示未标定)
+ */
+const CalibTable_T* MotorApp_Calibration_GetTable(void)
+{
+    return &calib_table;
+}
+
+/**
+ * @brief 获取标定扫描状态
+ * @return 扫描状态
+ */
+CalibState MotorApp_Calibration_GetState(void)
+{
+    return calib_sweep.state;
 }
 
 // ============================= 状态查询接口 =============================
@@ -590,12 +896,35 @@ void MotorApp_CircleControl_DecreaseTarget(void)
 /**
  * @brief 获取电机状态指针
  * @return 电机状态结构体指针
+ * @note motor_state 只在优先级0的任务中修改 (Motor_Task、按键/UI、参数加载), 中断不访问;
+ *       只有优先级0的任务可以通过这个指针读写 (同级不抢占, 读到的是一致的数据),
+ *       其他优先级的任务用 MotorApp_ReadState 读取副本
  */
 MotorState* MotorApp_GetState(void)
 {
     return &motor_state;
 }
 
+/**
+ * @brief 读取电机状态的一致副本 (任意优先级的任务可调用)
+ * @param out 副本
+ * @return 副本指针 (即 out)
+ * @note 复制期间挡住优先级0的任务, 不会读到写入者改了一半的状态
+ */
+const MotorState* MotorApp_ReadState(MotorState *out)
+{
+#if SCHEDULER_PREEMPTIVE
+    uint8_t kernel_prev = kernel_lock(0);
+#endif
+
+    *out = motor_state;
+
+#if SCHEDULER_PREEMPTIVE
+    kernel_unlock(kernel_prev);
+#endif
+    return out;
+}
+
 /**
  * @brief 获取当前平均转速
  * @return 当前转速(rpm)
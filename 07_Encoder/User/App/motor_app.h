@@ -2,15 +2,8 @@
 #define __MOTOR_APP_H__
 
 #include "MyDefine.h"
-
-// ============================= 配置选项 =============================
-
-/**
- * @brief 电机数量配置
- * @note 1 = 仅右电机 (当前模式)
- *       2 = 双电机 (切换到此项即可启用左电机)
- */
-#define MOTOR_COUNT 1
+#include "motor_calib.h"
+#include "scurve.h"
 
 // ============================= 运动模式定义 =============================
 
@@ -23,9 +16,18 @@ typedef enum {
     MOTOR_MODE_SPEED_GEAR,         // 三档转速模式
     MOTOR_MODE_ACCELERATION,       // 加速度测试模式
     MOTOR_MODE_TRAPEZOID,          // 梯形曲线模式
-    MOTOR_MODE_CIRCLE_CONTROL      // 精准圈数控制模式
+    MOTOR_MODE_CIRCLE_CONTROL,     // 精准圈数控制模式
+    MOTOR_MODE_CALIBRATION         // PWM→转速自动标定
 } MotorMode;
 
+/**
+ * @brief 控制方式
+ */
+typedef enum {
+    MOTOR_CTRL_OPEN_LOOP = 0,      // 开环: 查表/线性换算直接输出PWM
+    MOTOR_CTRL_CLOSED_LOOP = 1     // 闭环: 速度环 + 线性前馈
+} MotorControlMode;
+
 /**
  * @brief 电机方向
  */
@@ -67,10 +69,55 @@ typedef enum {
  */
 typedef enum {
     CIRCLE_IDLE = 0,               // 空闲状态
-    CIRCLE_RUNNING,                // 运行中
+    CIRCLE_RUNNING,                // 按位置曲线运行中
+    CIRCLE_SETTLING,               // 曲线结束, 位置环收敛到目标
     CIRCLE_FINISHED                // 完成
 } CircleState;
 
+/**
+ * @brief 圈数控制目标范围
+ */
+#define CIRCLE_TARGET_MIN   0.25f  // 最小目标(圈)
+#define CIRCLE_TARGET_MAX   500.0f // 最大目标(圈)
+
+// ============================= PWM配置表 =============================
+
+/**
+ * @brief PWM配置表 - 所有参数集中管理
+ */
+typedef struct {
+    // 基本运行模式
+    int basic_run_pwm;           // 正转PWM值
+    int basic_run_reverse_pwm;   // 反转PWM值
+
+    // 三档变速模式
+    int gear_low_pwm;            // 低速档 (30rpm)
+    int gear_mid_pwm;            // 中速档 (50rpm)
+    int gear_high_pwm;           // 高速档 (80rpm)
+
+    // 加速度测试模式
+    float accel_start_rpm;       // 起始转速
+    float accel_max_rpm;         // 最大转速
+    float accel_rate_low;        // 低加速度 (rpm/s)
+    float accel_rate_high;       // 高加速度 (rpm/s)
+    float accel_jerk;            // 加加速度 (rpm/s², 0=不限制)
+
+    // 梯形曲线模式
+    float trapezoid_start_rpm;   // 起始转速
+    float trapezoid_max_rpm;     // 最大转速
+    float trapezoid_accel_rate;  // 加速度 (rpm/s)
+    float trapezoid_decel_rate;  // 减速度 (rpm/s)
+    float trapezoid_jerk;        // 加加速度 (rpm/s², 0=梯形)
+    uint16_t trapezoid_const_time_ms;  // 恒速时间(ms)
+
+    // 圈数控制模式
+    float circle_control_rpm;    // 最大转速 (rpm)
+    float circle_accel_rate;     // 加/减速度 (rpm/s)
+    float circle_jerk;           // 加加速度 (rpm/s²)
+    float circle_pos_kp;         // 位置环比例系数 (1/s, 速度修正 = kp × 位置误差)
+    uint8_t circle_brake_hold;   // 到位后刹车保持: 0=滑行, 1=刹车
+} MotorPWMConfig;
+
 // ============================= 电机状态结构体 =============================
 
 /**
@@ -79,6 +126,7 @@ typedef enum {
 typedef struct {
     MotorMode mode;                // 当前运动模式
     uint8_t is_running;            // 运行状态: 0=停止, 1=运行
+    MotorControlMode control_mode; // 控制方式(开环/闭环)
 
     // Basic Run 模式参数
     MotorDirection direction;      // 运动方向
@@ -94,26 +142,32 @@ typedef struct {
 
     // Trapezoid 模式参数
     TrapezoidPhase trapezoid_phase;  // 当前运动阶段
-    uint32_t trapezoid_timer;        // 阶段计时器(单位:10ms)
     float trapezoid_current_rpm;     // 当前目标转速
 
+    // 速度曲线 (Acceleration / Trapezoid 共用S曲线发生器)
+    uint32_t profile_ticks;          // 已运行外环周期数
+    float profile_time;              // 已运行时间(s), 由 profile_ticks 换算
+    float profile_total_time;        // 曲线总时间(s), 用于显示预计完成时间
+    float profile_distance;          // 曲线总路程(圈)
+
     // Circle Control 模式参数
     CircleState circle_state;        // 运行状态
-    uint8_t target_circles;          // 目标圈数(1-20)
-    int32_t start_total_count;       // 启动时编码器累计值
+    float target_circles;            // 目标圈数(0.25-500, 可为小数)
     float current_circles;           // 当前已转圈数(用于显示)
     float remain_circles;            // 剩余圈数(用于显示)
+    int64_t circle_target_pulses;    // 目标脉冲数
+    int32_t circle_final_error;      // 到位后的最终误差(脉冲, 目标-实际)
+    uint16_t circle_settle_timer;    // 收敛阶段计时(单位:外环周期)
 
     // 实时反馈数据
-    float current_rpm;             // 当前转速(rpm)
-#if MOTOR_COUNT == 2
-    float left_rpm;                // 左轮转速(原始值)
-#endif
-    float right_rpm;               // 右轮转速(原始值)
+    float current_rpm;             // 当前转速(rpm, 各轴平均)
 } MotorState;
 
 // ============================= 外部接口函数 =============================
 
+extern MotorPWMConfig pwm_config;  // PWM配置表(可由参数存储覆盖)
+extern CalibTable_T calib_table;   // PWM→转速标定表
+
 void Motor_Init(void);
 void Motor_Task(void);
 
@@ -122,6 +176,10 @@ void MotorApp_SetMode(MotorMode mode);
 void MotorApp_Start(void);
 void MotorApp_Stop(void);
 
+// 控制方式接口
+void MotorApp_SetControlMode(MotorControlMode ctrl);
+void MotorApp_ToggleControlMode(void);
+
 // Basic Run 模式接口
 void MotorApp_BasicRun_SetDirection(MotorDirection dir);
 void MotorApp_BasicRun_SetSpeed(float speed_rpm);
@@ -136,12 +194,18 @@ void MotorApp_Acceleration_SetMode(AccelMode mode);
 void MotorApp_Acceleration_ToggleMode(void);
 
 // Circle Control 模式接口
-void MotorApp_CircleControl_SetTarget(uint8_t circles);
+void MotorApp_CircleControl_SetTarget(float circles);
 void MotorApp_CircleControl_IncreaseTarget(void);
 void MotorApp_CircleControl_DecreaseTarget(void);
 
+// 标定接口
+void MotorApp_Calibration_Start(void);
+const CalibTable_T* MotorApp_Calibration_GetTable(void);
+CalibState MotorApp_Calibration_GetState(void);
+
 // 状态查询接口
-MotorState* MotorApp_GetState(void);
+MotorState* MotorApp_GetState(void);              // 仅限优先级0的任务
+const MotorState* MotorApp_ReadState(MotorState *out);  // 一致副本, 任意优先级
 float MotorApp_GetCurrentRPM(void);
 uint8_t MotorApp_IsRunning(void);
 
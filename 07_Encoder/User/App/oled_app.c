@@ -1,5 +1,7 @@
 #include "oled_app.h"
 #include "ui_menu_app.h"  // 引入UI菜单系统
+#include "axis_app.h"
+#include "telem_app.h"
 
 void Oled_Init(void)
 {
@@ -10,12 +12,6 @@ void Oled_Init(void)
     UI_Menu_Init();
 }
 
-extern MOTOR left_motor;
-extern MOTOR right_motor;
-
-extern Encoder left_encoder;
-extern Encoder right_encoder;
-
 void Oled_Task(void)
 {
     // ============================= LVGL模式 - 原UI菜单已禁用 =============================
@@ -27,12 +23,25 @@ void Oled_Task(void)
     // ============================= 调试输出(保留) =============================
 
     // 通过串口输出编码器数据(用于调试)
+    // 二进制遥测输出期间不打印 (遥测已包含这些数据)
     static uint16_t uart_counter = 0;
-    if (++uart_counter >= 10) {  // 每100ms输出一次(10ms*10)
+    if (++uart_counter >= 10 && !Telem_IsStreaming()) {  // 每100ms输出一次(10ms*10)
+        // 整行先拼好再一次放入发送队列, 更高优先级任务 (如 Perf_Task) 的输出不会插进行中间
+        char line[16 + AXIS_COUNT * 48];
+        int len = 0;
+
         uart_counter = 0;
-        Uart_Printf(DEBUG_UART, "L:%.2frpm %.2fcm/s, R:%.2frpm %.2fcm/s\r\n",
-                    left_encoder.rpm, left_encoder.speed_cm_s,
-                    right_encoder.rpm, right_encoder.speed_cm_s);
+        for (uint8_t i = 0; i < AXIS_COUNT && len < (int)sizeof(line); i++) {
+            EncoderFeedback_t feedback;
+            Encoder_GetFeedback(i, &feedback);
+            len += snprintf(line + len, sizeof(line) - len, "%s:%.2frpm %.2fcm/s%s", axis_config[i].name,
+                            feedback.rpm_raw, feedback.speed_cm_s,
+                            (i + 1 < AXIS_COUNT) ? ", " : "");
+        }
+        if (AXIS_COUNT > 1 && len < (int)sizeof(line)) {
+            snprintf(line + len, sizeof(line) - len, ", Sync:%ld", (long)PID_GetSyncError());
+        }
+        Uart_Printf(DEBUG_UART, "%s\r\n", line);
     }
 
     // ============================= 旧版本显示代码(已注释,备用) =============================
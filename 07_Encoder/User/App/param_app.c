@@ -0,0 +1,160 @@
+#include "param_app.h"
+#include "axis_app.h"
+
+// ============================= 参数块 =============================
+
+#if AXIS_COUNT > PARAM_AXIS_SLOTS
+#error "PARAM_AXIS_SLOTS 小于 AXIS_COUNT"
+#endif
+
+/**
+ * @brief 持久化参数 (整体作为一条记录保存)
+ */
+typedef struct {
+    MotorPWMConfig motor;          // PWM配置表
+    PidParams_t pid[PARAM_AXIS_SLOTS]; // 各轴速度环参数 (下标同 axes[], 未用的槽位保留, 保证布局与轴布局无关)
+    float basic_speed;             // Basic Run 速度(rpm)
+    uint16_t encoder_ppr;          // 编码器每圈脉冲数
+    CalibTable_T calib;            // PWM→转速标定表
+} ParamBlock;
+
+// ============================= flash访问接口 =============================
+
+static int Param_ProgramWord(uint8_t bank, uint32_t offset, uint32_t data);
+static int Param_EraseBank(uint8_t bank);
+
+static const ParamFlashOps_T param_flash_ops = {
+    .bank_base = {(const uint8_t *)PARAM_BANK0_ADDR, (const uint8_t *)PARAM_BANK1_ADDR},
+    .bank_size = PARAM_BANK_SIZE,
+    .program_word = Param_ProgramWord,
+    .erase_bank = Param_EraseBank,
+};
+
+static const uint32_t param_bank_addr[2] = {PARAM_BANK0_ADDR, PARAM_BANK1_ADDR};
+static const uint32_t param_bank_sector[2] = {PARAM_BANK0_SECTOR, PARAM_BANK1_SECTOR};
+
+// ============================= 存储状态 =============================
+static ParamStore_T param_store;
+static ParamBlock param_block;             // 读写缓冲
+static uint8_t param_save_pending = 0;     // 有待保存的请求
+static ParamResult param_last_result = PARAM_EMPTY;
+
+// ============================= 内部辅助函数 =============================
+
+static int Param_ProgramWord(uint8_t bank, uint32_t offset, uint32_t data)
+{
+    return Flash_Driver_ProgramWord(param_bank_addr[bank] + offset, data);
+}
+
+static int Param_EraseBank(uint8_t bank)
+{
+    return Flash_Driver_EraseSector(param_bank_sector[bank]);
+}
+
+/**
+ * @brief 从各模块收集当前参数
+ */
+static void Param_Collect(ParamBlock *block)
+{
+    memset(block, 0, sizeof(ParamBlock));
+    block->motor = pwm_config;
+    for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+        block->pid[i] = pid_params[i];
+    }
+    block->basic_speed = MotorApp_GetState()->basic_speed;
+    block->encoder_ppr = encoder_ppr;
+    block->calib = calib_table;
+}
+
+/**
+ * @brief 把参数写回各模块
+ * @note 只在各模块 Init 之前调用, 由 Motor_Init / PID_Init / Encoder_Init 使用
+ */
+static void Param_Apply(const ParamBlock *block)
+{
+    pwm_config = block->motor;
+    for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+        pid_params[i] = block->pid[i];
+    }
+    MotorApp_GetState()->basic_speed = block->basic_speed;
+    if (block->encoder_ppr != 0) {
+        encoder_ppr = block->encoder_ppr;
+    }
+    calib_table = block->calib;
+}
+
+// ============================= 外部接口函数 =============================
+
+/**
+ * @brief 加载持久化参数
+ * @note 必须在 Motor_Init / PID_Init / Encoder_Init 之前调用;
+ *       没有记录或记录版本比固件新时保持编译期默认值
+ */
+void Param_Init(void)
+{
+    uint16_t version = 0;
+    uint16_t length = 0;
+
+    param_store_init(&param_store, &param_flash_ops);
+
+    // 先填入默认值, 旧版本记录只覆盖其长度内的字段
+    Param_Collect(&param_block);
+    param_last_result = param_store_load(&param_store, &param_block, sizeof(ParamBlock), &version, &length);
+
+    if (param_last_result == PARAM_OK &&
+        version >= PARAM_VERSION_COMPAT && version <= PARAM_VERSION) {
+        Param_Apply(&param_block);
+        LOG_I("Param: loaded v%d (%d bytes, bank %d, %d records)",
+              version, length, param_store.active, param_store.record_count);
+    } else {
+        LOG_I("Param: defaults");
+    }
+}
+
+/**
+ * @brief 请求保存当前参数
+ * @note 只置标志, 实际写入在 Param_Task 中完成, 可在任意前台上下文调用
+ */
+void Param_RequestSave(void)
+{
+    param_save_pending = 1;
+}
+
+/**
+ * @brief 参数存储任务(每100ms调用一次)
+ * @note 1. 追加记录只有字编程, 电机运行时也可执行
+ *       2. 当前bank写满需要擦除备用bank时, 等电机停止后再擦除,
+ *          擦除期间取指阻塞, 不能与10ms控制中断同时进行
+ */
+void Param_Task(void)
+{
+    if (!param_save_pending) return;
+
+    Param_Collect(&param_block);
+    param_last_result = param_store_save(&param_store, &param_block, sizeof(ParamBlock), PARAM_VERSION);
+
+    if (param_last_result == PARAM_BUSY) {
+        if (MotorApp_IsRunning()) return;  // 等待空闲
+
+        if (param_store_maintain(&param_store) == PARAM_OK) {
+            param_last_result = param_store_save(&param_store, &param_block, sizeof(ParamBlock), PARAM_VERSION);
+        } else {
+            param_last_result = PARAM_ERROR;
+        }
+    }
+
+    param_save_pending = 0;
+    if (param_last_result == PARAM_OK) {
+        LOG_I("Param: save ok");
+    } else {
+        LOG_E("Param: save failed");
+    }
+}
+
+/**
+ * @brief 获取最近一次加载/保存的结果
+ */
+ParamResult Param_GetLastResult(void)
+{
+    return param_last_result;
+}
@@ -0,0 +1,36 @@
+#ifndef __PARAM_APP_H__
+#define __PARAM_APP_H__
+
+#include "MyDefine.h"
+#include "param_store.h"
+
+// ============================= 存储区配置 =============================
+
+/**
+ * @brief 参数存储使用的flash扇区 (F407VET6 共512KB, 最后两个128KB扇区 6/7 轮换)
+ * @note 链接器的IROM1已限制为 0x08000000~0x0803FFFF (Sector 0~5), 程序不会占用这两个扇区
+ */
+#define PARAM_BANK0_ADDR     0x08040000u   // Sector 6
+#define PARAM_BANK1_ADDR     0x08060000u   // Sector 7
+#define PARAM_BANK0_SECTOR   FLASH_SECTOR_6
+#define PARAM_BANK1_SECTOR   FLASH_SECTOR_7
+#define PARAM_BANK_SIZE      0x20000u      // 128KB
+
+/**
+ * @brief 参数版本
+ * @note 新增字段只允许追加在 ParamBlock 末尾并递增版本号;
+ *       读取旧版本记录时只覆盖其长度内的字段, 其余保持默认值
+ *       布局不兼容的修改(如 MotorPWMConfig 增删字段)需同时把 PARAM_VERSION_COMPAT 提到新版本
+ */
+#define PARAM_VERSION        5
+#define PARAM_VERSION_COMPAT 5   // 低于此版本的记录布局不兼容, 忽略 (v2: S曲线参数, v3: 圈数位置环参数, v4: 按轴存储PID, v5: PID改为连续时间增益)
+
+// 速度环参数槽位数 (不小于 AXIS_COUNT)
+#define PARAM_AXIS_SLOTS     4
+
+void Param_Init(void);
+void Param_Task(void);
+void Param_RequestSave(void);
+ParamResult Param_GetLastResult(void);
+
+#endif
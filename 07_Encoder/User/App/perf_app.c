@@ -0,0 +1,174 @@
+#include "perf_app.h"
+#include "perf.h"
+
+#if PERF_ENABLE
+
+static PerfSlot_T perf_isr[PERF_ISR_COUNT];
+static PerfSlot_T perf_task[PERF_TASK_MAX];
+
+static const char *const perf_isr_name[PERF_ISR_COUNT] = {
+    "TIM2", "EXTI", "UART_RX", "UART_TX",
+};
+
+// 报告进度: 每次 Perf_Task 输出一行, 避免一次写满串口发送缓冲区
+static int16_t perf_report_line = -1;
+
+/**
+ * @brief 各中断和各任务累计执行时间之和 (32位回绕)
+ * @note 每个槽的 net_total 只由对应中断/任务写入, 单次读取不会撕裂;
+ *       抢占式调度时任务也会被更高优先级任务打断, 一并扣除
+ */
+static uint32_t Perf_NestedTotal(void)
+{
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < PERF_ISR_COUNT; i++) {
+        total += perf_isr[i].net_total;
+    }
+    for (uint8_t i = 0; i < PERF_TASK_MAX; i++) {
+        total += perf_task[i].net_total;
+    }
+    return total;
+}
+
+/**
+ * @brief 初始化: 启用DWT周期计数器
+ */
+void Perf_Init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    for (uint8_t i = 0; i < PERF_ISR_COUNT; i++) {
+        perf_slot_init(&perf_isr[i]);
+    }
+    for (uint8_t i = 0; i < PERF_TASK_MAX; i++) {
+        perf_slot_init(&perf_task[i]);
+    }
+}
+
+/**
+ * @brief 测量起点
+ * @note 先读时刻再读中断累计: 两次读取之间发生的中断只会多算, 不会算成负数
+ */
+void Perf_Begin(PerfMark_t *mark)
+{
+    mark->start = DWT->CYCCNT;
+    mark->nested_start = Perf_NestedTotal();
+}
+
+/**
+ * @brief 测量期间本身的执行时间 (扣除嵌套的中断和抢占的任务)
+ */
+static uint32_t Perf_Elapsed(const PerfMark_t *mark)
+{
+    uint32_t nested = Perf_NestedTotal() - mark->nested_start;
+    uint32_t elapsed = DWT->CYCCNT - mark->start;
+    return elapsed > nested ? elapsed - nested : 0;
+}
+
+/**
+ * @brief 中断回调测量终点
+ */
+void Perf_EndIsr(PerfMark_t *mark, PerfIsrId id)
+{
+    perf_slot_record(&perf_isr[id], Perf_Elapsed(mark));
+}
+
+/**
+ * @brief 调度任务测量终点
+ * @param index 任务在 scheduler_task[] 中的下标
+ */
+void Perf_EndTask(PerfMark_t *mark, uint8_t index)
+{
+    if (index < PERF_TASK_MAX) {
+        perf_slot_record(&perf_task[index], Perf_Elapsed(mark));
+    }
+}
+
+/**
+ * @brief 输出一个统计槽
+ */
+static void Perf_PrintSlot(const char *ctx, const char *name, const PerfSlot_T *slot)
+{
+    PerfSlot_T s;
+    char hist[PERF_HIST_BINS * 11];
+    int len = 0;
+
+    perf_slot_read(slot, &s);
+    for (uint8_t i = 0; i < PERF_HIST_BINS; i++) {
+        len += snprintf(hist + len, sizeof(hist) - len, i ? ",%lu" : "%lu", (unsigned long)s.hist[i]);
+    }
+
+    Uart_Printf(DEBUG_UART, "#PERF %s %s n=%lu min=%lu max=%lu mean=%lu hist=%s\r\n", ctx, name,
+                (unsigned long)s.count, (unsigned long)(s.count ? s.min : 0), (unsigned long)s.max,
+                (unsigned long)(s.count ? s.sum / s.count : 0), hist);
+}
+
+/**
+ * @brief 开始输出报告 (由 Perf_Task 逐行发送)
+ */
+void Perf_Report(void)
+{
+    if (perf_report_line < 0) {
+        perf_report_line = 0;
+    }
+}
+
+/**
+ * @brief 清零所有统计 (由各写端在下次记录时执行)
+ */
+void Perf_Reset(void)
+{
+    for (uint8_t i = 0; i < PERF_ISR_COUNT; i++) {
+        perf_slot_request_reset(&perf_isr[i]);
+    }
+    for (uint8_t i = 0; i < PERF_TASK_MAX; i++) {
+        perf_slot_request_reset(&perf_task[i]);
+    }
+}
+
+/**
+ * @brief 报告任务: 每次输出一行
+ * @note 格式: "#PERF BEGIN hz=<CPU频率> shift=<直方图起始位> bins=<格数>",
+ *       每个中断/任务一行 "#PERF isr|task <名称> n= min= max= mean= hist=..." (单位: 周期),
+ *       最后 "#PERF END"; 由 Tools/perf_report.cpp 解析
+ */
+void Perf_Task(void)
+{
+#if PERF_REPORT_PERIOD_MS > 0
+    static uint32_t last_report = 0;
+    if (perf_report_line < 0 && HAL_GetTick() - last_report >= PERF_REPORT_PERIOD_MS) {
+        last_report = HAL_GetTick();
+        Perf_Report();
+    }
+#endif
+
+    if (perf_report_line < 0) return;
+
+    uint8_t task_count;
+    const SchedTask_T *tasks = Scheduler_GetTasks(&task_count);
+    if (task_count > PERF_TASK_MAX) task_count = PERF_TASK_MAX;
+
+    int16_t line = perf_report_line++;
+    if (line == 0) {
+        Uart_Printf(DEBUG_UART, "#PERF BEGIN hz=%lu shift=%d bins=%d\r\n",
+                    (unsigned long)SystemCoreClock, PERF_HIST_SHIFT, PERF_HIST_BINS);
+    } else if (line <= PERF_ISR_COUNT) {
+        Perf_PrintSlot("isr", perf_isr_name[line - 1], &perf_isr[line - 1]);
+    } else if (line <= PERF_ISR_COUNT + task_count) {
+        uint8_t index = line - 1 - PERF_ISR_COUNT;
+        Perf_PrintSlot("task", tasks[index].name, &perf_task[index]);
+    } else {
+        Uart_Printf(DEBUG_UART, "#PERF END\r\n");
+        perf_report_line = -1;
+    }
+}
+
+#else
+
+void Perf_Init(void) {}
+void Perf_Task(void) {}
+void Perf_Report(void) {}
+void Perf_Reset(void) {}
+
+#endif
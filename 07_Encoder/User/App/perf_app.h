@@ -0,0 +1,59 @@
+#ifndef __PERF_APP_H__
+#define __PERF_APP_H__
+
+#include "MyDefine.h"
+
+/**
+ * @brief 执行时间统计开关
+ * @note 1 = 用DWT周期计数器统计各调度任务和各中断回调的执行时间 (最短/最长/平均/直方图)
+ *       0 = 所有统计代码编译为空
+ */
+#define PERF_ENABLE 1
+
+// 周期报告间隔(ms), 0 = 只在串口收到 "perf" 时报告
+#define PERF_REPORT_PERIOD_MS 0
+
+// 调度任务统计槽数量 (不少于 scheduler_task[] 的任务数)
+#define PERF_TASK_MAX 12
+
+/**
+ * @brief 被统计的中断回调
+ */
+typedef enum {
+    PERF_ISR_CONTROL = 0,   // TIM2 控制内环
+    PERF_ISR_ENCODER_EDGE,  // EXTI 编码器边沿
+    PERF_ISR_UART_RX,       // 串口接收空闲/完成
+    PERF_ISR_UART_TX,       // 串口发送完成
+    PERF_ISR_COUNT
+} PerfIsrId;
+
+/**
+ * @brief 一次测量的起点
+ * @note 记录起点时刻和当时各中断/任务的累计时间, 结束时扣除期间嵌套进来的中断和抢占的任务
+ */
+typedef struct {
+    uint32_t start;
+    uint32_t nested_start;
+} PerfMark_t;
+
+#if PERF_ENABLE
+#define PERF_MARK(mark)             PerfMark_t mark
+#define PERF_BEGIN(mark)            Perf_Begin(&(mark))
+#define PERF_END_ISR(mark, id)      Perf_EndIsr(&(mark), (id))
+#define PERF_END_TASK(mark, index)  Perf_EndTask(&(mark), (index))
+#else
+#define PERF_MARK(mark)
+#define PERF_BEGIN(mark)            ((void)0)
+#define PERF_END_ISR(mark, id)      ((void)0)
+#define PERF_END_TASK(mark, index)  ((void)0)
+#endif
+
+void Perf_Init(void);
+void Perf_Task(void);
+void Perf_Begin(PerfMark_t *mark);
+void Perf_EndIsr(PerfMark_t *mark, PerfIsrId id);
+void Perf_EndTask(PerfMark_t *mark, uint8_t index);
+void Perf_Report(void);
+void Perf_Reset(void);
+
+#endif
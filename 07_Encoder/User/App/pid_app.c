@@ -1,66 +1,329 @@
 #include "pid_app.h"
-
-#if MOTOR_COUNT == 2
-extern Encoder left_encoder;
-#endif
-extern Encoder right_encoder;
-
-#if MOTOR_COUNT == 2
-extern MOTOR left_motor;
-#endif
-extern MOTOR right_motor;
+#include "axis_app.h"
+#include "pid_q.h"
+#include "pid_batch.h"
+#include "handoff.h"
 
 int basic_speed = 40;
 
-/* PID控制器 */
-PID_T pid_speed_left;
-PID_T pid_speed_right;
-
-#if MOTOR_COUNT == 2
-PidParams_t pid_params_left = {
-    .kp = 33.0f,
-    .ki = 4.5f,
+/* 速度环默认参数 */
+static const PidParams_t pid_params_default = {
+    .kp = 3.0f,   // 有线性前馈, 速度环只补偿剩余误差
+    .ki = 50.0f,  // 即原每10ms 0.5
     .kd = 0.0f,
     .out_min = -999.0f,
     .out_max = 999.0f,
 };
+
+/* 各轴速度环参数 */
+PidParams_t pid_params[AXIS_COUNT];
+
+/* 各轴速度环 (批量计算, 第i路对应第i轴) */
+static PIDBatch_T pid_batch;
+
+#if PID_FIXED_POINT
+/* 定点速度环 (输入: 脉冲/周期 Q16, 输出: PWM Q16) */
+static PIDQ_T pid_q[AXIS_COUNT];
+static int32_t pid_out_min_q[AXIS_COUNT];
+static int32_t pid_out_max_q[AXIS_COUNT];
+
+/**
+ * @brief 1 脉冲/周期 对应的转速(rpm)
+ */
+static float PID_RpmPerCount(uint8_t axis)
+{
+    return 60.0f / (axes[axis].encoder.ppr * SAMPLING_TIME_S);
+}
 #endif
 
-PidParams_t pid_params_right = {
-    .kp = 33.0f,
-    .ki = 4.5f,
-    .kd = 0.0f,
-    .out_min = -999.0f,
-    .out_max = 999.0f,
+/**
+ * @brief 装入默认速度环参数
+ * @note 在 Param_Init 之前调用, 之后可被参数存储覆盖
+ */
+void PID_LoadDefaults(void)
+{
+    for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+        pid_params[i] = pid_params_default;
+    }
+}
+
+/**
+ * @brief 速度环命令 (外环 → 内环)
+ * @note 前台修改 pid_command 后整组发布, 内环每个周期读取一次, 不会读到改了一半的命令
+ */
+typedef struct {
+    float target_rpm;           // 公共速度目标, 各轴在此基础上叠加同步修正
+    float feedforward;          // 前馈PWM (由 motor_app 根据线性拟合给出)
+#if PID_FIXED_POINT
+    int32_t target_q[AXIS_COUNT];  // 各轴目标 (脉冲/周期 Q16), 前台换算
+    int32_t feedforward_q;         // 前馈PWM (Q16)
+#endif
+    uint32_t start_seq;         // PID_Start 次数, 内环发现变化时清除历史状态
+    unsigned char running;      // 速度环使能
+    unsigned char sync_enable;  // 多轴同步开关 (单轴布局下无效)
+} PidCommand_t;
+
+static PidCommand_t pid_command = {
+    .sync_enable = 1,
 };
+static PidCommand_t pid_command_slot[2];
+static Handoff_T pid_command_handoff;
+
+/* 内环已处理的 start_seq */
+static uint32_t pid_start_seen = 0;
+
+/* 内环本周期是否执行了速度环 (只在内环读写) */
+static unsigned char pid_inner_running = 0;
+
+/* 同步误差跨度(脉冲), 内环写、前台读 (32位对齐, 单次读写不会撕裂) */
+static volatile int32_t pid_sync_spread = 0;
+
+/**
+ * @brief 发布速度环命令 (前台调用)
+ */
+static void PID_Publish(void)
+{
+    handoff_write(&pid_command_handoff, &pid_command);
+}
 
 void PID_Init(void)
 {
-#if MOTOR_COUNT == 2
-    pid_init(&pid_speed_left,
-             pid_params_left.kp, pid_params_left.ki, pid_params_left.kd,
-             0.0f, pid_params_left.out_max);
-    pid_set_target(&pid_speed_left, basic_speed);
+    pid_batch_init(&pid_batch, AXIS_COUNT, 999.0f);
+
+    for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+        const PidParams_t *params = &pid_params[i];
+
+        // 反算抗饱和, 跟踪时间常数取积分时间 kp/ki
+        pid_batch_set_gains(&pid_batch, i, params->kp, params->ki, params->kd, PID_SPEED_D_TAU,
+                            PID_SPEED_SP_WEIGHT, params->kp > 0.0f ? params->ki / params->kp : 0.0f,
+                            SAMPLING_TIME_S);
+        pid_batch.out_min[i] = params->out_min;
+        pid_batch.out_max[i] = params->out_max;
+
+#if PID_FIXED_POINT
+        pidq_init(&pid_q[i], params->kp, params->ki, params->kd, PID_SPEED_D_TAU, PID_SPEED_SP_WEIGHT,
+                  params->kp > 0.0f ? params->ki / params->kp : 0.0f, SAMPLING_TIME_S, PID_RpmPerCount(i));
+        pid_out_min_q[i] = PIDQ_FROM_FLOAT(params->out_min);
+        pid_out_max_q[i] = PIDQ_FROM_FLOAT(params->out_max);
+#endif
+    }
+
+    handoff_init(&pid_command_handoff, &pid_command_slot[0], &pid_command_slot[1], sizeof(PidCommand_t));
+    PID_Publish();
+}
+
+/**
+ * @brief 设置单轴速度目标 (内环, 带同步修正)
+ * @note 定点模式的rpm换算只在多轴同步时进入内环
+ */
+static void PID_Axis_SetTarget(uint8_t axis, float target_rpm)
+{
+    pid_batch.target[axis] = target_rpm;
+#if PID_FIXED_POINT
+    pidq_set_target(&pid_q[axis], PIDQ_FROM_FLOAT(target_rpm / PID_RpmPerCount(axis)));
+#endif
+}
+
+/**
+ * @brief 清除各轴速度环历史状态并记录同步起点 (内环)
+ * @note 由内环在发现新的 PID_Start 后执行, 与 PID_Task 不会并发
+ */
+static void PID_Reset(void)
+{
+    pid_batch_reset(&pid_batch);
+    for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+#if PID_FIXED_POINT
+        pidq_reset(&pid_q[i]);
+#endif
+        axes[i].sync_base = axes[i].encoder.position;
+        axes[i].sync_error = 0.0f;
+    }
+    pid_sync_spread = 0;
+}
+
+/**
+ * @brief 更新各轴同步误差并修正速度目标
+ * @param cmd 本周期的速度环命令
+ * @note 误差 = 该轴位置 - 各轴平均位置, 双轴时即左右位置差的一半
+ */
+static void PID_Sync_Update(const PidCommand_t *cmd)
+{
+    int64_t sum = 0;
+    for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+        sum += axes[i].encoder.position - axes[i].sync_base;
+    }
+
+    for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+        Axis *axis = &axes[i];
+
+        // 先做整数运算, 长时间运行后仍保持精度
+        int64_t scaled = (axis->encoder.position - axis->sync_base) * AXIS_COUNT - sum;
+        axis->sync_error = (float)scaled / AXIS_COUNT;
+
+        float correction = -PID_SYNC_KP * axis->sync_error;
+        if (correction > PID_SYNC_LIMIT_RPM) correction = PID_SYNC_LIMIT_RPM;
+        if (correction < -PID_SYNC_LIMIT_RPM) correction = -PID_SYNC_LIMIT_RPM;
+
+        PID_Axis_SetTarget(i, cmd->target_rpm + (cmd->sync_enable ? correction : 0.0f));
+    }
+
+    // 跨度: 最超前与最落后两轴的位置差
+    float max_err = axes[0].sync_error;
+    float min_err = axes[0].sync_error;
+    for (uint8_t i = 1; i < AXIS_COUNT; i++) {
+        if (axes[i].sync_error > max_err) max_err = axes[i].sync_error;
+        if (axes[i].sync_error < min_err) min_err = axes[i].sync_error;
+    }
+    pid_sync_spread = (int32_t)(max_err - min_err);
+}
+
+/**
+ * @brief 启用速度环 (前台调用)
+ * @note 内环在下一周期清除历史积分, 避免上次运行的残留积分造成冲击
+ *       应先用 PID_SetSpeedTarget 设好目标再启用, 内环第一个周期即使用新目标
+ */
+void PID_Start(void)
+{
+    pid_command.start_seq++;
+    pid_command.running = 1;
+    PID_Publish();
+}
+
+/**
+ * @brief 停用速度环 (前台调用)
+ * @note 发布后内环不再输出PWM, 随后前台可直接设置PWM
+ */
+void PID_Stop(void)
+{
+    pid_command.running = 0;
+    pid_command.feedforward = 0.0f;
+#if PID_FIXED_POINT
+    pid_command.feedforward_q = 0;
+#endif
+    PID_Publish();
+}
+
+/**
+ * @brief 设置速度环目标 (前台调用, 外环每个周期一次)
+ * @param target_rpm 目标转速(rpm)
+ * @param feedforward_pwm 前馈PWM, 速度环只需补偿剩余误差
+ * @note 定点模式在这里把rpm换算为 脉冲/周期(Q16), 不进入控制热路径
+ */
+void PID_SetSpeedTarget(float target_rpm, float feedforward_pwm)
+{
+    pid_command.target_rpm = target_rpm;
+    pid_command.feedforward = feedforward_pwm;
+#if PID_FIXED_POINT
+    for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+        pid_command.target_q[i] = PIDQ_FROM_FLOAT(target_rpm / PID_RpmPerCount(i));
+    }
+    pid_command.feedforward_q = PIDQ_FROM_FLOAT(feedforward_pwm);
 #endif
+    PID_Publish();
+}
 
-    pid_init(&pid_speed_right,
-             pid_params_right.kp, pid_params_right.ki, pid_params_right.kd,
-             0.0f, pid_params_right.out_max);
-    pid_set_target(&pid_speed_right, basic_speed);
+/**
+ * @brief 开关多轴同步 (前台任意优先级调用, 如串口命令 sync on/off)
+ * @param enable 1=交叉耦合同步, 0=各轴独立跟踪同一速度目标
+ * @note pid_command 由优先级0的 Motor_Task 修改和发布, 这里挡住优先级0, 不会与它交错
+ */
+void PID_SetSync(unsigned char enable)
+{
+#if SCHEDULER_PREEMPTIVE
+    uint8_t kernel_prev = kernel_lock(0);
+#endif
+
+    pid_command.sync_enable = enable;
+    PID_Publish();
+
+#if SCHEDULER_PREEMPTIVE
+    kernel_unlock(kernel_prev);
+#endif
 }
 
-unsigned char pid_running = 0;
+/**
+ * @brief 获取同步误差(遥测, 前台调用)
+ * @return 最超前与最落后两轴的位置差(脉冲), 单轴布局恒为0
+ * @note 由内环在同一周期内算好, 各轴误差来自同一次采样
+ */
+int32_t PID_GetSyncError(void)
+{
+    return pid_sync_spread;
+}
 
+/**
+ * @brief 速度环任务 (控制内环, TIM2中断)
+ * @note 每个周期读取外环发布的最新命令; 外环10ms才更新一次目标,
+ *       内环以 CONTROL_RATE_HZ 抑制负载扰动
+ */
 void PID_Task(void)
 {
-    if (pid_running == 0) return;
+    PidCommand_t cmd;
+
+    handoff_read(&pid_command_handoff, &cmd);
+    pid_inner_running = cmd.running;
+    if (cmd.running == 0) return;
+
+    if (cmd.start_seq != pid_start_seen) {
+        pid_start_seen = cmd.start_seq;
+        PID_Reset();
+    }
 
-#if MOTOR_COUNT == 2
-    int output_left = pid_calculate_positional(&pid_speed_left, left_encoder.rpm);
-    Motor_Set_Speed(&left_motor, output_left);
+    // 多轴时按位置偏差修正各轴速度目标 (单轴布局编译期去除)
+    if (AXIS_COUNT > 1) {
+        PID_Sync_Update(&cmd);
+    } else {
+        pid_batch.target[0] = cmd.target_rpm;
+#if PID_FIXED_POINT
+        pidq_set_target(&pid_q[0], cmd.target_q[0]);
 #endif
+    }
+
+    // 输出 = 前馈 + PID修正 (反馈使用速度估计器输出)
+    // PID限幅扣除前馈, 抗饱和按电机实际饱和点判断
+#if PID_FIXED_POINT
+    for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+        PIDQ_T *pid = &pid_q[i];
+        pidq_set_output_limits(pid, pid_out_min_q[i] - cmd.feedforward_q, pid_out_max_q[i] - cmd.feedforward_q);
+        int32_t output = cmd.feedforward_q + pidq_calculate(pid, axes[i].encoder.speed_q16);
+        Motor_Set_Speed(&axes[i].motor, output / PIDQ_ONE);
+    }
+#else
+    float current[AXIS_COUNT];
+    for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+        current[i] = axes[i].encoder.rpm_filtered;
+        pid_batch.out_min[i] = pid_params[i].out_min - cmd.feedforward;
+        pid_batch.out_max[i] = pid_params[i].out_max - cmd.feedforward;
+    }
+
+    // 所有轴一次批量计算 (单轴/双轴布局也走批量路径: 系数预先按周期算好, 省去标量版本每次的除法,
+    // 单轴耗时与 pid_calculate_advanced 持平, 两轴起更快, 见 Tools/pid_batch_bench.cpp)
+    pid_batch_update(&pid_batch, current);
 
-    int output_right = pid_calculate_positional(&pid_speed_right, right_encoder.rpm);
-    Motor_Set_Speed(&right_motor, output_right);
+    for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+        Motor_Set_Speed(&axes[i].motor, (int)(cmd.feedforward + pid_batch.out[i]));
+    }
+#endif
 }
 
+/**
+ * @brief 读取单轴速度环各项 (内环调用, 在 PID_Task 之后)
+ * @param axis 轴编号
+ * @param terms 输出: 目标和 P/I/D 各项
+ * @return 本周期是否执行了速度环, 0 时各项为停止前的值
+ * @note 定点模式在这里把Q16换算为浮点, 只在遥测采样的周期执行
+ */
+unsigned char PID_GetTerms(uint8_t axis, PidTerms_t *terms)
+{
+    terms->target_rpm = pid_batch.target[axis];
+#if PID_FIXED_POINT
+    terms->p = (float)pid_q[axis].p_out / PIDQ_ONE;
+    terms->i = (float)pid_q[axis].integral / PIDQ_ONE;
+    terms->d = (float)pid_q[axis].d_out / PIDQ_ONE;
+#else
+    terms->p = pid_batch.p_out[axis];
+    terms->i = pid_batch.integral[axis];
+    terms->d = pid_batch.d_out[axis];
+#endif
+    return pid_inner_running;
+}
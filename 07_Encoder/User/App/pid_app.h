@@ -3,25 +3,63 @@
 
 #include "MyDefine.h"
 
-// PID参数结构体
+// PID参数结构体 (连续时间增益, 由 pid_calculate_advanced 按实际dt计算)
 typedef struct
 {
     float kp;          // 比例系数
-    float ki;          // 积分系数
-    float kd;          // 微分系数
+    float ki;          // 积分系数(1/s)
+    float kd;          // 微分系数(s)
     float out_min;     // 输出最小值
     float out_max;     // 输出最大值
 } PidParams_t;
 
+/**
+ * @brief 速度环数值格式
+ * @note 0 = 浮点 (默认, F407带FPU)
+ *       1 = Q16定点: 编码器 speed_q16 (脉冲/周期) → pidq_calculate → 整数PWM, 热路径无浮点运算,
+ *           每轴执行时间固定; 浮点参数只在初始化/设目标时换算
+ */
+#define PID_FIXED_POINT 0
+
+// 速度环结构参数
+#define PID_SPEED_SP_WEIGHT  1.0f    // P项设定值权重 (前馈已承担目标变化, 取1)
+#define PID_SPEED_D_TAU      0.02f   // D项滤波时间常数(s), kd>0 时生效
+
+// ============================= 多轴同步 =============================
+
+/**
+ * @brief 交叉耦合同步参数
+ * @note 各轴位置(自 PID_Start 起的脉冲数)相对平均位置的偏差, 按比例修正该轴的速度目标,
+ *       超前的轴减速、落后的轴加速, 使各轴走过的距离保持一致 (直线行驶不跑偏)
+ *       位置偏差本身就是速度误差的积分, 只用比例项即可消除稳态偏差
+ */
+#define PID_SYNC_KP          0.2f    // 修正量 rpm / 脉冲偏差
+#define PID_SYNC_LIMIT_RPM   20.0f   // 修正量限幅(rpm)
+
+/**
+ * @brief 速度环各项 (遥测, 单位为PWM)
+ * @note 输出PWM = 前馈 + p + i + d (限幅前); i 为本周期更新后的积分项
+ */
+typedef struct {
+    float target_rpm;  // 目标转速 (含同步修正)
+    float p;           // 比例项
+    float i;           // 积分项
+    float d;           // 微分项
+} PidTerms_t;
+
+void PID_LoadDefaults(void);
 void PID_Init(void);
 void PID_Task(void);
-
-extern unsigned char pid_running; // PID 控制使能开关
+void PID_Start(void);
+void PID_Stop(void);
+void PID_SetSpeedTarget(float target_rpm, float feedforward_pwm);
+void PID_SetSync(unsigned char enable);
+int32_t PID_GetSyncError(void);
+unsigned char PID_GetTerms(uint8_t axis, PidTerms_t *terms);
 
 extern int basic_speed;
 
-extern PID_T pid_speed_left;  // 左轮速度环
-extern PID_T pid_speed_right; // 右轮速度环
+extern PidParams_t pid_params[];  // 各轴速度环参数 (下标同 axes[])
 
 
 #endif
@@ -0,0 +1,116 @@
+#include "telem_app.h"
+#include "frame.h"
+
+#if TELEM_ENABLE
+
+// 采样缓冲区 (写端: 控制内环, 读端: Telem_Task)
+static uint8_t telem_ring_buffer[TELEM_RING_SIZE];
+static Spsc_T telem_ring;
+
+// 抽取比, 0 = 停止输出 (前台写、内环读, 单字节读写不会撕裂)
+static volatile uint8_t telem_decimation = 0;
+static uint8_t telem_phase = 0;     // 抽取计数 (只在内环读写)
+static uint32_t telem_seq = 0;      // 控制周期序号 (只在内环读写)
+
+/**
+ * @brief 初始化遥测缓冲区
+ */
+void Telem_Init(void)
+{
+    spsc_init(&telem_ring, telem_ring_buffer, TELEM_RING_SIZE);
+}
+
+/**
+ * @brief 设置抽取比 (前台调用)
+ * @param decimation 每 decimation 个控制周期输出一个采样, 0 = 停止
+ */
+void Telem_SetDecimation(uint8_t decimation)
+{
+    telem_decimation = decimation;
+}
+
+/**
+ * @brief 是否正在输出遥测 (输出期间不再打印周期性的文本调试信息)
+ */
+uint8_t Telem_IsStreaming(void)
+{
+    return telem_decimation != 0;
+}
+
+/**
+ * @brief 记录一个采样 (控制内环, 每个周期在 PID_Task 之后调用)
+ * @note 只做拷贝, 不做格式化和编码; 缓冲区放不下时丢弃本次采样, 主机端按 seq 的间断发现
+ */
+void Telem_Capture(void)
+{
+    uint32_t seq = telem_seq++;
+    uint8_t decimation = telem_decimation;
+    TelemSample_t sample;
+    PidTerms_t terms;
+
+    if (decimation == 0) return;
+    if (++telem_phase < decimation) return;
+    telem_phase = 0;
+
+    sample.seq = seq;
+    sample.flags = 0;
+    sample.axis_count = AXIS_COUNT;
+    sample.sync_error = (int16_t)PID_GetSyncError();
+
+    for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+        const Axis *axis = &axes[i];
+        TelemAxis_t *out = &sample.axis[i];
+
+        if (PID_GetTerms(i, &terms)) sample.flags |= 0x01;
+        out->position = (int32_t)axis->encoder.position;
+        out->count = axis->encoder.count;
+        out->pwm = (int16_t)axis->motor.speed;
+        out->rpm = axis->encoder.rpm_filtered;
+        out->target_rpm = terms.target_rpm;
+        out->p = terms.p;
+        out->i = terms.i;
+        out->d = terms.d;
+    }
+
+    if (spsc_space_len(&telem_ring) >= sizeof(sample)) {
+        spsc_write(&telem_ring, (const uint8_t *)&sample, sizeof(sample));
+    }
+}
+
+/**
+ * @brief 遥测输出任务: 取走缓冲区中的采样, 打包成帧放入串口发送队列
+ * @note 每帧最多 TELEM_FRAME_BATCH 个采样; 帧前后各一个分隔符, 与前面的文本输出分开
+ *       串口发送队列放不下时整帧丢弃
+ */
+void Telem_Task(void)
+{
+    static uint8_t payload[TELEM_FRAME_HEADER + TELEM_FRAME_BATCH * sizeof(TelemSample_t)];
+    static uint8_t frame[1 + FRAME_ENCODED_MAX(sizeof(payload))];
+    uint32_t count;
+
+    while ((count = spsc_data_len(&telem_ring) / sizeof(TelemSample_t)) > 0) {
+        uint16_t period_us = 1000000 / CONTROL_RATE_HZ;
+
+        if (count > TELEM_FRAME_BATCH) count = TELEM_FRAME_BATCH;
+
+        payload[0] = TELEM_FRAME_SAMPLES;
+        payload[1] = telem_decimation;
+        payload[2] = (uint8_t)period_us;
+        payload[3] = (uint8_t)(period_us >> 8);
+        spsc_read(&telem_ring, &payload[TELEM_FRAME_HEADER], count * sizeof(TelemSample_t));
+
+        frame[0] = FRAME_DELIMITER;
+        uint32_t len = 1 + frame_encode(payload, TELEM_FRAME_HEADER + count * sizeof(TelemSample_t), &frame[1]);
+        Uart_Write(DEBUG_UART, frame, len);
+    }
+}
+
+#else
+
+void Telem_Init(void) {}
+void Telem_Task(void) {}
+void Telem_Capture(void) {}
+void Telem_SetDecimation(uint8_t decimation) { (void)decimation; }
+uint8_t Telem_IsStreaming(void) { return 0; }
+
+#endif
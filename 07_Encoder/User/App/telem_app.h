@@ -0,0 +1,62 @@
+#ifndef __TELEM_APP_H__
+#define __TELEM_APP_H__
+
+#include "MyDefine.h"
+#include "axis_app.h"
+
+/**
+ * @brief 二进制遥测开关
+ * @note 1 = 控制内环每个周期(可抽取)记录一个采样, 按帧(COBS + CRC16)从调试串口输出
+ *       0 = 所有遥测代码编译为空
+ */
+#define TELEM_ENABLE 1
+
+// 遥测缓冲区大小(字节, 2的幂): 内环写入、Telem_Task 取走, 1kHz单轴约可缓存56ms
+#define TELEM_RING_SIZE 2048
+
+// 帧类型 (负载第一个字节)
+#define TELEM_FRAME_SAMPLES 0x54
+
+/**
+ * @brief 单轴数据 (28字节, 小端)
+ */
+typedef struct {
+    int32_t position;   // 累计位置(脉冲, 低32位)
+    int16_t count;      // 本周期计数增量(脉冲)
+    int16_t pwm;        // 输出PWM (前馈 + PID, 限幅后)
+    float rpm;          // 速度环反馈(rpm, 速度估计器输出)
+    float target_rpm;   // 目标转速(rpm, 含同步修正)
+    float p;            // 比例项(PWM)
+    float i;            // 积分项(PWM)
+    float d;            // 微分项(PWM)
+} TelemAxis_t;
+
+/**
+ * @brief 一个采样 (8 + 28*AXIS_COUNT 字节)
+ */
+typedef struct {
+    uint32_t seq;           // 控制周期序号 (上电以来, 含未输出的周期), 时刻 = seq * 周期
+    uint8_t flags;          // bit0: 速度环运行中
+    uint8_t axis_count;     // 轴数
+    int16_t sync_error;     // 同步误差(脉冲, 单轴为0)
+    TelemAxis_t axis[AXIS_COUNT];
+} TelemSample_t;
+
+/*
+    帧负载: 帧头4字节 + 若干采样
+      uint8_t  type         TELEM_FRAME_SAMPLES
+      uint8_t  decimation   抽取比 (每 decimation 个控制周期一个采样)
+      uint16_t period_us    控制周期(us)
+      TelemSample_t samples[]
+    负载 + CRC 不超过254字节, COBS只多1字节
+*/
+#define TELEM_FRAME_HEADER 4
+#define TELEM_FRAME_BATCH  ((252 - TELEM_FRAME_HEADER) / sizeof(TelemSample_t))
+
+void Telem_Init(void);
+void Telem_Task(void);
+void Telem_Capture(void);
+void Telem_SetDecimation(uint8_t decimation);
+uint8_t Telem_IsStreaming(void);
+
+#endif
@@ -1,33 +1,49 @@
 #include "uart_app.h"
+#include "telem_app.h"
+#include <stdlib.h>
 
 /* 串口 1 */
-extern uint8_t uart1_rx_dma_buffer[BUFFER_SIZE]; // DMA 读取缓冲区
-
-extern uint8_t uart1_ring_buffer_input[BUFFER_SIZE]; // 环形缓冲区对应的线性数组
-extern struct rt_ringbuffer uart1_ring_buffer; // 环形缓冲区
+extern Spsc_T uart1_ring_buffer; // 环形缓冲区
 
 extern uint8_t uart1_data_buffer[BUFFER_SIZE]; // 数据处理缓冲区
 
 void Uart_Init(void)
 {
   /* 串口 1 */
-  rt_ringbuffer_init(&uart1_ring_buffer, uart1_ring_buffer_input, BUFFER_SIZE);
-  
-  HAL_UARTEx_ReceiveToIdle_DMA(&huart1, uart1_rx_dma_buffer, BUFFER_SIZE); // 启动读取中断
-  __HAL_DMA_DISABLE_IT(&hdma_usart1_rx, DMA_IT_HT); // 关闭 DMA 的"半满中断"功能
-  
+  Uart_Rx_Init(); // 接收环形缓冲区 + DMA 循环接收 (半满/全满/空闲事件)
 }
 
 /* 串口 1 */
 void Uart1_Task(void)
 {
-  uint16_t uart_data_len = rt_ringbuffer_data_len(&uart1_ring_buffer);
+  uint16_t uart_data_len = spsc_data_len(&uart1_ring_buffer);
+  if(uart_data_len > BUFFER_SIZE - 1) uart_data_len = BUFFER_SIZE - 1; // 一次最多处理一个数据处理缓冲区, 其余下次处理
   if(uart_data_len > 0)
   {
-    rt_ringbuffer_get(&uart1_ring_buffer, uart1_data_buffer, uart_data_len);
+    spsc_read(&uart1_ring_buffer, uart1_data_buffer, uart_data_len);
     uart1_data_buffer[uart_data_len] = '\0';
     /* 数据解析 */
-    Uart_Printf(DEBUG_UART, "UART1 Ringbuffer:%s\r\n", uart1_data_buffer);
+    if (strncmp((char *)uart1_data_buffer, "perf reset", 10) == 0) {
+      Perf_Reset();       // 清零执行时间统计
+    } else if (strncmp((char *)uart1_data_buffer, "perf", 4) == 0) {
+      Perf_Report();      // 输出执行时间报告
+    } else if (strncmp((char *)uart1_data_buffer, "log text", 8) == 0) {
+      Log_SetOutput(LOG_OUTPUT_TEXT);    // 日志在设备上格式化为文本
+    } else if (strncmp((char *)uart1_data_buffer, "log bin", 7) == 0) {
+      Log_SetOutput(LOG_OUTPUT_BINARY);  // 日志按二进制帧输出, 主机端还原
+    } else if (strncmp((char *)uart1_data_buffer, "sync on", 7) == 0) {
+      PID_SetSync(1);     // 多轴交叉耦合同步 (默认)
+    } else if (strncmp((char *)uart1_data_buffer, "sync off", 8) == 0) {
+      PID_SetSync(0);     // 各轴独立跟踪同一目标, 用于对比同步效果
+    } else if (strncmp((char *)uart1_data_buffer, "telem off", 9) == 0) {
+      Telem_SetDecimation(0);  // 停止二进制遥测
+    } else if (strncmp((char *)uart1_data_buffer, "telem", 5) == 0) {
+      // "telem [N]": 每N个控制周期输出一个采样, 默认每个周期
+      int decimation = atoi((char *)uart1_data_buffer + 5);
+      Telem_SetDecimation(decimation < 1 ? 1 : decimation > 255 ? 255 : decimation);
+    } else {
+      LOG_D("UART1 Ringbuffer:%s", (char *)uart1_data_buffer);
+    }
     
     memset(uart1_data_buffer, 0, uart_data_len);
   }
@@ -2,6 +2,7 @@
 #include "ui_menu_app.h"
 #include "ui_animation_app.h"
 #include "oled_driver.h"
+#include "axis_app.h"
 #include "motor_app.h"
 #include <stdio.h>
 #include <string.h>
@@ -43,7 +44,8 @@ static void draw_centered_text(uint8_t y, const char *text)
  */
 void UI_Page_Update(PageState page)
 {
-    MotorState* motor = MotorApp_GetState();
+    MotorState snapshot;  // 界面任务 (Oled_Task) 不在优先级0, 读取一致副本
+    const MotorState* motor = MotorApp_ReadState(&snapshot);
 
     // 系统信息页面需要持续刷新编码器数值
     if (page == PAGE_SYSTEM_INFO) {
@@ -91,7 +93,11 @@ void UI_Page_Update(PageState page)
             break;
 
         case PAGE_SETTINGS:
-            // TODO: 后续添加各页面的更新逻辑
+            // 标定进行中: 每200ms刷新标定进度
+            if (++ui_refresh.update_counter >= 20) {
+                ui_refresh.update_counter = 0;
+                g_menu_state.need_redraw = true;
+            }
             break;
         default:
             break;
@@ -233,8 +239,28 @@ void UI_Page_KeyHandler(PageState page, KeyEvent key_event)
             }
             break;
 
-        case PAGE_SYSTEM_INFO:
         case PAGE_SETTINGS:
+            // KEY3: 切换开环/闭环控制 (A/B对比)
+            if (key_event == KEY_EVENT_CONFIRM) {
+                MotorApp_ToggleControlMode();
+                g_menu_state.need_redraw = true;
+            }
+            // KEY1: 启动PWM→转速自动标定 (再按一次中止)
+            else if (key_event == KEY_EVENT_UP) {
+                if (motor->is_running) {
+                    MotorApp_Stop();
+                } else {
+                    MotorApp_Calibration_Start();
+                }
+                g_menu_state.need_redraw = true;
+            }
+            // KEY2: 保存当前参数到flash
+            else if (key_event == KEY_EVENT_DOWN) {
+                Param_RequestSave();
+            }
+            break;
+
+        case PAGE_SYSTEM_INFO:
             // TODO: 后续添加各页面的按键处理逻辑
             break;
         default:
@@ -305,7 +331,8 @@ void UI_Page_DrawMainMenu(void)
 void UI_Page_DrawBasicRun(void)
 {
     char buf[22];  // 128像素/6=21个字符+结束符
-    MotorState* motor = MotorApp_GetState();
+    MotorState snapshot;
+    const MotorState* motor = MotorApp_ReadState(&snapshot);
 
     // 第0行:标题
     OLED_ShowString(0, 0, (uint8_t *)"Basic Run  [1/7]");
@@ -332,7 +359,8 @@ void UI_Page_DrawBasicRun(void)
 void UI_Page_DrawSpeedGear(void)
 {
     char buf[22];
-    MotorState* motor = MotorApp_GetState();
+    MotorState snapshot;
+    const MotorState* motor = MotorApp_ReadState(&snapshot);
     const char* gear_names[] = {"Low", "Mid", "High"};
 
     // 第0行:标题
@@ -364,7 +392,8 @@ void UI_Page_DrawSpeedGear(void)
 void UI_Page_DrawAcceleration(void)
 {
     char buf[22];
-    MotorState* motor = MotorApp_GetState();
+    MotorState snapshot;
+    const MotorState* motor = MotorApp_ReadState(&snapshot);
     const char* mode_names[] = {"Low", "High"};
 
     // 第0行:标题
@@ -392,7 +421,8 @@ void UI_Page_DrawAcceleration(void)
 void UI_Page_DrawTrapezoid(void)
 {
     char buf[22];
-    MotorState* motor = MotorApp_GetState();
+    MotorState snapshot;
+    const MotorState* motor = MotorApp_ReadState(&snapshot);
     const char* phase_names[] = {"Idle", "Accel", "Const", "Decel", "Done"};
 
     // 第0行:标题
@@ -402,9 +432,9 @@ void UI_Page_DrawTrapezoid(void)
     snprintf(buf, sizeof(buf), "Phase:[%s]  ", phase_names[motor->trapezoid_phase]);
     OLED_ShowString(0, 1, (uint8_t *)buf);
 
-    // 第2行:阶段时间
-    float elapsed_time = motor->trapezoid_timer * 0.01f;  // 转换为秒
-    snprintf(buf, sizeof(buf), "Time: %.1f s    ", elapsed_time);
+    // 第2行:已运行时间 / 预计总时间
+    snprintf(buf, sizeof(buf), "Time:%.1f/%.1fs  ",
+             motor->profile_time, motor->profile_total_time);
     OLED_ShowString(0, 2, (uint8_t *)buf);
 
     // 第3行:当前转速
@@ -418,13 +448,14 @@ void UI_Page_DrawTrapezoid(void)
 void UI_Page_DrawCircleControl(void)
 {
     char buf[22];
-    MotorState* motor = MotorApp_GetState();
+    MotorState snapshot;
+    const MotorState* motor = MotorApp_ReadState(&snapshot);
 
     // 第0行:标题
     OLED_ShowString(0, 0, (uint8_t *)"Circle Ctrl[5/7]");
 
-    // 第1行:目标圈数(可调节,1-20)
-    snprintf(buf, sizeof(buf), "Target: [%02d] C   ", motor->target_circles);
+    // 第1行:目标圈数(可调节,0.25-500)
+    snprintf(buf, sizeof(buf), "Target:[%.2f]C   ", motor->target_circles);
     OLED_ShowString(0, 1, (uint8_t *)buf);
 
     // 第2行:当前圈数
@@ -438,7 +469,9 @@ void UI_Page_DrawCircleControl(void)
     } else {
         // 停止状态显示操作提示
         if (motor->circle_state == CIRCLE_FINISHED) {
-            OLED_ShowString(0, 3, (uint8_t *)"Status: Done!   ");
+            // 完成: 显示最终误差(脉冲)
+            snprintf(buf, sizeof(buf), "Done Err:%+ld    ", (long)motor->circle_final_error);
+            OLED_ShowString(0, 3, (uint8_t *)buf);
         } else {
             OLED_ShowString(0, 3, (uint8_t *)"[1/2]Set [3]Run ");
         }
@@ -451,18 +484,20 @@ void UI_Page_DrawCircleControl(void)
 void UI_Page_DrawSystemInfo(void)
 {
     char buf[22];
-    extern Encoder left_encoder;
-    extern Encoder right_encoder;
 
     OLED_ShowString(0, 0, (uint8_t *)"Encoder Test[6/7]");
 
-    // 显示左轮编码器累计脉冲
-    snprintf(buf, sizeof(buf), "Left: %d     ", (int)left_encoder.total_count);
-    OLED_ShowString(0, 1, (uint8_t *)buf);
-
-    // 显示右轮编码器累计脉冲
-    snprintf(buf, sizeof(buf), "Right:%d     ", (int)right_encoder.total_count);
-    OLED_ShowString(0, 2, (uint8_t *)buf);
+    // 显示各轴编码器累计脉冲 (屏幕只放得下两行)
+    for (uint8_t i = 0; i < 2; i++) {
+        if (i < AXIS_COUNT) {
+            EncoderFeedback_t feedback;
+            Encoder_GetFeedback(i, &feedback);
+            snprintf(buf, sizeof(buf), "%s:%d          ", axis_config[i].name, (int)(int32_t)feedback.position);
+        } else {
+            snprintf(buf, sizeof(buf), "                ");
+        }
+        OLED_ShowString(0, 1 + i, (uint8_t *)buf);
+    }
 
     // 操作提示
     OLED_ShowString(0, 3, (uint8_t *)"Rotate 1 circle!");
@@ -473,8 +508,36 @@ void UI_Page_DrawSystemInfo(void)
  */
 void UI_Page_DrawSettings(void)
 {
+    char buf[22];
+    MotorState snapshot;
+    const MotorState* motor = MotorApp_ReadState(&snapshot);
+
     OLED_ShowString(0, 0, (uint8_t *)"Settings   [7/7]");
-    OLED_ShowString(0, 1, (uint8_t *)">PID_Kp: 10.0");
-    OLED_ShowString(0, 2, (uint8_t *)" PID_Ki: 0.1");
-    OLED_ShowString(0, 3, (uint8_t *)" PID_Kd: 0.0");
+
+    // 第1行:控制方式
+    snprintf(buf, sizeof(buf), ">Ctrl: %s  ",
+             motor->control_mode == MOTOR_CTRL_CLOSED_LOOP ? "Closed" : "Open");
+    OLED_ShowString(0, 1, (uint8_t *)buf);
+
+    // 第2行:速度环参数
+    snprintf(buf, sizeof(buf), " Kp%.1f Ki%.2f  ", pid_params[AXIS_RIGHT].kp, pid_params[AXIS_RIGHT].ki);
+    OLED_ShowString(0, 2, (uint8_t *)buf);
+
+    // 第3行:PWM→转速标定状态
+    const CalibTable_T* table = MotorApp_Calibration_GetTable();
+    switch (MotorApp_Calibration_GetState()) {
+        case CALIB_SETTLING:
+            snprintf(buf, sizeof(buf), " Cal: Run %2d pts ", table->count);
+            break;
+        case CALIB_DONE:
+            snprintf(buf, sizeof(buf), " Cal: OK %2d pts  ", table->count);
+            break;
+        case CALIB_FAILED:
+            snprintf(buf, sizeof(buf), " Cal: Failed     ");
+            break;
+        default:
+            snprintf(buf, sizeof(buf), " Cal: KEY1 start ");
+            break;
+    }
+    OLED_ShowString(0, 3, (uint8_t *)buf);
 }
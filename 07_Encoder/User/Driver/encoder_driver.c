@@ -1,4 +1,29 @@
 #include "encoder_driver.h"
+#include <math.h>
+
+/**
+ * @brief 启用DWT周期计数器, 作为边沿时间戳的时基
+ */
+static void Encoder_Timebase_Init(void)
+{
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+ * @brief 根据EXTI线号获取对应的中断号
+ */
+static IRQn_Type Encoder_EXTI_IRQn(uint32_t line)
+{
+  switch (line) {
+    case 0:  return EXTI0_IRQn;
+    case 1:  return EXTI1_IRQn;
+    case 2:  return EXTI2_IRQn;
+    case 3:  return EXTI3_IRQn;
+    case 4:  return EXTI4_IRQn;
+    default: return (line <= 9) ? EXTI9_5_IRQn : EXTI15_10_IRQn;
+  }
+}
 
 /**
  * @brief 初始化编码器驱动
@@ -7,49 +32,352 @@ void Encoder_Driver_Init(Encoder* encoder, TIM_HandleTypeDef *htim, unsigned cha
 {
   encoder->htim = htim;
   encoder->reverse = reverse;
+  encoder->ppr = ENCODER_PPR;
 
   // 启动定时器的编码器模式
   HAL_TIM_Encoder_Start(encoder->htim, TIM_CHANNEL_ALL);
 
-  // 清零计数器
-  __HAL_TIM_SetCounter(encoder->htim, 0);
+  // 计数器自由运行, 记录起始值即可 (之后只计算增量, 不再清零)
+  encoder->last_raw = (uint16_t)__HAL_TIM_GetCounter(encoder->htim);
 
   // 初始化数据结构
   encoder->count = 0;
   encoder->total_count = 0;
+  encoder->position = 0;
   encoder->speed_cm_s = 0.0f;
   encoder->rpm = 0.0f;
   encoder->rpm_filtered = 0.0f;  // 初始化滤波值
+  encoder->speed_q16 = 0;
+  encoder->accel_rpm_s = 0.0f;
+  vel_filter_init_iir(&encoder->filter, ENCODER_IIR_ALPHA);
+
+  // 默认仅使用M法, 调用 Encoder_Driver_EdgeCapture_Init 后切换为M/T法
+  encoder->edge_enabled = 0;
+  encoder->edge_flag = 0;
+  encoder->edge_raw = 0;
+  encoder->edge_cycles = 0;
+  encoder->last_edge_position = 0;
+  encoder->last_edge_cycles = 0;
+  encoder->last_edge_valid = 0;
+  encoder->last_edge_dir = 0;
+}
+
+/**
+ * @brief 启用编码器A相边沿捕获 (M/T法测速)
+ * @param port A相所在GPIO端口
+ * @param pin  A相引脚
+ * @note 引脚保持定时器复用功能, 仅额外挂接EXTI双边沿中断;
+ *       中断优先级与TIM2一致, 保证与 Encoder_Driver_Update 互不抢占
+ */
+void Encoder_Driver_EdgeCapture_Init(Encoder* encoder, GPIO_TypeDef *port, uint16_t pin)
+{
+  uint32_t line = POSITION_VAL(pin);
+  IRQn_Type irqn = Encoder_EXTI_IRQn(line);
+
+  Encoder_Timebase_Init();
+
+  // 将EXTI线映射到对应端口 (不修改GPIO模式, 编码器计数不受影响)
+  __HAL_RCC_SYSCFG_CLK_ENABLE();
+  SYSCFG->EXTICR[line >> 2u] &= ~(0x0FuL << (4u * (line & 0x03u)));
+  SYSCFG->EXTICR[line >> 2u] |= ((uint32_t)GPIO_GET_INDEX(port) << (4u * (line & 0x03u)));
+
+  // 双边沿触发
+  EXTI->RTSR |= pin;
+  EXTI->FTSR |= pin;
+  EXTI->PR = pin;
+
+  encoder->edge_flag = 0;
+  encoder->last_edge_valid = 0;
+  encoder->last_edge_dir = 0;
+  encoder->edge_enabled = 1;
+
+  EXTI->IMR |= pin;
+  HAL_NVIC_SetPriority(irqn, 0, 0);
+  HAL_NVIC_EnableIRQ(irqn);
+}
+
+/**
+ * @brief 编码器边沿中断处理 (在 HAL_GPIO_EXTI_Callback 中调用)
+ * @note 只记录计数值和时间戳, 计算留给 Encoder_Driver_Update
+ */
+void Encoder_Driver_EdgeIRQ(Encoder* encoder)
+{
+  encoder->edge_cycles = DWT->CYCCNT;
+  encoder->edge_raw = (uint16_t)__HAL_TIM_GetCounter(encoder->htim);
+  encoder->edge_flag = 1;
+}
+
+/**
+ * @brief 速度估计器的位置测量 (整数部分取 encoder->position 或边沿位置)
+ */
+typedef struct {
+  int64_t position;   // 测量位置(脉冲)
+  float offset;       // 小数部分(脉冲)
+  float age;          // 测量时刻距本次更新的时间(秒)
+} EncoderSample;
+
+/**
+ * @brief M/T法计算转速
+ * @param window_start 本采样周期开始时的累计位置
+ * @param window_raw   本采样周期开始时的硬件计数值
+ * @param rpm_m        M法(纯计数)得到的转速, 用于没有边沿记录时的回退
+ * @param sample       边沿方向确定且距今不超过 ENCODER_EDGE_HOLD_S 时改为边沿时刻的位置, 否则不修改
+ * @return 转速(RPM)
+ * @note 转速 = 两个边沿之间的脉冲数 / 两个边沿之间的时间,
+ *       低速时分辨率由时间戳决定, 不再受采样窗口内脉冲数的限制
+ *       计数值 n 代表 [n-0.5, n+0.5) 的中点, 边沿正好在两个计数值之间:
+ *       正转到达 n 时位于 n-0.5, 反转到达 n 时位于 n+0.5
+ *       边沿时刻的位置没有量化误差, 本周期没有新边沿时仍用上一个边沿 (低速时大多数周期没有新边沿)
+ */
+static float Encoder_MT_Calculate(Encoder* encoder, int64_t window_start, uint16_t window_raw, float rpm_m,
+                                  EncoderSample* sample)
+{
+  float rpm = rpm_m;
+  uint32_t now = DWT->CYCCNT;
+  float cycles_per_s = (float)SystemCoreClock;
+
+  if (encoder->edge_flag) {
+    // 本周期内有新边沿: 用上一个边沿到最新边沿的脉冲数和时间差计算
+    int16_t edge_delta = (int16_t)(encoder->edge_raw - window_raw);
+    uint32_t edge_cycles = encoder->edge_cycles;
+    encoder->edge_flag = 0;
+
+    int64_t edge_position = window_start + (encoder->reverse == 0 ? edge_delta : -edge_delta);
+
+    // 方向由相邻两个边沿的位置确定 (同一A相边沿正反向经过时计数值差1)
+    signed char dir = 0;
+    if (encoder->last_edge_valid && edge_position != encoder->last_edge_position) {
+      float dt = (float)(edge_cycles - encoder->last_edge_cycles) / cycles_per_s;
+      float pulses = (float)(edge_position - encoder->last_edge_position);
+      rpm = pulses / encoder->ppr * 60.0f / dt;
+      dir = pulses > 0.0f ? 1 : -1;
+    }
+
+    encoder->last_edge_position = edge_position;
+    encoder->last_edge_cycles = edge_cycles;
+    encoder->last_edge_valid = 1;
+    encoder->last_edge_dir = dir;
+  } else if (encoder->last_edge_valid) {
+    // 本周期内无边沿: 转速不会超过"2个脉冲/距上次边沿的时间" (4倍频计数, 相邻两个A相边沿相隔2个脉冲)
+    float elapsed = (float)(now - encoder->last_edge_cycles) / cycles_per_s;
+
+    if (elapsed >= ENCODER_MT_TIMEOUT_S) {
+      encoder->last_edge_valid = 0;
+      rpm = 0.0f;
+    } else {
+      float bound = 2.0f / encoder->ppr * 60.0f / elapsed;
+      rpm = encoder->rpm;
+      if (rpm > bound) rpm = bound;
+      if (rpm < -bound) rpm = -bound;
+    }
+  }
+
+  // 速度估计器的测量: 最近一个方向确定的边沿
+  if (encoder->last_edge_valid && encoder->last_edge_dir != 0) {
+    float age = (float)(now - encoder->last_edge_cycles) / cycles_per_s;
+    if (age < ENCODER_EDGE_HOLD_S) {
+      sample->position = encoder->last_edge_position;
+      sample->offset = encoder->last_edge_dir > 0 ? -0.5f : 0.5f;
+      sample->age = age;
+    }
+  }
+
+  return rpm;
+}
+
+/**
+ * @brief 由 rpm 计算线速度和滤波值 (M法/M/T法/批处理共用)
+ * @param sample 速度估计器的位置测量 (M/T法有近期边沿时为边沿时刻的精确位置)
+ */
+static void Encoder_Output(Encoder* encoder, const EncoderSample* sample)
+{
+  // 6. 计算速度 (cm/s)
+  // 速度 = (RPM / 60) * 周长
+  encoder->speed_cm_s = encoder->rpm / 60.0f * WHEEL_CIRCUMFERENCE_CM;
+
+  // 7. 速度估计 (可插拔: IIR / 位置锁相环 / alpha-beta-gamma)
+  // IIR只对测量速度滤波; PLL/ABG直接跟踪位置, 低滞后且不放大量化噪声
+  float rpm_to_cps = encoder->ppr / 60.0f;
+  float velocity = vel_filter_update_at(&encoder->filter, sample->position, sample->offset, sample->age,
+                                        encoder->rpm * rpm_to_cps, SAMPLING_TIME_S);
+  encoder->rpm_filtered = velocity / rpm_to_cps;
+  encoder->accel_rpm_s = encoder->filter.acc / rpm_to_cps;
+}
+
+/**
+ * @brief 定点速度: 本周期脉冲数的一阶低通 (只有整数运算)
+ */
+static void Encoder_OutputQ(Encoder* encoder)
+{
+  int32_t sample = (int32_t)encoder->count * 65536;
+  encoder->speed_q16 += (int32_t)(((int64_t)(sample - encoder->speed_q16) * ENCODER_SPEED_Q_ALPHA) >> 16);
 }
 
 /**
- * @brief 更新编码器数据 (应周期性调用, 例如10ms一次)
+ * @brief 更新编码器数据 (每个控制周期调用一次)
  */
 void Encoder_Driver_Update(Encoder* encoder)
 {
-  // 1. 读取原始计数值
-  encoder->count = (int16_t)__HAL_TIM_GetCounter(encoder->htim);
+  // 1. 读取原始计数值, 与上次读数做16位有符号差分
+  // 计数器自由运行不清零, 读取与清零之间不会再丢失脉冲;
+  // 只要两次读取间的位移小于32767个脉冲, 溢出回绕也能正确处理
+  uint16_t window_raw = encoder->last_raw;
+  uint16_t raw = (uint16_t)__HAL_TIM_GetCounter(encoder->htim);
+  encoder->last_raw = raw;
+  encoder->count = (int16_t)(raw - window_raw);
 
   // 2. 处理编码器反向
   encoder->count = encoder->reverse == 0 ? encoder->count : -encoder->count;
 
-  // 3. 清零硬件计数器,为下个周期做准备
-  __HAL_TIM_SetCounter(encoder->htim, 0);
+  // 3. 累计到64位位置
+  int64_t window_start = encoder->position;
+  encoder->position += encoder->count;
 
   // 4. 累计总数
-  encoder->total_count += encoder->count;
+  encoder->total_count = (int32_t)encoder->position;
+  Encoder_OutputQ(encoder);
+
+  // 5. 计算RPM (每分钟转数) - 原始值
+  // M法: RPM = (计数值 / PPR) * (60 / 采样时间)
+  encoder->rpm = (float)encoder->count / encoder->ppr * (60.0f / SAMPLING_TIME_S);
+
+  // 启用边沿捕获时改用M/T法, 提高低速分辨率; 有近期边沿时速度估计器也改用边沿时刻的位置
+  EncoderSample sample = {encoder->position, 0.0f, 0.0f};
+  if (encoder->edge_enabled) {
+    encoder->rpm = Encoder_MT_Calculate(encoder, window_start, window_raw, encoder->rpm, &sample);
+  }
+
+  // 6~7. 计算线速度并滤波
+  Encoder_Output(encoder, &sample);
+}
+
+// ============================= DMA批量采样模式 =============================
+
+/**
+ * @brief 初始化DMA采样: 定时器触发DMA把编码器CNT搬运到环形缓冲区
+ * @param sampler       采样器
+ * @param encoder       对应的编码器 (需先调用 Encoder_Driver_Init)
+ * @param stream        DMA数据流 (例如 DMA1_Stream1)
+ * @param channel       DMA通道 (例如 DMA_CHANNEL_3)
+ * @param sample_time_s 触发周期 (秒)
+ * @note 只配置并启动DMA; 触发源(定时器的DMA请求)由应用层使能
+ */
+void Encoder_Driver_DMA_Init(EncoderDMA* sampler, Encoder* encoder,
+                             DMA_Stream_TypeDef *stream, uint32_t channel, float sample_time_s)
+{
+  sampler->sample_time_s = sample_time_s;
+  sampler->read_index = 0;
+  sampler->samples = 0;
+  sampler->overruns = 0;
+  sampler->peak_rpm = 0.0f;
+  sampler->jitter_counts = 0.0f;
+
+  // 缓冲区预填当前计数值, 避免第一批出现虚假位移
+  uint16_t raw = (uint16_t)__HAL_TIM_GetCounter(encoder->htim);
+  for (uint16_t i = 0; i < ENCODER_DMA_BUFFER_SIZE; i++) {
+    sampler->buffer[i] = raw;
+  }
+  encoder->last_raw = raw;
+
+  // 外设(CNT) -> 内存, 半字宽度, 循环模式, 无中断
+  sampler->hdma.Instance = stream;
+  sampler->hdma.Init.Channel = channel;
+  sampler->hdma.Init.Direction = DMA_PERIPH_TO_MEMORY;
+  sampler->hdma.Init.PeriphInc = DMA_PINC_DISABLE;
+  sampler->hdma.Init.MemInc = DMA_MINC_ENABLE;
+  sampler->hdma.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+  sampler->hdma.Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+  sampler->hdma.Init.Mode = DMA_CIRCULAR;
+  sampler->hdma.Init.Priority = DMA_PRIORITY_HIGH;
+  sampler->hdma.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+  if (HAL_DMA_Init(&sampler->hdma) != HAL_OK)
+  {
+    Error_Handler();
+  }
+
+  HAL_DMA_Start(&sampler->hdma, (uint32_t)&encoder->htim->Instance->CNT,
+                (uint32_t)sampler->buffer, ENCODER_DMA_BUFFER_SIZE);
+  __HAL_DMA_CLEAR_FLAG(&sampler->hdma, __HAL_DMA_GET_HT_FLAG_INDEX(&sampler->hdma) |
+                                       __HAL_DMA_GET_TC_FLAG_INDEX(&sampler->hdma));
+}
+
+/**
+ * @brief 批量处理DMA缓冲区中的新样本 (替代 Encoder_Driver_Update, 每个控制周期调用一次)
+ * @note 1. 逐个样本做16位差分累计位置, 与 Encoder_Driver_Update 一样不丢脉冲
+ *       2. 对本批"位置-时间"做最小二乘直线拟合, 斜率即为速度
+ *       3. 统计相邻样本峰值转速和拟合残差RMS(抖动)
+ *       每批样本数不超过缓冲区的1/4; 两批之间写指针越过了半满和全满两个位置, 说明可能已绕过一圈,
+ *       按下标差算出的样本数不可信, 整批丢弃
+ */
+void Encoder_Driver_UpdateBatch(Encoder* encoder, EncoderDMA* sampler)
+{
+  // 先取走半满/全满标志再读写指针, 之后越过的位置算到下一批
+  uint32_t ht_flag = __HAL_DMA_GET_HT_FLAG_INDEX(&sampler->hdma);
+  uint32_t tc_flag = __HAL_DMA_GET_TC_FLAG_INDEX(&sampler->hdma);
+  uint8_t overrun = __HAL_DMA_GET_FLAG(&sampler->hdma, ht_flag) && __HAL_DMA_GET_FLAG(&sampler->hdma, tc_flag);
+  __HAL_DMA_CLEAR_FLAG(&sampler->hdma, ht_flag | tc_flag);
+
+  uint16_t write_index = ENCODER_DMA_BUFFER_SIZE - (uint16_t)__HAL_DMA_GET_COUNTER(&sampler->hdma);
+  if (write_index >= ENCODER_DMA_BUFFER_SIZE) write_index = 0;
+
+  uint16_t n = (uint16_t)((write_index + ENCODER_DMA_BUFFER_SIZE - sampler->read_index) % ENCODER_DMA_BUFFER_SIZE);
+  sampler->samples = overrun ? 0 : n;
+
+  // 样本不足以拟合或溢出时退回普通采样: 直接读CNT (计数器自由运行, 差分不丢脉冲),
+  // 并跳过缓冲区中已有的样本, 下一批从写指针开始
+  if (overrun || n < 2) {
+    if (overrun) sampler->overruns++;
+    sampler->read_index = write_index;
+    Encoder_Driver_Update(encoder);
+    return;
+  }
+
+  int64_t window_start = encoder->position;
+  int32_t y = 0;
+  int16_t peak = 0;
+  float sx = 0.0f, sy = 0.0f, sxx = 0.0f, sxy = 0.0f, syy = 0.0f;
+
+  for (uint16_t i = 0; i < n; i++) {
+    uint16_t raw = sampler->buffer[(sampler->read_index + i) % ENCODER_DMA_BUFFER_SIZE];
+    int16_t delta = (int16_t)(raw - encoder->last_raw);
+    encoder->last_raw = raw;
+
+    delta = encoder->reverse == 0 ? delta : -delta;
+    y += delta;
+    if (delta > peak) peak = delta;
+    if (-delta > peak) peak = -delta;
+
+    float fx = (float)i;
+    float fy = (float)y;
+    sx += fx;
+    sy += fy;
+    sxx += fx * fx;
+    sxy += fx * fy;
+    syy += fy * fy;
+  }
+  sampler->read_index = write_index;
+
+  // 位置累计
+  encoder->count = (int16_t)y;
+  encoder->position = window_start + y;
+  encoder->total_count = (int32_t)encoder->position;
+  Encoder_OutputQ(encoder);
+
+  // 最小二乘斜率 (脉冲/样本)
+  float fn = (float)n;
+  float cxx = sxx - sx * sx / fn;
+  float cxy = sxy - sx * sy / fn;
+  float cyy = syy - sy * sy / fn;
+  float slope = cxy / cxx;
 
-  // 5. 计算速度 (cm/s)
-  // 速度 = (计数值 / PPR) * 周长 / 采样时间
-  encoder->speed_cm_s = (float)encoder->count / ENCODER_PPR * WHEEL_CIRCUMFERENCE_CM / SAMPLING_TIME_S;
+  float counts_to_rpm = 60.0f / encoder->ppr / sampler->sample_time_s;
+  encoder->rpm = slope * counts_to_rpm;
 
-  // 6. 计算RPM (每分钟转数) - 原始值
-  // RPM = (计数值 / PPR) * (60 / 采样时间)
-  encoder->rpm = (float)encoder->count / ENCODER_PPR * (60.0f / SAMPLING_TIME_S);
+  // 峰值和抖动统计
+  float sse = cyy - slope * cxy;
+  sampler->peak_rpm = (float)peak * counts_to_rpm;
+  sampler->jitter_counts = (sse > 0.0f) ? sqrtf(sse / fn) : 0.0f;
 
-  // 7. 一阶低通滤波 (IIR滤波器)
-  // 滤波系数: alpha=0.3表示新值占30%,旧值占70%
-  // alpha越小,滤波越平滑,但响应越慢
-  #define FILTER_ALPHA 0.3f
-  encoder->rpm_filtered = FILTER_ALPHA * encoder->rpm + (1.0f - FILTER_ALPHA) * encoder->rpm_filtered;
+  EncoderSample sample = {encoder->position, 0.0f, 0.0f};
+  Encoder_Output(encoder, &sample);
 }
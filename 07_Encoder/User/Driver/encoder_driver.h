@@ -2,6 +2,8 @@
 #define __ENCODER_DRIVER_H__
 
 #include "main.h"
+#include "velocity_filter.h"
+#include "control_rate.h"
 
 // 编码器每转一圈的脉冲数 (PPR) - 实际测量值
 #define ENCODER_PPR 1551  // 实测约1551脉冲/圈
@@ -11,7 +13,18 @@
 // 自动计算周长和采样时间
 #define ENCODER_PI 3.14159265f
 #define WHEEL_CIRCUMFERENCE_CM (WHEEL_DIAMETER_CM * ENCODER_PI)
-#define SAMPLING_TIME_S 0.01f // 采样时间, 与定时调用的任务周期一致 (10ms)
+#define SAMPLING_TIME_S CONTROL_DT_S // 采样时间, 等于控制周期 (见 MyDefine.h)
+
+// 默认速度估计器: 一阶低通系数 (新值权重)
+#define ENCODER_IIR_ALPHA 0.3f
+
+// 定点速度: 同一低通系数的Q16表示
+#define ENCODER_SPEED_Q_ALPHA ((int32_t)(ENCODER_IIR_ALPHA * 65536.0f))
+
+// M/T法测速: 超过该时间没有新边沿即认为已停转 (单位: 秒)
+#define ENCODER_MT_TIMEOUT_S 0.2f
+// 没有新边沿时, 速度估计器在该时间内继续使用上一个边沿时刻的位置 (单位: 秒)
+#define ENCODER_EDGE_HOLD_S 0.01f
 
 /**
  * @brief 编码器数据结构体
@@ -20,14 +33,55 @@ typedef struct
 {
   TIM_HandleTypeDef *htim; // 定时器
   unsigned char reverse; // 编码器的方向是否反转。0-正常，1-反转
+  uint16_t ppr;           // 每圈脉冲数 (默认 ENCODER_PPR, 可由参数存储覆盖)
   int16_t count;          // 当前采样周期内的原始计数值
   int32_t total_count;    // 累计总计数值
+  uint16_t last_raw;      // 上次读取的硬件计数值 (计数器自由运行, 不再清零)
+  int64_t position;       // 64位累计位置, 长时间运行不溢出
   float speed_cm_s;     // 计算出的速度 (cm/s)
   float rpm;            // 计算出的转速 (RPM - 每分钟转数) - 原始值
-  float rpm_filtered;   // 滤波后的转速 - 用于显示
+  float rpm_filtered;   // 滤波后的转速 - 由速度估计器给出
+  float accel_rpm_s;    // 估计角加速度 (rpm/s)
+  int32_t speed_q16;    // 定点速度 (Q16, 脉冲/采样周期, 一阶低通) - 定点控制链路使用
+  VelFilter_T filter;   // 速度估计器 (默认IIR, 可在初始化后切换为PLL/ABG)
+
+  // M/T法测速 (边沿时间戳, 由EXTI中断写入)
+  unsigned char edge_enabled;     // 是否启用边沿捕获。0-仅M法(计数)，1-M/T法
+  volatile uint8_t edge_flag;     // 本采样周期内是否捕获到新边沿
+  volatile uint16_t edge_raw;     // 最近一次边沿时的硬件计数值
+  volatile uint32_t edge_cycles;  // 最近一次边沿的DWT时间戳(CPU周期)
+  int64_t last_edge_position;     // 上一个有效边沿对应的累计位置
+  uint32_t last_edge_cycles;      // 上一个有效边沿的时间戳
+  unsigned char last_edge_valid;  // 上一个边沿记录是否有效
+  signed char last_edge_dir;      // 上一个边沿的方向: 1-正转, -1-反转, 0-未知
 } Encoder;
 
+// DMA批量采样: 环形缓冲区大小 (8kHz采样下可缓存8ms)
+#define ENCODER_DMA_BUFFER_SIZE 64
+
+/**
+ * @brief DMA批量采样器 (定时器触发DMA搬运CNT, 每个控制周期批处理一次)
+ */
+typedef struct
+{
+  DMA_HandleTypeDef hdma;                     // DMA句柄
+  uint16_t buffer[ENCODER_DMA_BUFFER_SIZE];   // CNT采样环形缓冲区
+  uint16_t read_index;                        // 已处理到的位置
+  float sample_time_s;                        // 采样间隔 (秒)
+
+  // 最近一批的统计
+  uint16_t samples;       // 样本数
+  uint32_t overruns;      // 两批之间DMA写指针可能已绕缓冲区一圈, 整批丢弃的次数
+  float peak_rpm;         // 相邻样本间的峰值转速
+  float jitter_counts;    // 最小二乘拟合残差RMS (脉冲)
+} EncoderDMA;
+
 void Encoder_Driver_Init(Encoder* encoder, TIM_HandleTypeDef *htim, unsigned char reverse);
+void Encoder_Driver_EdgeCapture_Init(Encoder* encoder, GPIO_TypeDef *port, uint16_t pin);
+void Encoder_Driver_EdgeIRQ(Encoder* encoder);
 void Encoder_Driver_Update(Encoder* encoder);
+void Encoder_Driver_DMA_Init(EncoderDMA* sampler, Encoder* encoder,
+                             DMA_Stream_TypeDef *stream, uint32_t channel, float sample_time_s);
+void Encoder_Driver_UpdateBatch(Encoder* encoder, EncoderDMA* sampler);
 
 #endif
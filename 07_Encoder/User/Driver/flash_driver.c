@@ -0,0 +1,58 @@
+#include "flash_driver.h"
+
+/**
+ * @brief 清除上次操作残留的错误标志, 否则HAL会直接返回错误
+ */
+static void Flash_Driver_ClearFlags(void)
+{
+  __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP | FLASH_FLAG_OPERR | FLASH_FLAG_WRPERR |
+                         FLASH_FLAG_PGAERR | FLASH_FLAG_PGPERR | FLASH_FLAG_PGSERR);
+}
+
+/**
+ * @brief 编程一个字 (32位)
+ * @param address 目标地址(4字节对齐, 必须已擦除)
+ * @param data 数据
+ * @return 0=成功, -1=失败
+ * @note 单字编程约16us, 期间取指会短暂等待, 不影响中断正常响应
+ */
+int Flash_Driver_ProgramWord(uint32_t address, uint32_t data)
+{
+  HAL_StatusTypeDef status;
+
+  HAL_FLASH_Unlock();
+  Flash_Driver_ClearFlags();
+  status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address, data);
+  HAL_FLASH_Lock();
+
+  // 回读校验
+  if (status != HAL_OK || *(__IO uint32_t *)address != data)
+    return -1;
+  return 0;
+}
+
+/**
+ * @brief 擦除一个扇区
+ * @param sector 扇区号 (FLASH_SECTOR_x)
+ * @return 0=成功, -1=失败
+ * @note 128KB扇区擦除约1~2s, F407为单bank, 擦除期间CPU从flash取指被阻塞
+ *       (包括中断), 只能在电机停止时调用
+ */
+int Flash_Driver_EraseSector(uint32_t sector)
+{
+  FLASH_EraseInitTypeDef erase = {0};
+  uint32_t sector_error = 0;
+  HAL_StatusTypeDef status;
+
+  erase.TypeErase = FLASH_TYPEERASE_SECTORS;
+  erase.Sector = sector;
+  erase.NbSectors = 1;
+  erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;  // 3.3V供电, 按字并行擦除
+
+  HAL_FLASH_Unlock();
+  Flash_Driver_ClearFlags();
+  status = HAL_FLASHEx_Erase(&erase, &sector_error);
+  HAL_FLASH_Lock();
+
+  return (status == HAL_OK && sector_error == 0xFFFFFFFFu) ? 0 : -1;
+}
@@ -0,0 +1,9 @@
+#ifndef __FLASH_DRIVER_H__
+#define __FLASH_DRIVER_H__
+
+#include "MyDefine.h"
+
+int Flash_Driver_ProgramWord(uint32_t address, uint32_t data);
+int Flash_Driver_EraseSector(uint32_t sector);
+
+#endif
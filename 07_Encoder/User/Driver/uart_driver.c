@@ -3,9 +3,10 @@
 // UART发送队列相关定义
 #define UART_TX_BUFFER_SIZE 1024  // 发送缓冲区大小为1024字节
 static uint8_t uart_tx_buffer[UART_TX_BUFFER_SIZE];  // 发送数据缓冲区
-static struct rt_ringbuffer uart_tx_ringbuffer;      // 发送环形缓冲区结构体
-static volatile uint8_t uart_tx_busy = 0;            // UART发送忙标志，0-空闲，1-忙
+static Spsc_T uart_tx_ring;                          // 发送环形缓冲区 (写端: Uart_Printf, 读端: DMA发送)
+static volatile uint32_t uart_tx_sending = 0;        // 正在DMA发送的字节数, 0-空闲 (发送完成后才从队列移除)
 static UART_HandleTypeDef *current_huart;            // 当前UART句柄
+static volatile uint32_t uart_tx_dropped = 0;        // 发送队列放不下而丢弃的字节数
 
 /**
  * @brief 初始化UART发送缓冲区
@@ -15,36 +16,54 @@ static UART_HandleTypeDef *current_huart;            // 当前UART句柄
  */
 void Uart_Tx_Init(void)
 {
-    // 使用RT-Thread环形缓冲区库初始化发送缓冲区
-    rt_ringbuffer_init(&uart_tx_ringbuffer, uart_tx_buffer, UART_TX_BUFFER_SIZE);
+    // 单生产者单消费者环形缓冲区, 读写位置分开存放, 前台与发送完成中断之间无需关中断
+    spsc_init(&uart_tx_ring, uart_tx_buffer, UART_TX_BUFFER_SIZE);
+}
+
+/**
+ * @brief 空闲时启动一次DMA发送
+ * @param 无
+ * @retval 无
+ * @note 前台或发送完成中断中调用 (DMA发送期间 uart_tx_sending 非0, 前台不会与中断同时启动); 每次发送队列中从读位置起连续的一段,
+ *       数据在缓冲区末尾折返时, 折返后的一段由发送完成中断接着发送
+ */
+static void Uart_Tx_Kick(void)
+{
+    uint8_t *data_ptr;   // 数据指针
+    uint32_t data_len;   // 数据长度
+
+    if (uart_tx_sending) return;
+
+    data_len = spsc_read_span(&uart_tx_ring, &data_ptr);
+    if (data_len == 0) return;
+
+    uart_tx_sending = data_len;
+    if (HAL_UART_Transmit_DMA(current_huart, data_ptr, data_len) != HAL_OK) {
+        uart_tx_sending = 0;  // 外设忙, 下次打印时重试
+    }
 }
 
 /**
  * @brief UART发送完成回调函数
  * @param huart UART句柄
  * @retval 无
- * @note 此函数在UART中断发送完成时被调用，用于处理队列中的下一包数据
+ * @note 此函数在DMA发送的最后一个字节移出后被调用: 从队列中移除已发送的数据, 接着发送下一段
  */
 void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
 {
-    uint8_t *data_ptr;      // 数据指针
-    rt_size_t data_len;     // 数据长度
-    
-    // 设置发送空闲状态
-    uart_tx_busy = 0;
-    
-    // 检查环形缓冲区中是否还有数据需要发送
-    data_len = rt_ringbuffer_peek(&uart_tx_ringbuffer, &data_ptr);
-    
-    if (data_len > 0) {
-        // 设置发送忙标志
-        uart_tx_busy = 1;
-        // 使用中断方式发送数据
-        HAL_UART_Transmit_IT(current_huart, data_ptr, data_len);
-        
-        // 更新读指针，从缓冲区中移除已发送的数据
-        rt_ringbuffer_get(&uart_tx_ringbuffer, NULL, data_len);
-    }
+    PERF_MARK(mark);
+
+    if (huart != current_huart) return;
+
+    PERF_BEGIN(mark);
+
+    // 发送完成后才释放队列空间, DMA读取期间这部分不会被新数据覆盖
+    spsc_read_release(&uart_tx_ring, uart_tx_sending);
+    uart_tx_sending = 0;
+
+    Uart_Tx_Kick();
+
+    PERF_END_ISR(mark, PERF_ISR_UART_TX);
 }
 
 /**
@@ -52,69 +71,209 @@ void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
  * @param huart UART句柄
  * @param format 格式化字符串
  * @param ... 可变参数
- * @retval 实际放入发送队列的字节数
- * @note 此函数是非阻塞的，数据会被放入发送队列后立即返回
+ * @retval 实际放入发送队列的字节数, 0 = 发送队列放不下, 整条丢弃
+ * @note 此函数是非阻塞的，数据直接格式化到发送队列的空闲区中 (不经过栈上的临时缓冲区) 后立即返回;
+ *       空闲区在缓冲区末尾处折返时, 先整条格式化到缓冲区开头, 再把前一段搬到末尾
  */
 int Uart_Printf(UART_HandleTypeDef *huart, const char *format, ...)
 {
-    char temp_buffer[512];  // 临时缓冲区，用于存储格式化后的数据
     va_list arg;            // 可变参数列表
     int len;                // 格式化后的数据长度
-    rt_size_t put_len;      // 实际放入环形缓冲区的数据长度
+    int put_len = 0;        // 实际放入环形缓冲区的数据长度
+    uint8_t *span, *wrap;   // 空闲区: 写入位置到缓冲区末尾 / 折返到缓冲区开头的部分
+    uint32_t span_len, wrap_len;
 
-    // 处理可变参数并格式化字符串
+#if SCHEDULER_PREEMPTIVE
+    // 发送队列被各优先级的任务共用, 预留到提交期间不允许任务抢占
+    uint8_t kernel_prev = kernel_lock(0);
+#endif
+
+    span_len = spsc_write_span(&uart_tx_ring, &span, &wrap, &wrap_len);
+
+    // 直接格式化到空闲区 (vsnprintf 还要多写一个结束符)
     va_start(arg, format);
-    len = vsnprintf(temp_buffer, sizeof(temp_buffer), format, arg);
+    len = vsnprintf((char *)span, span_len, format, arg);
     va_end(arg);
 
-    // 将数据放入发送队列（环形缓冲区）
-    put_len = rt_ringbuffer_put(&uart_tx_ringbuffer, (uint8_t*)temp_buffer, len);
-    
-    // 如果当前没有发送任务，则启动发送
-    if (!uart_tx_busy) {
-        uint8_t *data_ptr;   // 数据指针
-        rt_size_t data_len;  // 数据长度
-        
-        // 获取要发送的数据
-        data_len = rt_ringbuffer_peek(&uart_tx_ringbuffer, &data_ptr);
-      
-        if (data_len > 0) {
-            // 设置发送忙标志
-            uart_tx_busy = 1;
-            current_huart = huart;
-            // 使用中断方式发送数据
-            HAL_UART_Transmit_IT(huart, data_ptr, data_len);
-            
-            // 更新读指针，从缓冲区中移除已发送的数据
-            rt_ringbuffer_get(&uart_tx_ringbuffer, NULL, data_len);
+    if (len > 0 && (uint32_t)len >= span_len) {
+        if ((uint32_t)len < wrap_len) {
+            // 末尾放不下: 整条格式化到缓冲区开头, 前 span_len 字节搬到末尾, 其余前移
+            va_start(arg, format);
+            vsnprintf((char *)wrap, wrap_len, format, arg);
+            va_end(arg);
+            memcpy(span, wrap, span_len);
+            memmove(wrap, wrap + span_len, len - span_len);
+        } else {
+            // 发送队列放不下, 整条丢弃并计数 (不输出半条)
+            uart_tx_dropped += len;
+            len = 0;
         }
     }
 
+    // 提交: 一次写入写位置, 发送完成中断只修改读位置, 不需要关中断
+    if (len > 0) {
+        spsc_write_commit(&uart_tx_ring, len);
+        put_len = len;
+    }
+
+    // 如果当前没有发送任务，则启动发送
+    current_huart = huart;
+    Uart_Tx_Kick();
+
+#if SCHEDULER_PREEMPTIVE
+    kernel_unlock(kernel_prev);
+#endif
+
     // 返回实际放入发送队列的字节数
     return put_len;
 }
 
+/**
+ * @brief 非阻塞式UART写入二进制数据
+ * @param huart UART句柄
+ * @param data 数据
+ * @param len 字节数
+ * @retval 实际放入发送队列的字节数, 0 = 发送队列放不下, 整块丢弃
+ * @note 与 Uart_Printf 共用发送队列; 整块放入或整块丢弃, 二进制帧不会只发出半帧
+ */
+int Uart_Write(UART_HandleTypeDef *huart, const uint8_t *data, uint32_t len)
+{
+    int put_len = 0;
+
+#if SCHEDULER_PREEMPTIVE
+    uint8_t kernel_prev = kernel_lock(0);
+#endif
+
+    if (spsc_space_len(&uart_tx_ring) >= len) {
+        put_len = spsc_write(&uart_tx_ring, data, len);
+    } else {
+        uart_tx_dropped += len;
+    }
+
+    current_huart = huart;
+    Uart_Tx_Kick();
+
+#if SCHEDULER_PREEMPTIVE
+    kernel_unlock(kernel_prev);
+#endif
+
+    return put_len;
+}
+
+/**
+ * @brief 发送队列放不下而丢弃的字节数 (上电以来累计)
+ */
+uint32_t Uart_GetTxDropped(void)
+{
+    return uart_tx_dropped;
+}
+
 /* 串口 1 */
-uint8_t uart1_rx_dma_buffer[BUFFER_SIZE]; // DMA 读取缓冲区
+#define UART1_RX_DMA_SIZE 256     // DMA 循环接收缓冲区大小, 半满/全满各产生一次事件
+#define UART1_RX_RING_SIZE 1024   // 接收环形缓冲区大小 (2的幂), 容纳两次 Uart1_Task 之间的数据
 
-uint8_t uart1_ring_buffer_input[BUFFER_SIZE]; // 环形缓冲区对应的线性数组
-struct rt_ringbuffer uart1_ring_buffer; // 环形缓冲区
+static uint8_t uart1_rx_dma_buffer[UART1_RX_DMA_SIZE]; // DMA 循环接收缓冲区
+static uint16_t uart1_rx_pos = 0; // DMA 缓冲区中已取走数据的位置
+static volatile uint32_t uart_rx_dropped = 0; // 接收环形缓冲区放不下而丢弃的字节数
+
+static uint8_t uart1_ring_buffer_input[UART1_RX_RING_SIZE]; // 环形缓冲区对应的线性数组
+Spsc_T uart1_ring_buffer; // 环形缓冲区 (写端: 接收事件中断, 读端: Uart1_Task)
 
 uint8_t uart1_data_buffer[BUFFER_SIZE]; // 数据处理缓冲区
 
+/**
+ * @brief 启动 DMA 循环接收 (出错后重新启动也调用此函数)
+ * @param 无
+ * @retval 无
+ * @note 保留半满中断: 连续接收时每半个缓冲区取走一次, 不必等到空闲
+ */
+static void Uart1_Rx_Start(void)
+{
+    uart1_rx_pos = 0;
+    HAL_UARTEx_ReceiveToIdle_DMA(&huart1, uart1_rx_dma_buffer, UART1_RX_DMA_SIZE);
+}
+
+/**
+ * @brief 初始化串口1接收: 环形缓冲区 + DMA 循环接收
+ * @param 无
+ * @retval 无
+ */
+void Uart_Rx_Init(void)
+{
+    spsc_init(&uart1_ring_buffer, uart1_ring_buffer_input, UART1_RX_RING_SIZE);
+    Uart1_Rx_Start();
+}
+
+/**
+ * @brief 把 DMA 缓冲区中 [from, to) 的数据放入接收环形缓冲区
+ */
+static void Uart1_Rx_Take(uint16_t from, uint16_t to)
+{
+    if (to > from) {
+        uint32_t len = to - from;
+        uart_rx_dropped += len - spsc_write(&uart1_ring_buffer, &uart1_rx_dma_buffer[from], len);
+    }
+}
+
+/**
+ * @brief 接收事件回调 (DMA 半满、全满, 串口空闲)
+ * @param huart UART句柄
+ * @param Size DMA 在缓冲区中已写到的位置
+ * @retval 无
+ * @note DMA 一直循环运行, 不停止也不清缓冲区; 每次只取上次位置之后新增的数据
+ */
 void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
 {
+    PERF_MARK(mark);
+    PERF_BEGIN(mark);
+
     /* 串口 1 */
     if (huart->Instance == USART1)
     {
-        HAL_UART_DMAStop(huart);
+        if (Size < uart1_rx_pos) {
+            // 写位置已折返 (全满事件与后续事件合并处理): 先取到缓冲区末尾
+            Uart1_Rx_Take(uart1_rx_pos, UART1_RX_DMA_SIZE);
+            uart1_rx_pos = 0;
+        }
+        Uart1_Rx_Take(uart1_rx_pos, Size);
+        uart1_rx_pos = (Size >= UART1_RX_DMA_SIZE) ? 0 : Size;
+    }
 
-        rt_ringbuffer_put(&uart1_ring_buffer, uart1_rx_dma_buffer, Size);
+    PERF_END_ISR(mark, PERF_ISR_UART_RX);
+}
 
-        memset(uart1_rx_dma_buffer, 0, sizeof(uart1_rx_dma_buffer));
+/**
+ * @brief 串口错误回调
+ * @param huart UART句柄
+ * @retval 无
+ * @note 溢出/帧错误时 HAL 会中止 DMA 接收, 这里重新启动; 已取走的数据不受影响。
+ *       DMA发送出错时 HAL 中止发送且不再调用发送完成回调: 丢弃正在发送的一段 (计入丢弃字节数),
+ *       清除发送状态后接着发送队列中的下一段, 否则 uart_tx_sending 一直非0, 之后的打印全部堆在队列里
+ */
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+    // 只认发送DMA的传输错误 (HAL 已中止发送流): Uart_Tx_Kick 置 uart_tx_sending 后、启动DMA前,
+    // 接收出错也会进入这里, 此时不能释放还没发出的数据; FIFO/直接模式错误不中止传输, 仍由发送完成回调处理
+    if (huart == current_huart && uart_tx_sending && (huart->ErrorCode & HAL_UART_ERROR_DMA) &&
+        huart->hdmatx != NULL && (huart->hdmatx->ErrorCode & HAL_DMA_ERROR_TE))
+    {
+        huart->hdmatx->ErrorCode &= ~HAL_DMA_ERROR_TE;  // 已处理, 之后的接收错误不再当作发送错误
+        uart_tx_dropped += uart_tx_sending;
+        spsc_read_release(&uart_tx_ring, uart_tx_sending);
+        uart_tx_sending = 0;
+        Uart_Tx_Kick();
+    }
 
-        HAL_UARTEx_ReceiveToIdle_DMA(&huart1, uart1_rx_dma_buffer, sizeof(uart1_rx_dma_buffer));
-        
-         __HAL_DMA_DISABLE_IT(&hdma_usart1_rx, DMA_IT_HT);
+    if (huart->Instance == USART1 && huart->RxState == HAL_UART_STATE_READY)
+    {
+        Uart1_Rx_Start();
     }
 }
+
+/**
+ * @brief 接收环形缓冲区放不下而丢弃的字节数 (上电以来累计)
+ */
+uint32_t Uart_GetRxDropped(void)
+{
+    return uart_rx_dropped;
+}
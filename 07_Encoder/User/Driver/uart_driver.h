@@ -6,8 +6,12 @@
 #define BUFFER_SIZE 128 // С
 
 void Uart_Tx_Init(void);
+void Uart_Rx_Init(void);
 
 int Uart_Printf(UART_HandleTypeDef *huart, const char *format, ...);  
+int Uart_Write(UART_HandleTypeDef *huart, const uint8_t *data, uint32_t len);
+uint32_t Uart_GetTxDropped(void);
+uint32_t Uart_GetRxDropped(void);
 
 void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size);
 
@@ -0,0 +1,172 @@
+#include "motor_calib.h"
+
+/* 默认稳定判据 (按时间给出, 启动时换算为调用次数) */
+#define CALIB_SETTLE_TOL_RPM    0.3f    /* 相邻两个窗口平均转速差小于0.3rpm */
+#define CALIB_WINDOW_S          0.2f    /* 窗口200ms */
+#define CALIB_TIMEOUT_S         3.0f    /* 单点最长3s */
+
+/* 内部功能函数 */
+static void calib_record_point(CalibSweep_T * _tpSweep, float _rpm);
+static void calib_next_point(CalibSweep_T * _tpSweep);
+
+/*******************************************************************************
+ * @brief 启动PWM→转速扫描
+ * @param {CalibSweep_T *} _tpSweep 扫描器
+ * @param {CalibTable_T *} _tpTable 输出的标定表 (扫描期间置为无效)
+ * @param {int16_t} _pwm_start 起始PWM, 应低于电机起转点以找到死区边缘
+ * @param {int16_t} _pwm_end 结束PWM
+ * @param {int16_t} _pwm_step 步长
+ * @param {float} _dt 调用周期(s)
+ * @return {*}
+ * @note 扫描期间输出PWM不应再经过驱动层死区补偿, 否则测不到死区边缘
+ *******************************************************************************/
+void calib_sweep_start(CalibSweep_T * _tpSweep, CalibTable_T * _tpTable,
+                       int16_t _pwm_start, int16_t _pwm_end, int16_t _pwm_step, float _dt)
+{
+    _tpSweep->table = _tpTable;
+    _tpSweep->pwm_start = _pwm_start;
+    _tpSweep->pwm_end = _pwm_end;
+    _tpSweep->pwm_step = _pwm_step > 0 ? _pwm_step : 1;
+    _tpSweep->settle_tol = CALIB_SETTLE_TOL_RPM;
+    _tpSweep->window_ticks = (uint16_t)(CALIB_WINDOW_S / _dt + 0.5f);
+    _tpSweep->timeout_ticks = (uint16_t)(CALIB_TIMEOUT_S / _dt + 0.5f);
+    if (_tpSweep->window_ticks == 0) _tpSweep->window_ticks = 1;
+
+    _tpSweep->pwm = _pwm_start;
+    _tpSweep->tick = 0;
+    _tpSweep->window_count = 0;
+    _tpSweep->rpm_sum = 0;
+    _tpSweep->last_mean = 0;
+    _tpSweep->has_last_mean = 0;
+    _tpSweep->dead_band_pwm = _pwm_start;
+
+    _tpTable->count = 0;
+    _tpTable->valid = 0;
+
+    _tpSweep->state = CALIB_SETTLING;
+}
+
+/*******************************************************************************
+ * @brief 扫描状态机, 每个控制周期调用一次
+ * @param {CalibSweep_T *} _tpSweep 扫描器
+ * @param {float} _rpm 当前转速(建议使用滤波后的值)
+ * @return {int16_t} 本周期应输出的PWM
+ * @note 每个PWM点按窗口求平均转速, 相邻两个窗口平均值之差小于阈值即认为稳定,
+ *       记录后进入下一个点; 单点超时则用最近窗口平均值记录
+ *******************************************************************************/
+int16_t calib_sweep_update(CalibSweep_T * _tpSweep, float _rpm)
+{
+    if (_tpSweep->state != CALIB_SETTLING)
+        return 0;
+
+    _tpSweep->tick++;
+    _tpSweep->rpm_sum += _rpm;
+    _tpSweep->window_count++;
+
+    if (_tpSweep->window_count >= _tpSweep->window_ticks)
+    {
+        float mean = _tpSweep->rpm_sum / _tpSweep->window_count;
+        float diff = mean - _tpSweep->last_mean;
+
+        _tpSweep->rpm_sum = 0;
+        _tpSweep->window_count = 0;
+
+        if ((_tpSweep->has_last_mean && diff < _tpSweep->settle_tol && diff > -_tpSweep->settle_tol) ||
+            _tpSweep->tick >= _tpSweep->timeout_ticks)
+        {
+            calib_record_point(_tpSweep, mean);
+            calib_next_point(_tpSweep);
+        }
+        else
+        {
+            _tpSweep->last_mean = mean;
+            _tpSweep->has_last_mean = 1;
+        }
+    }
+
+    return _tpSweep->state == CALIB_SETTLING ? _tpSweep->pwm : 0;
+}
+
+/*******************************************************************************
+ * @brief 目标转速→PWM (标定表的反函数)
+ * @param {const CalibTable_T *} _tpTable 标定表
+ * @param {float} _rpm 目标转速(非负)
+ * @return {int16_t} PWM值
+ * @note rpm<=0返回0; 表内分段线性插值; 超出最高点按最后一段斜率外推
+ *******************************************************************************/
+int16_t calib_table_rpm_to_pwm(const CalibTable_T * _tpTable, float _rpm)
+{
+    uint8_t i;
+
+    if (_rpm <= 0.0f || _tpTable->count < 2)
+        return 0;
+
+    /* 找到 rpm[i-1] <= _rpm < rpm[i] 的区间, 超出则使用最后一段 */
+    for (i = 1; i < _tpTable->count - 1; i++)
+    {
+        if (_rpm < _tpTable->rpm[i])
+            break;
+    }
+
+    float r0 = _tpTable->rpm[i - 1], r1 = _tpTable->rpm[i];
+    float p0 = _tpTable->pwm[i - 1], p1 = _tpTable->pwm[i];
+    float pwm = p0 + (_rpm - r0) * (p1 - p0) / (r1 - r0);
+
+    return (int16_t)(pwm + 0.5f);
+}
+
+/* ————————————————————————————————— 内部功能函数 ————————————————————————————————— */
+/*******************************************************************************
+ * @brief 记录一个标定点
+ * @note 1. 未转动的点只更新死区边缘, 不入表
+ *       2. 第一次转动时先插入 (死区边缘, 0rpm)
+ *       3. 只保留转速严格递增的点, 保证反函数单调
+ *******************************************************************************/
+static void calib_record_point(CalibSweep_T * _tpSweep, float _rpm)
+{
+    CalibTable_T *table = _tpSweep->table;
+
+    if (_rpm < CALIB_STILL_RPM)
+    {
+        _tpSweep->dead_band_pwm = _tpSweep->pwm;
+        return;
+    }
+
+    if (table->count == 0)
+    {
+        table->pwm[0] = _tpSweep->dead_band_pwm;
+        table->rpm[0] = 0.0f;
+        table->count = 1;
+    }
+
+    if (table->count >= CALIB_MAX_POINTS)
+        return;
+
+    if (_rpm <= table->rpm[table->count - 1])
+        return;
+
+    table->pwm[table->count] = _tpSweep->pwm;
+    table->rpm[table->count] = _rpm;
+    table->count++;
+}
+
+/*******************************************************************************
+ * @brief 进入下一个PWM点, 到达终点后结束扫描
+ *******************************************************************************/
+static void calib_next_point(CalibSweep_T * _tpSweep)
+{
+    _tpSweep->tick = 0;
+    _tpSweep->window_count = 0;
+    _tpSweep->rpm_sum = 0;
+    _tpSweep->has_last_mean = 0;
+
+    if (_tpSweep->pwm + _tpSweep->pwm_step > _tpSweep->pwm_end ||
+        _tpSweep->table->count >= CALIB_MAX_POINTS)
+    {
+        _tpSweep->table->valid = (_tpSweep->table->count >= 2);
+        _tpSweep->state = _tpSweep->table->valid ? CALIB_DONE : CALIB_FAILED;
+        return;
+    }
+
+    _tpSweep->pwm += _tpSweep->pwm_step;
+}
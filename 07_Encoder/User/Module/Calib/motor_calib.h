@@ -0,0 +1,75 @@
+#ifndef __MOTOR_CALIB_H
+#define __MOTOR_CALIB_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 标定表最大点数 */
+#define CALIB_MAX_POINTS 32
+
+/* 转速低于该值视为未转动(死区内), 单位rpm */
+#define CALIB_STILL_RPM 1.0f
+
+/* PWM→转速标定表 (rpm严格递增, 第一个点为死区边缘, rpm=0) */
+typedef struct
+{
+    int16_t pwm[CALIB_MAX_POINTS];      /* PWM值 */
+    float rpm[CALIB_MAX_POINTS];        /* 对应稳态转速 */
+    uint8_t count;                      /* 有效点数 */
+    uint8_t valid;                      /* 1=标定完成可用 */
+}CalibTable_T;
+
+/* 扫描状态 */
+typedef enum
+{
+    CALIB_IDLE = 0,                     /* 空闲 */
+    CALIB_SETTLING,                     /* 等待当前PWM下转速稳定 */
+    CALIB_DONE,                         /* 完成 */
+    CALIB_FAILED                        /* 失败(有效点不足) */
+}CalibState;
+
+/* 扫描器 */
+typedef struct
+{
+    CalibState state;
+    CalibTable_T *table;                /* 输出的标定表 */
+
+    /* 参数 */
+    int16_t pwm_start;                  /* 起始PWM(应低于死区边缘) */
+    int16_t pwm_end;                    /* 结束PWM */
+    int16_t pwm_step;                   /* 步长 */
+    float settle_tol;                   /* 稳定判据: 相邻两个窗口平均转速差(rpm) */
+    uint16_t window_ticks;              /* 平均窗口长度(调用次数) */
+    uint16_t timeout_ticks;             /* 单点超时次数, 超时按最近窗口平均值记录 */
+
+    /* 运行状态 */
+    int16_t pwm;                        /* 当前输出PWM */
+    uint16_t tick;                      /* 当前点已等待次数 */
+    uint16_t window_count;              /* 当前窗口已累加次数 */
+    float rpm_sum;                      /* 当前窗口转速累加 */
+    float last_mean;                    /* 上一个窗口平均转速 */
+    uint8_t has_last_mean;              /* 上一个窗口是否有效 */
+    int16_t dead_band_pwm;              /* 最后一个未转动的PWM */
+}CalibSweep_T;
+
+/*
+    提供给用户调用的API
+*/
+/* 启动扫描 */
+void calib_sweep_start(CalibSweep_T * _tpSweep, CalibTable_T * _tpTable,
+                       int16_t _pwm_start, int16_t _pwm_end, int16_t _pwm_step, float _dt);
+
+/* 周期调用: 输入当前转速, 返回应输出的PWM (完成/失败后返回0) */
+int16_t calib_sweep_update(CalibSweep_T * _tpSweep, float _rpm);
+
+/* 查表: 目标转速→PWM (分段线性插值, 超出范围按端点斜率外推) */
+int16_t calib_table_rpm_to_pwm(const CalibTable_T * _tpTable, float _rpm);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,218 @@
+#include "velocity_filter.h"
+#include <math.h>
+
+/* 估计位置超过该值时把整数部分并入 origin */
+#define VEL_FILTER_REBASE_COUNTS 4096.0f
+
+/*******************************************************************************
+ * @brief 初始化为一阶低通滤波
+ * @param {VelFilter_T *} _tpFilter 指向估计器的指针
+ * @param {float} _alpha 新值权重(0~1), 越小越平滑, 滞后越大
+ * @return {*}
+ * @note 与原 FILTER_ALPHA 滤波等价, 只对测量速度滤波
+ *******************************************************************************/
+void vel_filter_init_iir(VelFilter_T * _tpFilter, float _alpha)
+{
+    _tpFilter->type = VEL_FILTER_IIR;
+    _tpFilter->alpha = _alpha;
+    vel_filter_reset(_tpFilter);
+}
+
+/*******************************************************************************
+ * @brief 初始化为二阶位置锁相环
+ * @param {VelFilter_T *} _tpFilter 指向估计器的指针
+ * @param {float} _wn 环路自然频率(rad/s), 决定跟踪带宽
+ * @param {float} _zeta 阻尼比, 一般取0.7~1.0
+ * @return {*}
+ * @note 跟踪测量位置, 对匀速输入无稳态误差; 速度由积分器给出, 不直接差分量化位置
+ *******************************************************************************/
+void vel_filter_init_pll(VelFilter_T * _tpFilter, float _wn, float _zeta)
+{
+    _tpFilter->type = VEL_FILTER_PLL;
+    _tpFilter->kp = 2.0f * _zeta * _wn;
+    _tpFilter->ki = _wn * _wn;
+    vel_filter_reset(_tpFilter);
+}
+
+/*******************************************************************************
+ * @brief 初始化为 alpha-beta-gamma 跟踪器
+ * @param {VelFilter_T *} _tpFilter 指向估计器的指针
+ * @param {float} _alpha 位置增益
+ * @param {float} _beta 速度增益
+ * @param {float} _gamma 加速度增益
+ * @return {*}
+ * @note 匀加速模型的稳态卡尔曼滤波, 对匀加速输入无稳态误差
+ *******************************************************************************/
+void vel_filter_init_abg(VelFilter_T * _tpFilter, float _alpha, float _beta, float _gamma)
+{
+    _tpFilter->type = VEL_FILTER_ABG;
+    _tpFilter->alpha = _alpha;
+    _tpFilter->beta = _beta;
+    _tpFilter->gamma = _gamma;
+    vel_filter_reset(_tpFilter);
+}
+
+/*******************************************************************************
+ * @brief 把 alpha-beta-gamma 增益从整定周期换算到实际更新周期
+ * @param {float *} _alpha _beta _gamma 输入: _ref_dt 下整定的增益, 输出: _dt 下的等效增益
+ * @param {float} _ref_dt 整定时的更新周期(s)
+ * @param {float} _dt 实际更新周期(s)
+ * @return {*}
+ * @note 闭环特征多项式 z³+(α+β+γ-3)z²+(3-2α-β+γ)z+(α-1) 的极点按 z' = z^(dt/ref_dt)
+ *       (即 s = ln(z)/ref_dt 不变) 映射, 再由新多项式反解增益, 带宽和阻尼与整定时一致
+ *       增益较大时简单按 dt 比例缩放误差明显, 不能代替此换算
+ *******************************************************************************/
+void vel_filter_abg_rescale(float * _alpha, float * _beta, float * _gamma, float _ref_dt, float _dt)
+{
+    float k = _dt / _ref_dt;
+    float c2 = *_alpha + *_beta + *_gamma - 3.0f;
+    float c1 = 3.0f - 2.0f * *_alpha - *_beta + *_gamma;
+    float c0 = *_alpha - 1.0f;
+    float p = 1.0f;
+    float b1, b0, disc, q1, q0, pk;
+
+    /* 牛顿法求最大实根 (稳定跟踪器的极点都在单位圆内, 从1开始单调收敛) */
+    for (uint8_t i = 0; i < 30; i++)
+    {
+        float f = ((p + c2) * p + c1) * p + c0;
+        float df = (3.0f * p + 2.0f * c2) * p + c1;
+        if (df == 0.0f) break;
+        p -= f / df;
+    }
+
+    /* 除去实根, 剩余二次因子 z² + b1·z + b0 */
+    b1 = c2 + p;
+    b0 = c1 + p * b1;
+
+    /* 极点映射 */
+    pk = powf(fabsf(p), k);
+    disc = b1 * b1 - 4.0f * b0;
+    if (disc < 0.0f)
+    {
+        /* 共轭复极点 r·e^(±jθ) → r^k·e^(±jkθ) */
+        float r = sqrtf(b0);
+        float theta = acosf(-b1 / (2.0f * r));
+        float rk = powf(r, k);
+        q1 = -2.0f * rk * cosf(k * theta);
+        q0 = rk * rk;
+    }
+    else
+    {
+        float z1 = powf(fabsf(0.5f * (-b1 + sqrtf(disc))), k);
+        float z2 = powf(fabsf(0.5f * (-b1 - sqrtf(disc))), k);
+        q1 = -(z1 + z2);
+        q0 = z1 * z2;
+    }
+
+    /* 新特征多项式 (z - pk)(z² + q1·z + q0) 反解增益 */
+    c2 = q1 - pk;
+    c1 = q0 - pk * q1;
+    c0 = -pk * q0;
+    *_alpha = 1.0f + c0;
+    *_gamma = 0.5f * ((c2 + 3.0f - *_alpha) + (c1 - 3.0f + 2.0f * *_alpha));
+    *_beta = (c2 + 3.0f - *_alpha) - *_gamma;
+}
+
+/*******************************************************************************
+ * @brief 重置估计器状态
+ * @param {VelFilter_T *} _tpFilter 指向估计器的指针
+ * @return {*}
+ * @note 下一次更新时用测量值重新初始化
+ *******************************************************************************/
+void vel_filter_reset(VelFilter_T * _tpFilter)
+{
+    _tpFilter->origin = 0;
+    _tpFilter->pos = 0;
+    _tpFilter->vel = 0;
+    _tpFilter->acc = 0;
+    _tpFilter->initialized = 0;
+}
+
+/*******************************************************************************
+ * @brief 更新估计器
+ * @param {VelFilter_T *} _tpFilter 指向估计器的指针
+ * @param {int64_t} _position 测量位置(脉冲)
+ * @param {float} _velocity 测量速度(脉冲/秒), 仅IIR使用
+ * @param {float} _dt 更新周期(秒)
+ * @return {float} 估计速度(脉冲/秒)
+ *******************************************************************************/
+float vel_filter_update(VelFilter_T * _tpFilter, int64_t _position, float _velocity, float _dt)
+{
+    return vel_filter_update_at(_tpFilter, _position, 0.0f, 0.0f, _velocity, _dt);
+}
+
+/*******************************************************************************
+ * @brief 更新估计器 (带时间戳的位置测量)
+ * @param {VelFilter_T *} _tpFilter 指向估计器的指针
+ * @param {int64_t} _position 测量位置整数部分(脉冲)
+ * @param {float} _offset 测量位置小数部分(脉冲), 如边沿位于两个计数值之间时为 ±0.5
+ * @param {float} _age 测量时刻距本次更新的时间(秒), 0~_dt
+ * @param {float} _velocity 测量速度(脉冲/秒), 仅IIR使用
+ * @param {float} _dt 更新周期(秒)
+ * @return {float} 估计速度(脉冲/秒)
+ * @note PLL/ABG先预测到本次更新时刻, 再把预测状态回推 _age 秒与测量比较, 按原增益校正;
+ *       编码器边沿时刻的位置没有量化误差, 低速时比周期末读到的计数值精确得多
+ *******************************************************************************/
+float vel_filter_update_at(VelFilter_T * _tpFilter, int64_t _position, float _offset, float _age,
+                           float _velocity, float _dt)
+{
+    if (!_tpFilter->initialized)
+    {
+        _tpFilter->origin = _position;
+        _tpFilter->pos = _offset;
+        _tpFilter->vel = _velocity;
+        _tpFilter->acc = 0;
+        _tpFilter->initialized = 1;
+        return _tpFilter->vel;
+    }
+
+    float measured = (float)(_position - _tpFilter->origin) + _offset;
+
+    switch (_tpFilter->type)
+    {
+    case VEL_FILTER_PLL:
+    {
+        /* 预测 */
+        _tpFilter->pos += _tpFilter->vel * _dt;
+        /* 校正: 位置误差经PI得到速度 */
+        float error = measured - (_tpFilter->pos - _tpFilter->vel * _age);
+        _tpFilter->acc = _tpFilter->ki * error;
+        _tpFilter->vel += _tpFilter->acc * _dt;
+        _tpFilter->pos += _tpFilter->kp * error * _dt;
+        break;
+    }
+
+    case VEL_FILTER_ABG:
+    {
+        /* 预测 */
+        _tpFilter->pos += _tpFilter->vel * _dt + 0.5f * _tpFilter->acc * _dt * _dt;
+        _tpFilter->vel += _tpFilter->acc * _dt;
+        /* 校正 */
+        float error = measured - (_tpFilter->pos - (_tpFilter->vel - 0.5f * _tpFilter->acc * _age) * _age);
+        _tpFilter->pos += _tpFilter->alpha * error;
+        _tpFilter->vel += _tpFilter->beta * error / _dt;
+        _tpFilter->acc += _tpFilter->gamma * error / (0.5f * _dt * _dt);
+        break;
+    }
+
+    case VEL_FILTER_IIR:
+    default:
+    {
+        float last_vel = _tpFilter->vel;
+        _tpFilter->vel = _tpFilter->alpha * _velocity + (1.0f - _tpFilter->alpha) * _tpFilter->vel;
+        _tpFilter->acc = (_tpFilter->vel - last_vel) / _dt;
+        _tpFilter->pos = measured;
+        break;
+    }
+    }
+
+    /* 基准平移, 保持float状态量较小 */
+    if (_tpFilter->pos > VEL_FILTER_REBASE_COUNTS || _tpFilter->pos < -VEL_FILTER_REBASE_COUNTS)
+    {
+        int32_t shift = (int32_t)_tpFilter->pos;
+        _tpFilter->origin += shift;
+        _tpFilter->pos -= (float)shift;
+    }
+
+    return _tpFilter->vel;
+}
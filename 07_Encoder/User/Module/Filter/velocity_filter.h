@@ -0,0 +1,67 @@
+#ifndef __VELOCITY_FILTER_H
+#define __VELOCITY_FILTER_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 速度估计器类型 */
+typedef enum
+{
+    VEL_FILTER_IIR = 0,         /* 一阶低通(对测量速度滤波) */
+    VEL_FILTER_PLL,             /* 二阶位置锁相环(跟踪位置, 输出位置/速度) */
+    VEL_FILTER_ABG              /* alpha-beta-gamma 稳态卡尔曼(输出位置/速度/加速度) */
+} VelFilterType;
+
+/* 速度估计器结构体 */
+typedef struct
+{
+    VelFilterType type;         /* 估计器类型 */
+
+    /* 参数 */
+    float alpha;                /* IIR系数 / ABG位置增益 */
+    float beta;                 /* ABG速度增益 */
+    float gamma;                /* ABG加速度增益 */
+    float kp;                   /* PLL比例增益 (2*zeta*wn) */
+    float ki;                   /* PLL积分增益 (wn^2) */
+
+    /* 状态 (位置单位: 脉冲, 相对 origin) */
+    int64_t origin;             /* 位置基准, 防止float精度随累计位置下降 */
+    float pos;                  /* 估计位置 */
+    float vel;                  /* 估计速度 (脉冲/秒) */
+    float acc;                  /* 估计加速度 (脉冲/秒^2) */
+    uint8_t initialized;        /* 首次更新时用测量值初始化状态 */
+}VelFilter_T;
+
+/*
+    提供给用户调用的API
+*/
+/* 一阶低通: alpha为新值权重 */
+void vel_filter_init_iir(VelFilter_T * _tpFilter, float _alpha);
+
+/* 二阶锁相环: 带宽wn(rad/s), 阻尼比zeta */
+void vel_filter_init_pll(VelFilter_T * _tpFilter, float _wn, float _zeta);
+
+/* alpha-beta-gamma跟踪器 */
+void vel_filter_init_abg(VelFilter_T * _tpFilter, float _alpha, float _beta, float _gamma);
+
+/* 把 alpha-beta-gamma 增益从整定周期换算到实际更新周期 (连续时间极点不变) */
+void vel_filter_abg_rescale(float * _alpha, float * _beta, float * _gamma, float _ref_dt, float _dt);
+
+/* 重置状态 */
+void vel_filter_reset(VelFilter_T * _tpFilter);
+
+/* 更新: 输入测量位置(脉冲)和测量速度(脉冲/秒), 返回估计速度(脉冲/秒) */
+float vel_filter_update(VelFilter_T * _tpFilter, int64_t _position, float _velocity, float _dt);
+
+/* 更新 (带时间戳的位置): 测量位置 _position + _offset 是 _age 秒之前的值, 如编码器边沿时刻的精确位置 */
+float vel_filter_update_at(VelFilter_T * _tpFilter, int64_t _position, float _offset, float _age,
+                           float _velocity, float _dt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
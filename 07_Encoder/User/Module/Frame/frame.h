@@ -0,0 +1,40 @@
+#ifndef __FRAME_H
+#define __FRAME_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    二进制帧: 负载 + CRC16, 经COBS编码后以 0x00 结尾
+    - COBS 把数据中的 0x00 全部替换掉, 0x00 只作为帧分隔符, 接收端从任意位置开始都能按 0x00 重新对齐
+    - CRC-16/CCITT-FALSE (多项式 0x1021, 初值 0xFFFF), 小端附在负载之后, 一起参与COBS编码
+    - 负载 + CRC 不超过 254 字节时, COBS 只多出 1 字节
+    - 同一串口上可与文本混合输出: 文本行中不含 0x00, 校验不通过的一段按文本处理
+*/
+
+/* 帧分隔符 */
+#define FRAME_DELIMITER     0x00
+
+/* 负载 _len 字节编码后的最大长度 (含CRC和结尾分隔符) */
+#define FRAME_ENCODED_MAX(_len)     ((_len) + 2 + ((_len) + 2) / 254 + 1 + 1)
+
+/*
+    提供给用户调用的API
+*/
+/* CRC-16/CCITT-FALSE, _crc 为初值 (首次传 0xFFFF, 可分段连续计算) */
+uint16_t frame_crc16(const uint8_t * _data, uint32_t _len, uint16_t _crc);
+
+/* 编码: _out 至少 FRAME_ENCODED_MAX(_len) 字节, 返回编码后的长度 (含结尾 0x00) */
+uint32_t frame_encode(const uint8_t * _payload, uint32_t _len, uint8_t * _out);
+
+/* 解码一帧 (不含分隔符), _out 至少 _len 字节, 返回负载长度; COBS格式错误或CRC不符返回 -1 */
+int32_t frame_decode(const uint8_t * _in, uint32_t _len, uint8_t * _out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
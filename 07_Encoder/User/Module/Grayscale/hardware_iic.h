@@ -1,6 +1,7 @@
 #include "stm32f4xx_hal.h"
 #include "i2c.h"
 #include "gw_grayscale_sensor.h"
+unsigned char IIC_ReadBytes(unsigned char Salve_Adress,unsigned char Reg_Address,unsigned char *Result,unsigned char len);
 unsigned char Ping(void);
 unsigned char IIC_Get_Digtal(void);
 unsigned char IIC_Get_Anolog(unsigned char * Result,unsigned char len);
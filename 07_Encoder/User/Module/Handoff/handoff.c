@@ -0,0 +1,60 @@
+#include "handoff.h"
+#include <string.h>
+
+/* 编译器屏障: 单核 Cortex-M 上保证数据写完才发布序号、序号读到后才读数据 */
+#define HANDOFF_BARRIER()   __asm volatile ("" ::: "memory")
+
+/*******************************************************************************
+ * @brief 初始化
+ * @param {Handoff_T *} _tpHandoff 指向交接结构体的指针
+ * @param {void *} _slot0 _slot1 两个缓冲区, 大小均为 _size
+ * @param {uint16_t} _size 一组数据的字节数
+ * @return {*}
+ * @note _slot0 的内容作为初始值 (发布序号0), 在中断启用之前调用
+ *******************************************************************************/
+void handoff_init(Handoff_T * _tpHandoff, void * _slot0, void * _slot1, uint16_t _size)
+{
+    _tpHandoff->slot[0] = _slot0;
+    _tpHandoff->slot[1] = _slot1;
+    _tpHandoff->size = _size;
+    memcpy(_slot1, _slot0, _size);
+    _tpHandoff->seq = 0;
+}
+
+/*******************************************************************************
+ * @brief 写端: 发布一组新数据
+ * @param {Handoff_T *} _tpHandoff 指向交接结构体的指针
+ * @param {const void *} _data 新数据
+ * @return {*}
+ * @note 只能有一个写端; 写入未发布的缓冲区, 写完后序号加1完成发布
+ *******************************************************************************/
+void handoff_write(Handoff_T * _tpHandoff, const void * _data)
+{
+    uint32_t next = _tpHandoff->seq + 1;
+
+    memcpy(_tpHandoff->slot[next & 1], _data, _tpHandoff->size);
+    HANDOFF_BARRIER();
+    _tpHandoff->seq = next;
+}
+
+/*******************************************************************************
+ * @brief 读端: 读取最新一组数据
+ * @param {const Handoff_T *} _tpHandoff 指向交接结构体的指针
+ * @param {void *} _data 读出的数据
+ * @return {uint32_t} 该组数据的发布序号, 与上次比较可判断是否有新数据
+ * @note 读取期间写端再发布两次及以上时, 正在读的缓冲区可能已被覆盖, 重读
+ *******************************************************************************/
+uint32_t handoff_read(const Handoff_T * _tpHandoff, void * _data)
+{
+    uint32_t seq;
+
+    do
+    {
+        seq = _tpHandoff->seq;
+        HANDOFF_BARRIER();
+        memcpy(_data, _tpHandoff->slot[seq & 1], _tpHandoff->size);
+        HANDOFF_BARRIER();
+    } while (_tpHandoff->seq - seq >= 2);
+
+    return seq;
+}
@@ -0,0 +1,34 @@
+#ifndef __HANDOFF_H
+#define __HANDOFF_H
+
+#include <stdint.h>
+
+/*
+    单写单读的最新值交接 (无锁, 不关中断), 用于中断与前台之间传递一组数据
+    两个缓冲区交替写入, seq 每发布一次加1, 当前有效数据在 slot[seq & 1]
+
+    写端写入未发布的缓冲区, 写完再发布, 读端看到的总是完整的一组
+    读端按 seq 校验: 读取期间写端最多发布一次 (没有覆盖正在读的缓冲区) 即有效, 否则重读
+    - 前台写、中断读: 中断不会被写端打断, 一次读取必然有效
+    - 中断写、前台读: 中断发布频率远高于读取耗时时才会重读
+*/
+typedef struct
+{
+    void *slot[2];              /* 两个缓冲区, 大小均为 size */
+    uint16_t size;              /* 一组数据的字节数 */
+    volatile uint32_t seq;      /* 发布次数 */
+}Handoff_T;
+
+/*
+    提供给用户调用的API
+*/
+/* 初始化 (两个缓冲区由调用者提供, 初始内容取 _slot0) */
+void handoff_init(Handoff_T * _tpHandoff, void * _slot0, void * _slot1, uint16_t _size);
+
+/* 写端: 发布一组新数据 */
+void handoff_write(Handoff_T * _tpHandoff, const void * _data);
+
+/* 读端: 读取最新一组数据, 返回该组的发布序号 */
+uint32_t handoff_read(const Handoff_T * _tpHandoff, void * _data);
+
+#endif
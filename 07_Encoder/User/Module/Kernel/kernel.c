@@ -0,0 +1,149 @@
+#include "kernel.h"
+
+/* 内核状态 */
+static struct
+{
+    const uint8_t *levels;              /* 各任务优先级 */
+    uint8_t count;                      /* 任务数 */
+    void (*dispatch)(uint8_t);          /* 执行任务 */
+    volatile uint32_t ready;            /* 就绪位图 */
+    volatile uint8_t active_level;      /* 当前执行的优先级 */
+} kernel = {
+    .active_level = KERNEL_IDLE_LEVEL,
+};
+
+/* 就绪位图中最高优先级的任务 (最低的置位位) */
+static inline uint8_t kernel_highest(uint32_t _ready)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint8_t)__builtin_ctz(_ready);
+#else
+    uint8_t i = 0;
+    while (!(_ready & 1u)) { _ready >>= 1; i++; }
+    return i;
+#endif
+}
+
+/*******************************************************************************
+ * @brief 就绪任务中有比 _level 更高优先级的则挂起 PendSV (关中断时调用)
+ *******************************************************************************/
+static void kernel_schedule(uint8_t _level)
+{
+    uint32_t ready = kernel.ready;
+
+    if (ready != 0 && kernel.levels[kernel_highest(ready)] < _level)
+    {
+        kernel_port_pend();
+    }
+}
+
+/*******************************************************************************
+ * @brief 初始化
+ * @param {const uint8_t *} _levels 各任务优先级 (0最高), 须按任务下标非递减
+ * @param {uint8_t} _count 任务数 (不超过 KERNEL_MAX_TASKS)
+ * @param {void (*)(uint8_t)} _dispatch 执行第 _index 个任务
+ * @return {*}
+ *******************************************************************************/
+void kernel_init(const uint8_t * _levels, uint8_t _count, void (* _dispatch)(uint8_t _index))
+{
+    kernel.levels = _levels;
+    kernel.count = _count > KERNEL_MAX_TASKS ? KERNEL_MAX_TASKS : _count;
+    kernel.dispatch = _dispatch;
+    kernel.ready = 0;
+    kernel.active_level = KERNEL_IDLE_LEVEL;
+    kernel_port_init();
+}
+
+/*******************************************************************************
+ * @brief 激活任务
+ * @param {uint32_t} _mask 第i位 = 第i个任务
+ * @return {*}
+ * @note 已激活尚未执行的任务再次激活只执行一次
+ *******************************************************************************/
+void kernel_post(uint32_t _mask)
+{
+    if (_mask == 0) return;
+
+    uint32_t state = kernel_port_irq_save();
+    kernel.ready |= _mask;
+    kernel_schedule(kernel.active_level);
+    kernel_port_irq_restore(state);
+}
+
+/*******************************************************************************
+ * @brief 已激活尚未开始执行的任务
+ * @return {uint32_t} 就绪位图
+ *******************************************************************************/
+uint32_t kernel_pending(void)
+{
+    return kernel.ready;
+}
+
+/*******************************************************************************
+ * @brief 当前执行的优先级
+ * @return {uint8_t} 0最高, 空闲为 KERNEL_IDLE_LEVEL
+ *******************************************************************************/
+uint8_t kernel_active_level(void)
+{
+    return kernel.active_level;
+}
+
+/*******************************************************************************
+ * @brief 优先级天花板锁
+ * @param {uint8_t} _ceiling 天花板, 优先级不高于它的任务暂不抢占 (0 = 锁住所有任务)
+ * @return {uint8_t} 原优先级, 交给 kernel_unlock
+ * @note 只影响任务间抢占, 中断照常响应; 可嵌套
+ *******************************************************************************/
+uint8_t kernel_lock(uint8_t _ceiling)
+{
+    uint32_t state = kernel_port_irq_save();
+    uint8_t prev = kernel.active_level;
+
+    if (_ceiling < prev) kernel.active_level = _ceiling;
+    kernel_port_irq_restore(state);
+    return prev;
+}
+
+/*******************************************************************************
+ * @brief 解除天花板锁
+ * @param {uint8_t} _prev kernel_lock 的返回值
+ * @return {*}
+ * @note 锁定期间激活的高优先级任务在这里得到执行
+ *******************************************************************************/
+void kernel_unlock(uint8_t _prev)
+{
+    uint32_t state = kernel_port_irq_save();
+
+    kernel.active_level = _prev;
+    kernel_schedule(_prev);
+    kernel_port_irq_restore(state);
+}
+
+/*******************************************************************************
+ * @brief 激活器: 依次执行优先级高于被抢占者的就绪任务
+ * @return {*}
+ * @note 由 PendSV 切到线程模式后调用, 进入和返回时均关中断, 执行任务时开中断;
+ *       执行期间再次挂起的 PendSV 会嵌套调用本函数, 被抢占的激活器在栈上等待
+ *******************************************************************************/
+void kernel_activate(void)
+{
+    uint8_t level_in = kernel.active_level;
+    uint32_t ready;
+
+    while ((ready = kernel.ready) != 0)
+    {
+        uint8_t index = kernel_highest(ready);
+        uint8_t level = kernel.levels[index];
+
+        if (level >= level_in) break;   // 不比被抢占者优先, 留给它返回后执行
+
+        kernel.ready = ready & ~(1u << index);
+        kernel.active_level = level;
+
+        kernel_port_irq_restore(0);
+        kernel.dispatch(index);
+        kernel_port_irq_save();
+    }
+
+    kernel.active_level = level_in;
+}
@@ -0,0 +1,60 @@
+#ifndef __KERNEL_H
+#define __KERNEL_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 任务数上限 (就绪位图为32位) */
+#define KERNEL_MAX_TASKS    32
+
+/* 空闲优先级: 没有任务在执行 (主循环) */
+#define KERNEL_IDLE_LEVEL   0xFF
+
+/*
+    抢占式运行到完成内核 (单栈)
+    - 任务是普通函数, 每次激活从头执行到返回, 不阻塞等待, 因此所有任务共用主栈
+    - 每个任务有一个优先级(level, 0最高), 同级任务之间不抢占, 按任务下标顺序执行
+    - 就绪位图: 第i位 = 第i个任务已激活尚未开始执行; 任务表须按优先级排序, 最低的置位位即最高优先级
+    - 激活任务 (kernel_post) 后, 若其优先级高于正在执行的任务则挂起 PendSV,
+      由 PendSV 切到线程模式执行激活器, 被抢占的任务在栈上等待, 高优先级任务执行完后继续
+    - 中断仍可抢占任何任务; 任务间共享的数据用 kernel_lock 提升优先级天花板保护
+*/
+
+/*
+    提供给用户调用的API
+*/
+/* 初始化 (_levels[i] 为第i个任务的优先级, 须非递减; _dispatch 执行第i个任务) */
+void kernel_init(const uint8_t * _levels, uint8_t _count, void (* _dispatch)(uint8_t _index));
+
+/* 激活任务 (中断或任务中调用, _mask 第i位 = 第i个任务) */
+void kernel_post(uint32_t _mask);
+
+/* 已激活尚未开始执行的任务 */
+uint32_t kernel_pending(void);
+
+/* 当前执行的优先级 (空闲为 KERNEL_IDLE_LEVEL) */
+uint8_t kernel_active_level(void);
+
+/* 优先级天花板锁: 不高于 _ceiling 的任务暂不抢占, 返回原优先级供 kernel_unlock 恢复 */
+uint8_t kernel_lock(uint8_t _ceiling);
+void kernel_unlock(uint8_t _prev);
+
+/* 激活器: 由移植层在线程模式、关中断时调用, 返回时仍关中断 */
+void kernel_activate(void);
+
+/*
+    移植层 (kernel_port.c)
+*/
+void kernel_port_init(void);            /* PendSV 设为最低优先级 */
+uint32_t kernel_port_irq_save(void);    /* 关中断, 返回原状态 */
+void kernel_port_irq_restore(uint32_t _state);
+void kernel_port_pend(void);            /* 挂起 PendSV */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
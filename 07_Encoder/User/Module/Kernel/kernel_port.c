@@ -0,0 +1,116 @@
+#include "kernel.h"
+#include "stm32f4xx.h"
+
+/*
+    Cortex-M4F 移植 (ARMCLANG / GCC 内联汇编)
+
+    PendSV 设为最低优先级, 只会在所有中断返回后、从线程模式进入:
+    1. PendSV 在自己的异常栈帧下方伪造一个新的异常栈帧 (PC = kernel_activate, LR = kernel_thread_ret),
+       然后异常返回, 于是 CPU 回到线程模式执行 kernel_activate, 被抢占的代码仍压在栈上
+    2. kernel_activate 执行完所有更高优先级的就绪任务后返回到 kernel_thread_ret
+    3. kernel_thread_ret 触发 NMI, NMI 丢弃自己的栈帧, 用 PendSV 保存的 EXC_RETURN 返回,
+       硬件弹出原来的栈帧, 被抢占的代码继续执行
+    所有任务共用主栈, 抢占一层只多占用两个异常栈帧; 临界区用 PRIMASK (开关中断都很短)
+    注意: NMI 被内核占用, 不能再开启 RCC 时钟安全系统 (CSS)
+*/
+
+/*******************************************************************************
+ * @brief 初始化: PendSV 设为最低优先级
+ * @return {*}
+ *******************************************************************************/
+void kernel_port_init(void)
+{
+    NVIC_SetPriority(PendSV_IRQn, (1u << __NVIC_PRIO_BITS) - 1u);
+}
+
+/*******************************************************************************
+ * @brief 关中断
+ * @return {uint32_t} 原 PRIMASK
+ *******************************************************************************/
+uint32_t kernel_port_irq_save(void)
+{
+    uint32_t state = __get_PRIMASK();
+    __disable_irq();
+    return state;
+}
+
+/*******************************************************************************
+ * @brief 恢复中断状态
+ * @param {uint32_t} _state kernel_port_irq_save 的返回值 (0 = 开中断)
+ * @return {*}
+ *******************************************************************************/
+void kernel_port_irq_restore(uint32_t _state)
+{
+    __set_PRIMASK(_state);
+}
+
+/*******************************************************************************
+ * @brief 挂起 PendSV
+ * @return {*}
+ * @note 在中断中调用时, 所有中断返回后才会执行
+ *******************************************************************************/
+void kernel_port_pend(void)
+{
+    SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+}
+
+/* kernel_activate 返回后执行 (线程模式, 关中断) */
+__attribute__((naked, used)) static void kernel_thread_ret(void)
+{
+    __asm volatile (
+        /* 清除 CONTROL.FPCA, NMI 压入基本栈帧 (8个字), 与下面 NMI_Handler 丢弃的大小一致 */
+        "  MRS   r0, CONTROL        \n"
+        "  BIC   r0, r0, #4         \n"
+        "  MSR   CONTROL, r0        \n"
+        "  ISB                      \n"
+        /* 触发 NMI (ICSR.NMIPENDSET), 不受 PRIMASK 屏蔽 */
+        "  LDR   r0, =0xE000ED04    \n"
+        "  MOV   r1, #1             \n"
+        "  LSL   r1, r1, #31        \n"
+        "  STR   r1, [r0]           \n"
+        "  B     .                  \n"     /* 不会执行到这里 */
+    );
+}
+
+/*******************************************************************************
+ * @brief PendSV: 伪造异常栈帧, 返回到线程模式执行 kernel_activate
+ * @return {*}
+ *******************************************************************************/
+__attribute__((naked)) void PendSV_Handler(void)
+{
+    __asm volatile (
+        "  PUSH  {r0, lr}           \n"     /* 保存 EXC_RETURN (r0 保持8字节对齐) */
+        "  CPSID i                  \n"
+        /* 清除 PendSV 挂起位 (ICSR.PENDSVCLR), 激活器执行期间可再次挂起 */
+        "  LDR   r3, =0xE000ED04    \n"
+        "  MOV   r1, #1             \n"
+        "  LSL   r1, r1, #27        \n"
+        "  STR   r1, [r3]           \n"
+        /* 伪造栈帧: xPSR = Thumb位, PC = kernel_activate, LR = kernel_thread_ret */
+        "  LSR   r3, r1, #3         \n"     /* r3 = 1 << 24 */
+        "  LDR   r2, =kernel_activate \n"
+        "  SUB   r2, r2, #1         \n"     /* 栈帧中的PC不带Thumb位 */
+        "  LDR   r1, =kernel_thread_ret \n"
+        "  SUB   sp, sp, #(8*4)     \n"
+        "  ADD   r0, sp, #(5*4)     \n"
+        "  STM   r0!, {r1-r3}       \n"
+        /* 返回到线程模式、主栈、基本栈帧 */
+        "  MOV   r0, #6             \n"
+        "  MVN   r0, r0             \n"     /* r0 = 0xFFFFFFF9 */
+        "  DSB                      \n"
+        "  BX    r0                 \n"
+    );
+}
+
+/*******************************************************************************
+ * @brief NMI: 丢弃自己的栈帧, 从 PendSV 保存的 EXC_RETURN 返回到被抢占的代码
+ * @return {*}
+ *******************************************************************************/
+__attribute__((naked)) void NMI_Handler(void)
+{
+    __asm volatile (
+        "  ADD   sp, sp, #(8*4)     \n"
+        "  CPSIE i                  \n"
+        "  POP   {r0, pc}           \n"
+    );
+}
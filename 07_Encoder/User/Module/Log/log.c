@@ -0,0 +1,349 @@
+#include "log.h"
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+
+/* 参数类别 */
+typedef enum
+{
+    LOG_ARG_NONE = 0,       /* 不取参数 (%n 或无法识别) */
+    LOG_ARG_INT,            /* d i */
+    LOG_ARG_UINT,           /* u o x X */
+    LOG_ARG_CHAR,           /* c */
+    LOG_ARG_FLOAT,          /* f F e E g G a A */
+    LOG_ARG_STR,            /* s */
+    LOG_ARG_PTR,            /* p */
+}LogArg_E;
+
+/* 长度修饰 */
+typedef enum
+{
+    LOG_LEN_NONE = 0,       /* 无 */
+    LOG_LEN_SHORT,          /* h: 按 int 打包, 格式化时截为 short */
+    LOG_LEN_CHAR,           /* hh: 按 int 打包, 格式化时截为 char */
+    LOG_LEN_LONG,           /* l */
+    LOG_LEN_LLONG,          /* ll, j */
+    LOG_LEN_SIZE,           /* z, t */
+    LOG_LEN_LDOUBLE,        /* L */
+}LogLen_E;
+
+/* 一个转换说明 */
+typedef struct
+{
+    const char *flags;      /* 标志起点 */
+    uint8_t flags_len;      /* 标志字符数 */
+    uint8_t star_width;     /* 宽度由参数给出 */
+    uint8_t star_prec;      /* 精度由参数给出 */
+    int32_t width;          /* 宽度, -1 = 未指定 */
+    int32_t prec;           /* 精度, -1 = 未指定 */
+    LogLen_E length;
+    LogArg_E arg;
+    char conv;              /* 转换字符 */
+}LogSpec_T;
+
+/* 解析 '%' 之后的转换说明, 返回转换字符之后的位置 */
+static const char *log_parse(const char * _p, LogSpec_T * _tpSpec)
+{
+    _tpSpec->flags = _p;
+    while (*_p == '-' || *_p == '+' || *_p == ' ' || *_p == '#' || *_p == '0') _p++;
+    _tpSpec->flags_len = (uint8_t)(_p - _tpSpec->flags);
+
+    _tpSpec->star_width = 0;
+    _tpSpec->width = -1;
+    if (*_p == '*')
+    {
+        _tpSpec->star_width = 1;
+        _p++;
+    }
+    else if (*_p >= '0' && *_p <= '9')
+    {
+        _tpSpec->width = 0;
+        while (*_p >= '0' && *_p <= '9') _tpSpec->width = _tpSpec->width * 10 + (*_p++ - '0');
+    }
+
+    _tpSpec->star_prec = 0;
+    _tpSpec->prec = -1;
+    if (*_p == '.')
+    {
+        _p++;
+        _tpSpec->prec = 0;
+        if (*_p == '*')
+        {
+            _tpSpec->star_prec = 1;
+            _p++;
+        }
+        else
+        {
+            while (*_p >= '0' && *_p <= '9') _tpSpec->prec = _tpSpec->prec * 10 + (*_p++ - '0');
+        }
+    }
+
+    _tpSpec->length = LOG_LEN_NONE;
+    for (;;)
+    {
+        if (*_p == 'l' && _p[1] == 'l') { _tpSpec->length = LOG_LEN_LLONG; _p += 2; }
+        else if (*_p == 'l') { _tpSpec->length = LOG_LEN_LONG; _p++; }
+        else if (*_p == 'j') { _tpSpec->length = LOG_LEN_LLONG; _p++; }
+        else if (*_p == 'z' || *_p == 't') { _tpSpec->length = LOG_LEN_SIZE; _p++; }
+        else if (*_p == 'L') { _tpSpec->length = LOG_LEN_LDOUBLE; _p++; }
+        else if (*_p == 'h' && _p[1] == 'h') { _tpSpec->length = LOG_LEN_CHAR; _p += 2; }
+        else if (*_p == 'h') { _tpSpec->length = LOG_LEN_SHORT; _p++; }
+        else break;
+    }
+
+    _tpSpec->conv = *_p;
+    switch (*_p)
+    {
+        case 'd': case 'i':
+            _tpSpec->arg = LOG_ARG_INT; break;
+        case 'u': case 'o': case 'x': case 'X':
+            _tpSpec->arg = LOG_ARG_UINT; break;
+        case 'c':
+            _tpSpec->arg = LOG_ARG_CHAR; break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            _tpSpec->arg = LOG_ARG_FLOAT; break;
+        case 's':
+            _tpSpec->arg = LOG_ARG_STR; break;
+        case 'p':
+            _tpSpec->arg = LOG_ARG_PTR; break;
+        default:
+            _tpSpec->arg = LOG_ARG_NONE; break;
+    }
+    if (*_p) _p++;
+
+    return _p;
+}
+
+/* 追加 _n 字节, 放不下返回0 */
+static uint8_t log_put(uint8_t * _out, uint32_t _size, uint32_t * _len, const void * _data, uint32_t _n)
+{
+    if (*_len + _n > _size) return 0;
+    memcpy(_out + *_len, _data, _n);
+    *_len += _n;
+    return 1;
+}
+
+/* 取出 _n 字节, 不足返回0 */
+static uint8_t log_get(const uint8_t * _args, uint32_t _len, uint32_t * _pos, void * _data, uint32_t _n)
+{
+    if (*_pos + _n > _len) return 0;
+    memcpy(_data, _args + *_pos, _n);
+    *_pos += _n;
+    return 1;
+}
+
+/*******************************************************************************
+ * @brief 打包参数
+ * @param {uint8_t *} _out 输出
+ * @param {uint32_t} _size 输出空间(字节)
+ * @param {const char *} _fmt 格式串
+ * @param {va_list} _args 可变参数
+ * @return {uint32_t} 打包的字节数
+ * @note 只扫描格式串、拷贝参数, 不做任何数值到文本的转换; 空间不足时其后的参数全部丢弃
+ *******************************************************************************/
+uint32_t log_pack(uint8_t * _out, uint32_t _size, const char * _fmt, va_list _args)
+{
+    uint32_t len = 0;
+    LogSpec_T spec;
+
+    while (*_fmt)
+    {
+        if (*_fmt++ != '%') continue;
+        if (*_fmt == '%') { _fmt++; continue; }
+
+        _fmt = log_parse(_fmt, &spec);
+
+        if (spec.star_width)
+        {
+            int32_t v = va_arg(_args, int);
+            if (!log_put(_out, _size, &len, &v, 4)) return len;
+        }
+        if (spec.star_prec)
+        {
+            int32_t v = va_arg(_args, int);
+            if (!log_put(_out, _size, &len, &v, 4)) return len;
+        }
+
+        switch (spec.arg)
+        {
+            case LOG_ARG_INT:
+            case LOG_ARG_UINT:
+            case LOG_ARG_CHAR:
+            {
+                if (spec.length == LOG_LEN_LLONG)
+                {
+                    int64_t v = va_arg(_args, long long);
+                    if (!log_put(_out, _size, &len, &v, 8)) return len;
+                }
+                else
+                {
+                    int32_t v = spec.length == LOG_LEN_LONG ? (int32_t)va_arg(_args, long)
+                              : spec.length == LOG_LEN_SIZE ? (int32_t)va_arg(_args, size_t)
+                              : (int32_t)va_arg(_args, int);
+                    if (!log_put(_out, _size, &len, &v, 4)) return len;
+                }
+                break;
+            }
+            case LOG_ARG_FLOAT:
+            {
+                float v = spec.length == LOG_LEN_LDOUBLE ? (float)va_arg(_args, long double)
+                                                          : (float)va_arg(_args, double);
+                if (!log_put(_out, _size, &len, &v, 4)) return len;
+                break;
+            }
+            case LOG_ARG_STR:
+            {
+                const char *s = va_arg(_args, const char *);
+                uint32_t n = 0;
+                if (s == NULL) s = "(null)";
+                while (n < LOG_STR_MAX && s[n]) n++;
+                if (len + n + 1 > _size) return len;
+                log_put(_out, _size, &len, s, n);
+                _out[len++] = 0;
+                break;
+            }
+            case LOG_ARG_PTR:
+            {
+                uint32_t v = (uint32_t)(uintptr_t)va_arg(_args, void *);
+                if (!log_put(_out, _size, &len, &v, 4)) return len;
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    return len;
+}
+
+/*******************************************************************************
+ * @brief 按格式串和打包的参数格式化为文本
+ * @param {char *} _out 输出
+ * @param {uint32_t} _size 输出空间(字节, 含结尾0)
+ * @param {const char *} _fmt 格式串 (与打包时相同)
+ * @param {const uint8_t *} _args 打包的参数
+ * @param {uint32_t} _len 打包的字节数
+ * @return {uint32_t} 文本长度
+ * @note 每个转换说明单独调用一次 snprintf, 直接写入 _out: 整数统一按 ll 格式化, 与主机的 long 宽度无关;
+ *       h/hh 先截为 short/char 再格式化
+ *******************************************************************************/
+uint32_t log_format(char * _out, uint32_t _size, const char * _fmt, const uint8_t * _args, uint32_t _len)
+{
+    uint32_t out_len = 0;
+    uint32_t pos = 0;
+    LogSpec_T spec;
+    char conv[32];      /* 重建的转换说明 */
+
+    if (_size == 0) return 0;
+
+    while (*_fmt)
+    {
+        char *dst = _out + out_len;
+        uint32_t room = _size - out_len;    /* 含结尾0, 至少为1 */
+        int n = 0;
+
+        if (*_fmt != '%' || _fmt[1] == '%')
+        {
+            if (*_fmt == '%') _fmt++;
+            if (out_len + 1 < _size) _out[out_len++] = *_fmt;
+            _fmt++;
+            continue;
+        }
+
+        _fmt = log_parse(_fmt + 1, &spec);
+
+        // 宽度/精度直接写进转换说明, 之后只传一个参数
+        int32_t width = spec.width;
+        int32_t prec = spec.prec;
+        uint8_t ok = 1;
+        if (spec.star_width) ok &= log_get(_args, _len, &pos, &width, 4);
+        if (spec.star_prec) ok &= log_get(_args, _len, &pos, &prec, 4);
+
+        // 负的宽度参数表示左对齐
+        uint8_t has_width = spec.star_width || width >= 0;
+        int c = snprintf(conv, sizeof(conv), "%%%.*s%s", spec.flags_len, spec.flags, has_width && width < 0 ? "-" : "");
+        if (has_width) c += snprintf(conv + c, sizeof(conv) - c, "%ld", (long)(width < 0 ? -width : width));
+        if (prec >= 0) c += snprintf(conv + c, sizeof(conv) - c, ".%ld", (long)prec);
+
+        switch (spec.arg)
+        {
+            case LOG_ARG_INT:
+            case LOG_ARG_UINT:
+            {
+                long long v = 0;
+                if (spec.length == LOG_LEN_LLONG)
+                {
+                    int64_t v64 = 0;
+                    ok &= log_get(_args, _len, &pos, &v64, 8);
+                    v = v64;
+                }
+                else
+                {
+                    int32_t v32 = 0;
+                    ok &= log_get(_args, _len, &pos, &v32, 4);
+                    if (spec.arg == LOG_ARG_INT)
+                    {
+                        v = spec.length == LOG_LEN_SHORT ? (long long)(short)v32
+                          : spec.length == LOG_LEN_CHAR ? (long long)(signed char)v32
+                          : (long long)v32;
+                    }
+                    else
+                    {
+                        v = spec.length == LOG_LEN_SHORT ? (long long)(unsigned short)v32
+                          : spec.length == LOG_LEN_CHAR ? (long long)(unsigned char)v32
+                          : (long long)(uint32_t)v32;
+                    }
+                }
+                snprintf(conv + c, sizeof(conv) - c, "ll%c", spec.conv);
+                if (!ok) break;
+                if (spec.arg == LOG_ARG_INT) n = snprintf(dst, room, conv, v);
+                else n = snprintf(dst, room, conv, (unsigned long long)v);
+                break;
+            }
+            case LOG_ARG_CHAR:
+            {
+                int32_t v = 0;
+                ok &= log_get(_args, _len, &pos, &v, 4);
+                snprintf(conv + c, sizeof(conv) - c, "c");
+                if (ok) n = snprintf(dst, room, conv, (int)v);
+                break;
+            }
+            case LOG_ARG_FLOAT:
+            {
+                float v = 0;
+                ok &= log_get(_args, _len, &pos, &v, 4);
+                snprintf(conv + c, sizeof(conv) - c, "%c", spec.conv);
+                if (ok) n = snprintf(dst, room, conv, (double)v);
+                break;
+            }
+            case LOG_ARG_STR:
+            {
+                const char *s = (const char *)_args + pos;
+                uint32_t end = pos;
+                while (end < _len && _args[end]) end++;
+                ok &= end < _len;
+                pos = ok ? end + 1 : _len;
+                snprintf(conv + c, sizeof(conv) - c, "s");
+                if (ok) n = snprintf(dst, room, conv, s);
+                break;
+            }
+            case LOG_ARG_PTR:
+            {
+                uint32_t v = 0;
+                ok &= log_get(_args, _len, &pos, &v, 4);
+                if (ok) n = snprintf(dst, room, "0x%08lx", (unsigned long)v);
+                break;
+            }
+            default:
+                break;
+        }
+
+        if (!ok) n = snprintf(dst, room, "?");
+
+        // 放不下时 snprintf 返回完整长度, 输出只到 _size - 1
+        if (n > 0) out_len += (uint32_t)n < room ? (uint32_t)n : room - 1;
+    }
+
+    _out[out_len] = '\0';
+    return out_len;
+}
@@ -0,0 +1,38 @@
+#ifndef __LOG_H
+#define __LOG_H
+
+#include <stdint.h>
+#include <stdarg.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    延迟格式化日志: 调用处只按格式串把参数原样打包, 格式化推迟到低优先级任务或主机端
+    参数按格式串中的转换说明依次打包 (小端), 格式串本身不打包:
+    - d i u o x X c 及 '*' 宽度/精度: 4字节; 带 ll/j 修饰时8字节; 带 h/hh 修饰时仍为4字节, 格式化时截为 short/char
+    - f F e E g G a A: float 4字节 (可变参数中的double转为float)
+    - s: 字符串内容, 最多 LOG_STR_MAX 字节, 以 0 结尾
+    - p: 4字节
+    - %n 不支持 (跳过, 不取参数)
+    打包和格式化由同一个解析器完成, 设备端与主机端工具共用本文件
+*/
+
+/* %s 参数最多保存的字节数 (不含结尾0) */
+#define LOG_STR_MAX     24
+
+/*
+    提供给用户调用的API
+*/
+/* 打包参数: 返回打包的字节数; 放不下的参数及其之后的参数丢弃 */
+uint32_t log_pack(uint8_t * _out, uint32_t _size, const char * _fmt, va_list _args);
+
+/* 按格式串和打包的参数格式化为文本 (缺少的参数显示为 ?), 返回文本长度 (不超过 _size - 1) */
+uint32_t log_format(char * _out, uint32_t _size, const char * _fmt, const uint8_t * _args, uint32_t _len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
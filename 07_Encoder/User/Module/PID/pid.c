@@ -33,6 +33,13 @@ void pid_init(PID_T * _tpPID, float _kp, float _ki, float _kd, float _target, fl
     _tpPID->p_out = 0;         // P输出清零
     _tpPID->i_out = 0;         // I输出清零
     _tpPID->d_out = 0;         // D输出清零
+    _tpPID->out_min = -_limit; // 非对称限幅默认与对称限幅一致
+    _tpPID->out_max = _limit;
+    _tpPID->sp_weight = 1.0f;  // 设定值全权重
+    _tpPID->d_tau = 0.0f;      // D项不滤波
+    _tpPID->kb = 0.0f;
+    _tpPID->anti_windup = PID_AW_CONDITIONAL;
+    _tpPID->primed = 0;
 }
 
 /*******************************************************************************
@@ -73,6 +80,59 @@ void pid_set_params(PID_T * _tpPID, float _kp, float _ki, float _kd)
 void pid_set_limit(PID_T * _tpPID, float _limit)
 {
     _tpPID->limit = _limit;
+    _tpPID->out_min = -_limit;
+    _tpPID->out_max = _limit;
+}
+
+/*******************************************************************************
+ * @brief 设置非对称输出限幅
+ * @param {PID_T *} _tpPID 指向PID结构体的指针
+ * @param {float} _out_min 输出下限
+ * @param {float} _out_max 输出上限
+ * @return {*}
+ * @note 仅 pid_calculate_advanced 使用; 可每周期调用(如扣除前馈后的剩余余量)
+ *******************************************************************************/
+void pid_set_output_limits(PID_T * _tpPID, float _out_min, float _out_max)
+{
+    _tpPID->out_min = _out_min;
+    _tpPID->out_max = _out_max;
+}
+
+/*******************************************************************************
+ * @brief 设置P项设定值权重
+ * @param {PID_T *} _tpPID 指向PID结构体的指针
+ * @param {float} _weight 权重b (0~1), P = kp*(b*target - current)
+ * @return {*}
+ * @note b<1 时目标阶跃引起的P项突变按比例减小, 积分项仍按完整误差计算, 稳态无差
+ *******************************************************************************/
+void pid_set_setpoint_weight(PID_T * _tpPID, float _weight)
+{
+    _tpPID->sp_weight = _weight;
+}
+
+/*******************************************************************************
+ * @brief 设置D项滤波时间常数
+ * @param {PID_T *} _tpPID 指向PID结构体的指针
+ * @param {float} _tau 一阶低通时间常数(s), 0=不滤波
+ * @return {*}
+ * @note 一般取 Td/N, N=5~20
+ *******************************************************************************/
+void pid_set_d_filter(PID_T * _tpPID, float _tau)
+{
+    _tpPID->d_tau = _tau;
+}
+
+/*******************************************************************************
+ * @brief 设置抗积分饱和方式
+ * @param {PID_T *} _tpPID 指向PID结构体的指针
+ * @param {PID_AntiWindup} _mode 抗饱和方式
+ * @param {float} _kb 反算增益(1/s), 仅 PID_AW_BACK_CALC 使用, 常取 ki/kp
+ * @return {*}
+ *******************************************************************************/
+void pid_set_anti_windup(PID_T * _tpPID, PID_AntiWindup _mode, float _kb)
+{
+    _tpPID->anti_windup = (unsigned char)_mode;
+    _tpPID->kb = _kb;
 }
 
 /*******************************************************************************
@@ -90,6 +150,7 @@ void pid_reset(PID_T * _tpPID)
     _tpPID->p_out = 0;
     _tpPID->i_out = 0;
     _tpPID->d_out = 0;
+    _tpPID->primed = 0;
 }
 
 /*******************************************************************************
@@ -122,6 +183,62 @@ float pid_calculate_incremental(PID_T * _tpPID, float _current)
     return _tpPID->out;
 }
 
+/*******************************************************************************
+ * @brief 计算PID (带抗饱和的位置式)
+ * @param {PID_T *} _tpPID 指向PID结构体的指针
+ * @param {float} _current 当前值
+ * @param {float} _dt 距上次计算的时间(s)
+ * @return {float} PID计算后的输出值, 限制在 [out_min, out_max]
+ * @note 1. P = kp*(b*target - current), 设定值权重减小目标阶跃的冲击
+ *       2. D = -kd*d(current)/dt 经一阶低通, 目标阶跃不产生微分冲击
+ *       3. I = ∫ki*error*dt, 积分状态保存在 i_out, 修改ki时输出不跳变
+ *       4. 输出饱和时按 anti_windup 方式限制积分
+ *       ki/kd 为连续时间增益, 与 pid_calculate_positional 的每周期增益相差 dt 倍
+ *******************************************************************************/
+float pid_calculate_advanced(PID_T * _tpPID, float _current, float _dt)
+{
+    float unsat;
+
+    _tpPID->current = _current;
+    _tpPID->error = _tpPID->target - _current;
+
+    _tpPID->p_out = _tpPID->kp * (_tpPID->sp_weight * _tpPID->target - _current);
+
+    // 微分作用于测量值: 首次计算没有上一次测量值, 不做微分
+    if (_tpPID->primed && _dt > 0.0f) {
+        _tpPID->d_out = (_tpPID->d_tau * _tpPID->d_out - _tpPID->kd * (_current - _tpPID->last_current))
+                        / (_tpPID->d_tau + _dt);
+    } else {
+        _tpPID->d_out = 0;
+    }
+    _tpPID->last_current = _current;
+    _tpPID->primed = 1;
+
+    unsat = _tpPID->p_out + _tpPID->i_out + _tpPID->d_out;
+    _tpPID->out = pid_constrain(unsat, _tpPID->out_min, _tpPID->out_max);
+
+    // 积分 (在输出计算之后更新, 本周期的饱和状态决定是否/如何积分)
+    switch (_tpPID->anti_windup)
+    {
+    case PID_AW_CONDITIONAL:
+        if (!((unsat > _tpPID->out_max && _tpPID->error > 0) ||
+              (unsat < _tpPID->out_min && _tpPID->error < 0)))
+        {
+            _tpPID->i_out += _tpPID->ki * _tpPID->error * _dt;
+        }
+        break;
+    case PID_AW_BACK_CALC:
+        _tpPID->i_out += (_tpPID->ki * _tpPID->error + _tpPID->kb * (_tpPID->out - unsat)) * _dt;
+        break;
+    default:
+        _tpPID->i_out += _tpPID->ki * _tpPID->error * _dt;
+        break;
+    }
+
+    _tpPID->last_error = _tpPID->error;
+    return _tpPID->out;
+}
+
 /* ————————————————————————————————— PID相关的功能函数 ————————————————————————————————— */
 /*******************************************************************************
  * @brief 输出限幅函数
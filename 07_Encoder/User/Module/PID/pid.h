@@ -1,6 +1,18 @@
 #ifndef __PID_H
 #define __PID_H
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 抗积分饱和方式 (仅 pid_calculate_advanced 使用) */
+typedef enum
+{
+    PID_AW_NONE = 0,            /* 不处理 */
+    PID_AW_CONDITIONAL,         /* 条件积分: 输出饱和且误差继续推向饱和方向时停止积分 */
+    PID_AW_BACK_CALC            /* 反算: 按 (限幅后 - 限幅前) * kb 回拉积分 */
+} PID_AntiWindup;
+
 /* pid结构体 */
 typedef struct
 {
@@ -18,6 +30,16 @@ typedef struct
     float last_out;             /* 上一次执行量 */
 	float integral;				/* 积分(累加) */
 	float p_out,i_out,d_out;	/* 比例、积分、微分值 */
+
+    /* 以下仅 pid_calculate_advanced 使用, ki/kd 按连续时间理解(单位含 1/s) */
+    float out_min;              /* 输出下限 */
+    float out_max;              /* 输出上限 */
+    float sp_weight;            /* P项设定值权重 b: P = kp*(b*target - current) */
+    float d_tau;                /* D项一阶低通时间常数(s), 0=不滤波 */
+    float kb;                   /* 反算抗饱和增益(1/s) */
+    unsigned char anti_windup;  /* 抗饱和方式 PID_AntiWindup */
+    unsigned char primed;       /* 已记录上一次测量值 (首次计算不做微分) */
+    float last_current;         /* 上一次测量值 (微分作用于测量值) */
 }PID_T;
 
 /*
@@ -44,10 +66,29 @@ float pid_calculate_positional(PID_T * _tpPID, float _current);
 /* 计算增量式PID */
 float pid_calculate_incremental(PID_T * _tpPID, float _current);
 
+/* 设置非对称输出限幅 (advanced) */
+void pid_set_output_limits(PID_T * _tpPID, float _out_min, float _out_max);
+
+/* 设置P项设定值权重 (advanced) */
+void pid_set_setpoint_weight(PID_T * _tpPID, float _weight);
+
+/* 设置D项滤波时间常数 (advanced) */
+void pid_set_d_filter(PID_T * _tpPID, float _tau);
+
+/* 设置抗积分饱和方式 (advanced) */
+void pid_set_anti_windup(PID_T * _tpPID, PID_AntiWindup _mode, float _kb);
+
+/* 计算PID: 抗饱和 + 测量值微分(滤波) + 设定值权重 + 非对称限幅 */
+float pid_calculate_advanced(PID_T * _tpPID, float _current, float _dt);
+
 /* 限幅函数 */
 float pid_constrain(float value, float min, float max);
 
 /* 积分限幅函数 */
 void __attribute__((unused)) pid_app_limit_integral(PID_T *pid, float min, float max);
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif
@@ -0,0 +1,111 @@
+#include "pid_batch.h"
+
+/*******************************************************************************
+ * @brief 初始化批次
+ * @param {PIDBatch_T *} _tpBatch 指向批次结构体的指针
+ * @param {uint8_t} _count 控制器路数 (不超过 PID_BATCH_MAX)
+ * @param {float} _limit 对称输出限幅
+ * @return {*}
+ * @note 系数全部清零, 需要再用 pid_batch_set_gains 逐路设置
+ *******************************************************************************/
+void pid_batch_init(PIDBatch_T * _tpBatch, uint8_t _count, float _limit)
+{
+    if (_count > PID_BATCH_MAX) _count = PID_BATCH_MAX;
+    _tpBatch->count = _count;
+
+    for (uint8_t i = 0; i < PID_BATCH_MAX; i++)
+    {
+        _tpBatch->kp[i] = 0;
+        _tpBatch->ki_dt[i] = 0;
+        _tpBatch->kd_dt[i] = 0;
+        _tpBatch->d_alpha[i] = 0;
+        _tpBatch->kb_dt[i] = 0;
+        _tpBatch->sp_weight[i] = 1.0f;
+        _tpBatch->target[i] = 0;
+        _tpBatch->out_min[i] = -_limit;
+        _tpBatch->out_max[i] = _limit;
+    }
+    pid_batch_reset(_tpBatch);
+}
+
+/*******************************************************************************
+ * @brief 设置第 _index 路系数
+ * @param {PIDBatch_T *} _tpBatch 指向批次结构体的指针
+ * @param {uint8_t} _index 控制器下标
+ * @param {float} _kp _ki _kd 连续时间增益 (与 pid_calculate_advanced 相同)
+ * @param {float} _d_tau 微分滤波时间常数(s)
+ * @param {float} _sp_weight P项设定值权重
+ * @param {float} _kb 反算抗饱和增益(1/s)
+ * @param {float} _dt 控制周期(s)
+ * @return {*}
+ *******************************************************************************/
+void pid_batch_set_gains(PIDBatch_T * _tpBatch, uint8_t _index, float _kp, float _ki, float _kd,
+                         float _d_tau, float _sp_weight, float _kb, float _dt)
+{
+    if (_index >= PID_BATCH_MAX) return;
+
+    _tpBatch->kp[_index] = _kp;
+    _tpBatch->ki_dt[_index] = _ki * _dt;
+    _tpBatch->kd_dt[_index] = _kd / (_d_tau + _dt);
+    _tpBatch->d_alpha[_index] = _d_tau / (_d_tau + _dt);
+    _tpBatch->kb_dt[_index] = _kb * _dt;
+    _tpBatch->sp_weight[_index] = _sp_weight;
+}
+
+/*******************************************************************************
+ * @brief 重置所有路的状态
+ * @param {PIDBatch_T *} _tpBatch 指向批次结构体的指针
+ * @return {*}
+ *******************************************************************************/
+void pid_batch_reset(PIDBatch_T * _tpBatch)
+{
+    for (uint8_t i = 0; i < PID_BATCH_MAX; i++)
+    {
+        _tpBatch->p_out[i] = 0;
+        _tpBatch->integral[i] = 0;
+        _tpBatch->d_out[i] = 0;
+        _tpBatch->last_current[i] = 0;
+        _tpBatch->out[i] = 0;
+    }
+    _tpBatch->primed = 0;
+}
+
+/*******************************************************************************
+ * @brief 批量计算
+ * @param {PIDBatch_T *} _tpBatch 指向批次结构体的指针
+ * @param {const float *} _current 各路测量值, 长度不小于 count
+ * @return {*}
+ * @note 首次计算没有上一次测量值, 用本次测量值代替 (微分为0), 循环体内无分支跳转到其他函数
+ *******************************************************************************/
+void pid_batch_update(PIDBatch_T * _tpBatch, const float * _current)
+{
+    const uint8_t n = _tpBatch->count;
+
+    if (!_tpBatch->primed)
+    {
+        for (uint8_t i = 0; i < n; i++)
+        {
+            _tpBatch->last_current[i] = _current[i];
+        }
+        _tpBatch->primed = 1;
+    }
+
+    for (uint8_t i = 0; i < n; i++)
+    {
+        float y = _current[i];
+        float error = _tpBatch->target[i] - y;
+        float p_out = _tpBatch->kp[i] * (_tpBatch->sp_weight[i] * _tpBatch->target[i] - y);
+        float d_out = _tpBatch->d_alpha[i] * _tpBatch->d_out[i] - _tpBatch->kd_dt[i] * (y - _tpBatch->last_current[i]);
+        float unsat = p_out + _tpBatch->integral[i] + d_out;
+
+        float out = unsat;
+        out = out > _tpBatch->out_max[i] ? _tpBatch->out_max[i] : out;
+        out = out < _tpBatch->out_min[i] ? _tpBatch->out_min[i] : out;
+
+        _tpBatch->integral[i] += _tpBatch->ki_dt[i] * error + _tpBatch->kb_dt[i] * (out - unsat);
+        _tpBatch->p_out[i] = p_out;
+        _tpBatch->d_out[i] = d_out;
+        _tpBatch->last_current[i] = y;
+        _tpBatch->out[i] = out;
+    }
+}
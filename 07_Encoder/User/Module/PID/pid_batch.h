@@ -0,0 +1,64 @@
+#ifndef __PID_BATCH_H
+#define __PID_BATCH_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 一个批次最多的控制器数 */
+#define PID_BATCH_MAX   8
+
+/*
+    多路pid批量计算, 数组结构(SoA): 同一字段的各路数据连续存放,
+    一次调用按下标顺序更新所有控制器, 循环体无函数调用, 便于编译器流水/展开
+    算法与 pid_calculate_advanced (反算抗饱和) 一致, 控制周期固定, 与周期有关的系数预先算好
+*/
+typedef struct
+{
+    uint8_t count;                      /* 控制器路数 */
+    uint8_t primed;                     /* 已记录上一次测量值 (整批一起重置) */
+
+    /* 系数 */
+    float kp[PID_BATCH_MAX];            /* 比例 */
+    float ki_dt[PID_BATCH_MAX];         /* 积分 ki*dt */
+    float kd_dt[PID_BATCH_MAX];         /* 微分 kd/(tau+dt) */
+    float d_alpha[PID_BATCH_MAX];       /* 微分滤波 tau/(tau+dt) */
+    float kb_dt[PID_BATCH_MAX];         /* 反算抗饱和 kb*dt */
+    float sp_weight[PID_BATCH_MAX];     /* P项设定值权重 */
+
+    /* 输入/限幅 */
+    float target[PID_BATCH_MAX];        /* 目标值 */
+    float out_min[PID_BATCH_MAX];       /* 输出下限 */
+    float out_max[PID_BATCH_MAX];       /* 输出上限 */
+
+    /* 状态 */
+    float p_out[PID_BATCH_MAX];         /* 比例项 (最近一次计算) */
+    float integral[PID_BATCH_MAX];      /* 积分项 (输出单位) */
+    float d_out[PID_BATCH_MAX];         /* 微分项 (滤波后) */
+    float last_current[PID_BATCH_MAX];  /* 上一次测量值 */
+    float out[PID_BATCH_MAX];           /* 输出 */
+}PIDBatch_T;
+
+/*
+    提供给用户调用的API
+*/
+/* 初始化批次 (系数清零, 限幅为 ±limit) */
+void pid_batch_init(PIDBatch_T * _tpBatch, uint8_t _count, float _limit);
+
+/* 设置第 _index 路系数 (连续时间增益, _dt 为固定控制周期) */
+void pid_batch_set_gains(PIDBatch_T * _tpBatch, uint8_t _index, float _kp, float _ki, float _kd,
+                         float _d_tau, float _sp_weight, float _kb, float _dt);
+
+/* 重置所有路的状态 */
+void pid_batch_reset(PIDBatch_T * _tpBatch);
+
+/* 批量计算: _current[i] 为第i路测量值, 输出写入 _tpBatch->out[i] */
+void pid_batch_update(PIDBatch_T * _tpBatch, const float * _current);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
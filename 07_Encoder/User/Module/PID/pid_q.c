@@ -0,0 +1,134 @@
+#include "pid_q.h"
+
+/* ————————————————————————————————— 饱和运算 ————————————————————————————————— */
+
+/* 64位中间值饱和到32位 (Cortex-M4 上为 SMULL + 比较, 固定周期) */
+static inline int32_t pidq_sat32(int64_t x)
+{
+    if (x > INT32_MAX) return INT32_MAX;
+    if (x < INT32_MIN) return INT32_MIN;
+    return (int32_t)x;
+}
+
+/* Q16 乘法, 四舍五入 (直接截断会使积分每周期向负方向偏 0.5 LSB), 结果饱和 */
+static inline int32_t pidq_mul(int32_t a, int32_t b)
+{
+    return pidq_sat32(((int64_t)a * b + (1 << (PIDQ_SHIFT - 1))) >> PIDQ_SHIFT);
+}
+
+/* 饱和加法 */
+static inline int32_t pidq_add(int32_t a, int32_t b)
+{
+    return pidq_sat32((int64_t)a + b);
+}
+
+/* 饱和减法 (不对 b 取负, INT32_MIN 取负会溢出) */
+static inline int32_t pidq_sub(int32_t a, int32_t b)
+{
+    return pidq_sat32((int64_t)a - b);
+}
+
+static inline int32_t pidq_clamp(int32_t x, int32_t min, int32_t max)
+{
+    if (x < min) return min;
+    if (x > max) return max;
+    return x;
+}
+
+/*******************************************************************************
+ * @brief 由浮点参数生成定点pid
+ * @param {PIDQ_T *} _tpPID 指向定点pid结构体的指针
+ * @param {float} _kp _ki _kd 连续时间增益 (与 pid_calculate_advanced 相同)
+ * @param {float} _d_tau 微分滤波时间常数(s)
+ * @param {float} _sp_weight P项设定值权重
+ * @param {float} _kb 反算抗饱和增益(1/s)
+ * @param {float} _dt 控制周期(s), 定点版本周期固定
+ * @param {float} _in_scale 1个输入单位对应的浮点输入量 (如 1脉冲/周期 = x rpm)
+ * @return {*}
+ * @note 所有浮点运算都在这里完成, pidq_calculate 只有整数运算
+ *******************************************************************************/
+void pidq_init(PIDQ_T * _tpPID, float _kp, float _ki, float _kd, float _d_tau,
+               float _sp_weight, float _kb, float _dt, float _in_scale)
+{
+    _tpPID->kp = PIDQ_FROM_FLOAT(_kp * _in_scale);
+    _tpPID->ki_dt = PIDQ_FROM_FLOAT(_ki * _dt * _in_scale);
+    _tpPID->kd_dt = PIDQ_FROM_FLOAT(_kd * _in_scale / (_d_tau + _dt));
+    _tpPID->d_alpha = PIDQ_FROM_FLOAT(_d_tau / (_d_tau + _dt));
+    _tpPID->kb_dt = PIDQ_FROM_FLOAT(_kb * _dt);
+    _tpPID->sp_weight = PIDQ_FROM_FLOAT(_sp_weight);
+    _tpPID->target = 0;
+    _tpPID->out_min = INT32_MIN;
+    _tpPID->out_max = INT32_MAX;
+    pidq_reset(_tpPID);
+}
+
+/*******************************************************************************
+ * @brief 设置目标值
+ * @param {PIDQ_T *} _tpPID 指向定点pid结构体的指针
+ * @param {int32_t} _target 目标值(Q16)
+ * @return {*}
+ *******************************************************************************/
+void pidq_set_target(PIDQ_T * _tpPID, int32_t _target)
+{
+    _tpPID->target = _target;
+}
+
+/*******************************************************************************
+ * @brief 设置输出限幅
+ * @param {PIDQ_T *} _tpPID 指向定点pid结构体的指针
+ * @param {int32_t} _out_min 输出下限(Q16)
+ * @param {int32_t} _out_max 输出上限(Q16)
+ * @return {*}
+ *******************************************************************************/
+void pidq_set_output_limits(PIDQ_T * _tpPID, int32_t _out_min, int32_t _out_max)
+{
+    _tpPID->out_min = _out_min;
+    _tpPID->out_max = _out_max;
+}
+
+/*******************************************************************************
+ * @brief 重置
+ * @param {PIDQ_T *} _tpPID 指向定点pid结构体的指针
+ * @return {*}
+ * @note 清除积分、微分状态
+ *******************************************************************************/
+void pidq_reset(PIDQ_T * _tpPID)
+{
+    _tpPID->p_out = 0;
+    _tpPID->integral = 0;
+    _tpPID->d_out = 0;
+    _tpPID->last_current = 0;
+    _tpPID->primed = 0;
+    _tpPID->out = 0;
+}
+
+/*******************************************************************************
+ * @brief 计算定点pid
+ * @param {PIDQ_T *} _tpPID 指向定点pid结构体的指针
+ * @param {int32_t} _current 当前值(Q16)
+ * @return {int32_t} 输出(Q16), 限制在 [out_min, out_max]
+ * @note 算法与 pid_calculate_advanced (反算抗饱和) 一致:
+ *       P作用于 b*target - current, D作用于测量值并一阶滤波;
+ *       所有加法/乘法饱和, 无除法, 无数据相关的循环, 执行时间固定
+ *******************************************************************************/
+int32_t pidq_calculate(PIDQ_T * _tpPID, int32_t _current)
+{
+    int32_t error = pidq_sub(_tpPID->target, _current);
+    int32_t p_out = pidq_mul(_tpPID->kp, pidq_sub(pidq_mul(_tpPID->sp_weight, _tpPID->target), _current));
+    _tpPID->p_out = p_out;
+
+    // 微分作用于测量值: 首次计算没有上一次测量值, 不做微分
+    int32_t delta = _tpPID->primed ? pidq_sub(_current, _tpPID->last_current) : 0;
+    _tpPID->d_out = pidq_sub(pidq_mul(_tpPID->d_alpha, _tpPID->d_out), pidq_mul(_tpPID->kd_dt, delta));
+    _tpPID->last_current = _current;
+    _tpPID->primed = 1;
+
+    int32_t unsat = pidq_add(pidq_add(p_out, _tpPID->integral), _tpPID->d_out);
+    _tpPID->out = pidq_clamp(unsat, _tpPID->out_min, _tpPID->out_max);
+
+    // 反算抗饱和积分
+    int32_t back = pidq_mul(_tpPID->kb_dt, pidq_sub(_tpPID->out, unsat));
+    _tpPID->integral = pidq_add(_tpPID->integral, pidq_add(pidq_mul(_tpPID->ki_dt, error), back));
+
+    return _tpPID->out;
+}
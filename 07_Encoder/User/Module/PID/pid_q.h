@@ -0,0 +1,62 @@
+#ifndef __PID_Q_H
+#define __PID_Q_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 定点格式: Q16.16, 1.0 = 65536 */
+#define PIDQ_SHIFT      16
+#define PIDQ_ONE        (1 << PIDQ_SHIFT)
+
+/* 浮点 → Q16 (仅用于初始化/设目标, 不在控制热路径中使用) */
+#define PIDQ_FROM_FLOAT(x)  ((int32_t)((x) * (float)PIDQ_ONE + ((x) >= 0 ? 0.5f : -0.5f)))
+
+/* 定点pid结构体 (与 pid_calculate_advanced 同一算法) */
+typedef struct
+{
+    int32_t kp;                 /* 比例, Q16 (输出 / 输入单位) */
+    int32_t ki_dt;              /* 积分 ki*dt, Q16 */
+    int32_t kd_dt;              /* 微分 kd/(tau+dt), Q16 */
+    int32_t d_alpha;            /* 微分滤波 tau/(tau+dt), Q16 */
+    int32_t kb_dt;              /* 反算抗饱和 kb*dt, Q16 */
+    int32_t sp_weight;          /* P项设定值权重, Q16 */
+
+    int32_t target;             /* 目标值, Q16 输入单位 */
+    int32_t out_min;            /* 输出下限, Q16 */
+    int32_t out_max;            /* 输出上限, Q16 */
+
+    int32_t p_out;              /* 比例项(最近一次计算), Q16 输出单位 */
+    int32_t integral;           /* 积分项, Q16 输出单位 */
+    int32_t d_out;              /* 微分项(滤波后), Q16 输出单位 */
+    int32_t last_current;       /* 上一次测量值, Q16 */
+    uint8_t primed;             /* 已记录上一次测量值 */
+    int32_t out;                /* 输出, Q16 */
+}PIDQ_T;
+
+/*
+    提供给用户调用的API
+*/
+/* 由浮点参数生成定点pid (in_scale: 1个定点输入单位对应的浮点输入量) */
+void pidq_init(PIDQ_T * _tpPID, float _kp, float _ki, float _kd, float _d_tau,
+               float _sp_weight, float _kb, float _dt, float _in_scale);
+
+/* 设置目标值 (Q16) */
+void pidq_set_target(PIDQ_T * _tpPID, int32_t _target);
+
+/* 设置输出限幅 (Q16) */
+void pidq_set_output_limits(PIDQ_T * _tpPID, int32_t _out_min, int32_t _out_max);
+
+/* 重置 */
+void pidq_reset(PIDQ_T * _tpPID);
+
+/* 计算 (输入、输出均为Q16, 反算抗饱和) */
+int32_t pidq_calculate(PIDQ_T * _tpPID, int32_t _current);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,338 @@
+#include "param_store.h"
+
+#define PARAM_ERASED_WORD   0xFFFFFFFFu
+
+/* 内部功能函数 */
+static uint32_t param_read_word(const ParamStore_T * _tpStore, uint8_t _bank, uint32_t _offset);
+static uint32_t param_crc32(uint32_t _crc, const uint8_t * _pData, uint32_t _len);
+static uint32_t param_record_size(uint16_t _length);
+static uint8_t param_bank_is_blank(const ParamStore_T * _tpStore, uint8_t _bank);
+static void param_scan_bank(ParamStore_T * _tpStore);
+static ParamResult param_write_record(ParamStore_T * _tpStore, uint8_t _bank, uint32_t _offset,
+                                      const void * _pData, uint16_t _length, uint16_t _version);
+
+/*******************************************************************************
+ * @brief 初始化参数存储, 扫描flash
+ * @param {ParamStore_T *} _tpStore 存储状态
+ * @param {const ParamFlashOps_T *} _tpOps flash访问接口
+ * @return {*}
+ * @note 1. 两个bank都带有效标志时, 代数较大的为当前bank (代数回绕安全)
+ *       2. 备用bank若已是全0xFF, 下次压缩无需擦除
+ *******************************************************************************/
+void param_store_init(ParamStore_T * _tpStore, const ParamFlashOps_T * _tpOps)
+{
+    uint8_t valid[2];
+    uint32_t gen[2];
+    uint8_t i;
+
+    _tpStore->ops = _tpOps;
+    _tpStore->active = -1;
+    _tpStore->generation = 0;
+    _tpStore->write_offset = 0;
+    _tpStore->record_offset = 0;
+    _tpStore->record_length = 0;
+    _tpStore->record_version = 0;
+    _tpStore->record_count = 0;
+
+    for (i = 0; i < 2; i++)
+    {
+        valid[i] = (param_read_word(_tpStore, i, 0) == PARAM_STORE_BANK_MAGIC);
+        gen[i] = param_read_word(_tpStore, i, 4);
+    }
+
+    if (valid[0] && valid[1])
+        _tpStore->active = ((int32_t)(gen[1] - gen[0]) > 0) ? 1 : 0;
+    else if (valid[0])
+        _tpStore->active = 0;
+    else if (valid[1])
+        _tpStore->active = 1;
+
+    if (_tpStore->active >= 0)
+    {
+        _tpStore->generation = gen[_tpStore->active];
+        _tpStore->spare = (uint8_t)(_tpStore->active ^ 1);
+        param_scan_bank(_tpStore);
+    }
+    else
+    {
+        /* 首次使用: 优先选择已经是空白的bank */
+        _tpStore->spare = param_bank_is_blank(_tpStore, 0) ? 0 :
+                          (param_bank_is_blank(_tpStore, 1) ? 1 : 0);
+    }
+
+    _tpStore->spare_ready = param_bank_is_blank(_tpStore, _tpStore->spare);
+}
+
+/*******************************************************************************
+ * @brief 读取最新有效记录
+ * @param {const ParamStore_T *} _tpStore 存储状态
+ * @param {void *} _pData 输出缓冲区
+ * @param {uint16_t} _size 缓冲区大小, 记录更长时只拷贝前 _size 字节
+ * @param {uint16_t *} _pVersion 输出记录版本 (可为NULL)
+ * @param {uint16_t *} _pLength 输出记录数据长度 (可为NULL)
+ * @return {ParamResult} PARAM_OK / PARAM_EMPTY
+ *******************************************************************************/
+ParamResult param_store_load(const ParamStore_T * _tpStore, void * _pData, uint16_t _size,
+                             uint16_t * _pVersion, uint16_t * _pLength)
+{
+    const uint8_t *src;
+    uint8_t *dst = (uint8_t *)_pData;
+    uint16_t i, n;
+
+    if (_tpStore->active < 0 || _tpStore->record_offset == 0)
+        return PARAM_EMPTY;
+
+    src = _tpStore->ops->bank_base[_tpStore->active] + _tpStore->record_offset + 8;
+    n = _tpStore->record_length < _size ? _tpStore->record_length : _size;
+    for (i = 0; i < n; i++)
+        dst[i] = src[i];
+
+    if (_pVersion != 0)
+        *_pVersion = _tpStore->record_version;
+    if (_pLength != 0)
+        *_pLength = _tpStore->record_length;
+
+    return PARAM_OK;
+}
+
+/*******************************************************************************
+ * @brief 保存一条记录
+ * @param {ParamStore_T *} _tpStore 存储状态
+ * @param {const void *} _pData 数据
+ * @param {uint16_t} _length 数据长度
+ * @param {uint16_t} _version 数据版本
+ * @return {ParamResult} PARAM_OK / PARAM_BUSY / PARAM_TOO_LARGE / PARAM_ERROR
+ * @note 1. 当前bank有空间: 直接追加, 只有字编程, 不擦除
+ *       2. 当前bank已满: 写入备用bank后再写bank头, 掉电时旧bank仍然有效
+ *       3. 备用bank未擦除时返回 PARAM_BUSY, 调用者在空闲时 maintain 后重试
+ *******************************************************************************/
+ParamResult param_store_save(ParamStore_T * _tpStore, const void * _pData, uint16_t _length, uint16_t _version)
+{
+    const ParamFlashOps_T *ops = _tpStore->ops;
+    uint32_t size = param_record_size(_length);
+    ParamResult ret;
+
+    if (size > ops->bank_size - PARAM_STORE_BANK_HEADER)
+        return PARAM_TOO_LARGE;
+
+    /* 1. 当前bank追加 */
+    if (_tpStore->active >= 0 && _tpStore->write_offset + size <= ops->bank_size)
+    {
+        ret = param_write_record(_tpStore, (uint8_t)_tpStore->active, _tpStore->write_offset,
+                                 _pData, _length, _version);
+        if (ret != PARAM_OK)
+        {
+            /* 写失败的位置不可再用, 下次直接换bank */
+            _tpStore->write_offset = ops->bank_size;
+            return ret;
+        }
+
+        _tpStore->record_offset = _tpStore->write_offset;
+        _tpStore->record_length = _length;
+        _tpStore->record_version = _version;
+        _tpStore->record_count++;
+        _tpStore->write_offset += size;
+        return PARAM_OK;
+    }
+
+    /* 2. 压缩到备用bank */
+    if (!_tpStore->spare_ready)
+        return PARAM_BUSY;
+
+    uint8_t bank = _tpStore->spare;
+    uint32_t gen = (_tpStore->active >= 0) ? _tpStore->generation + 1 : 1;
+
+    _tpStore->spare_ready = 0;      /* 无论成功与否, 该bank都已写脏 */
+
+    ret = param_write_record(_tpStore, bank, PARAM_STORE_BANK_HEADER, _pData, _length, _version);
+    if (ret != PARAM_OK)
+        return ret;
+    if (ops->program_word(bank, 4, gen) != 0 ||
+        ops->program_word(bank, 0, PARAM_STORE_BANK_MAGIC) != 0)
+        return PARAM_ERROR;
+
+    /* 切换bank, 旧bank成为备用 (需擦除后才可用) */
+    _tpStore->spare = (uint8_t)(bank ^ 1);
+    _tpStore->spare_ready = param_bank_is_blank(_tpStore, _tpStore->spare);
+    _tpStore->active = (int8_t)bank;
+    _tpStore->generation = gen;
+    _tpStore->record_offset = PARAM_STORE_BANK_HEADER;
+    _tpStore->record_length = _length;
+    _tpStore->record_version = _version;
+    _tpStore->record_count = 1;
+    _tpStore->write_offset = PARAM_STORE_BANK_HEADER + size;
+
+    return PARAM_OK;
+}
+
+/*******************************************************************************
+ * @brief 是否有待执行的擦除
+ * @param {const ParamStore_T *} _tpStore 存储状态
+ * @return {uint8_t} 1=备用bank需要擦除
+ *******************************************************************************/
+uint8_t param_store_need_maintain(const ParamStore_T * _tpStore)
+{
+    return !_tpStore->spare_ready;
+}
+
+/*******************************************************************************
+ * @brief 擦除备用bank
+ * @param {ParamStore_T *} _tpStore 存储状态
+ * @return {ParamResult} PARAM_OK / PARAM_ERROR
+ * @note 擦除期间flash取指会被阻塞(F407单bank), 只应在电机停止时调用
+ *******************************************************************************/
+ParamResult param_store_maintain(ParamStore_T * _tpStore)
+{
+    if (_tpStore->spare_ready)
+        return PARAM_OK;
+
+    if (_tpStore->ops->erase_bank(_tpStore->spare) != 0)
+        return PARAM_ERROR;
+
+    _tpStore->spare_ready = 1;
+    return PARAM_OK;
+}
+
+/* ————————————————————————————————— 内部功能函数 ————————————————————————————————— */
+/*******************************************************************************
+ * @brief 读取bank中的一个字
+ *******************************************************************************/
+static uint32_t param_read_word(const ParamStore_T * _tpStore, uint8_t _bank, uint32_t _offset)
+{
+    const uint8_t *p = _tpStore->ops->bank_base[_bank] + _offset;
+
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/*******************************************************************************
+ * @brief CRC32 (多项式0xEDB88320, 与zlib一致)
+ * @note 逐位计算, 记录只有几百字节, 无需查表
+ *******************************************************************************/
+static uint32_t param_crc32(uint32_t _crc, const uint8_t * _pData, uint32_t _len)
+{
+    uint32_t i;
+    uint8_t j;
+
+    _crc = ~_crc;
+    for (i = 0; i < _len; i++)
+    {
+        _crc ^= _pData[i];
+        for (j = 0; j < 8; j++)
+            _crc = (_crc >> 1) ^ (0xEDB88320u & (0u - (_crc & 1u)));
+    }
+    return ~_crc;
+}
+
+/*******************************************************************************
+ * @brief 记录占用的字节数 (头8字节 + 对齐后的数据 + CRC 4字节)
+ *******************************************************************************/
+static uint32_t param_record_size(uint16_t _length)
+{
+    return 8u + (((uint32_t)_length + 3u) & ~3u) + 4u;
+}
+
+/*******************************************************************************
+ * @brief bank是否全为擦除状态
+ *******************************************************************************/
+static uint8_t param_bank_is_blank(const ParamStore_T * _tpStore, uint8_t _bank)
+{
+    uint32_t offset;
+
+    for (offset = 0; offset < _tpStore->ops->bank_size; offset += 4)
+    {
+        if (param_read_word(_tpStore, _bank, offset) != PARAM_ERASED_WORD)
+            return 0;
+    }
+    return 1;
+}
+
+/*******************************************************************************
+ * @brief 扫描当前bank的记录链
+ * @note 1. 头字为全FF处即写入位置
+ *       2. CRC错误的记录(写入时掉电)跳过, 其长度仍可用于定位下一条
+ *       3. 头字损坏时无法继续定位, 剩余空间作废, 下次保存直接换bank
+ *******************************************************************************/
+static void param_scan_bank(ParamStore_T * _tpStore)
+{
+    uint8_t bank = (uint8_t)_tpStore->active;
+    uint32_t bank_size = _tpStore->ops->bank_size;
+    uint32_t offset = PARAM_STORE_BANK_HEADER;
+
+    while (offset + 12u <= bank_size)
+    {
+        uint32_t head = param_read_word(_tpStore, bank, offset);
+
+        if (head == PARAM_ERASED_WORD)
+            break;
+
+        uint16_t length = (uint16_t)(head >> 16);
+        uint32_t size = param_record_size(length);
+
+        if ((head & 0xFFFFu) != PARAM_STORE_RECORD_MAGIC || offset + size > bank_size)
+        {
+            offset = bank_size;
+            break;
+        }
+
+        uint32_t crc_offset = offset + size - 4u;
+        uint32_t crc = param_crc32(0, _tpStore->ops->bank_base[bank] + offset, crc_offset - offset);
+
+        if (param_read_word(_tpStore, bank, crc_offset) == crc)
+        {
+            _tpStore->record_offset = offset;
+            _tpStore->record_length = length;
+            _tpStore->record_version = (uint16_t)param_read_word(_tpStore, bank, offset + 4);
+        }
+
+        _tpStore->record_count++;
+        offset += size;
+    }
+
+    _tpStore->write_offset = offset;
+}
+
+/*******************************************************************************
+ * @brief 写入一条记录: 头 → 数据 → CRC (CRC最后写入作为提交标志)
+ *******************************************************************************/
+static ParamResult param_write_record(ParamStore_T * _tpStore, uint8_t _bank, uint32_t _offset,
+                                      const void * _pData, uint16_t _length, uint16_t _version)
+{
+    const ParamFlashOps_T *ops = _tpStore->ops;
+    const uint8_t *src = (const uint8_t *)_pData;
+    uint32_t head[2];
+    uint32_t crc, i, word;
+
+    head[0] = PARAM_STORE_RECORD_MAGIC | ((uint32_t)_length << 16);
+    head[1] = _version | 0xFFFF0000u;
+
+    crc = 0;
+    for (i = 0; i < 2; i++)
+    {
+        uint8_t b[4] = {(uint8_t)head[i], (uint8_t)(head[i] >> 8), (uint8_t)(head[i] >> 16), (uint8_t)(head[i] >> 24)};
+
+        crc = param_crc32(crc, b, 4);
+        if (ops->program_word(_bank, _offset + i * 4u, head[i]) != 0)
+            return PARAM_ERROR;
+    }
+    _offset += 8;
+
+    for (i = 0; i < _length; i += 4)
+    {
+        uint8_t b[4];
+        uint8_t k;
+
+        for (k = 0; k < 4; k++)
+            b[k] = (i + k < _length) ? src[i + k] : 0xFF;
+
+        word = (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+        crc = param_crc32(crc, b, 4);
+        if (ops->program_word(_bank, _offset, word) != 0)
+            return PARAM_ERROR;
+        _offset += 4;
+    }
+
+    if (ops->program_word(_bank, _offset, crc) != 0)
+        return PARAM_ERROR;
+
+    return PARAM_OK;
+}
@@ -0,0 +1,89 @@
+#ifndef __PARAM_STORE_H
+#define __PARAM_STORE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    参数存储: 两个flash扇区(bank)轮换, 扇区内只追加记录
+
+    bank布局:
+        +0  bank标志 PARAM_STORE_BANK_MAGIC (最后写入, 作为bank提交标志)
+        +4  代数 generation (每次换bank加1, 代数大的为有效bank)
+        +8  记录1, 记录2, ...
+
+    记录布局 (按字对齐):
+        字0  magic(低16位) | 长度(高16位)
+        字1  版本(低16位) | 0xFFFF
+        ...  数据, 补齐到4字节 (填充0xFF)
+        末字 CRC32 (覆盖前面所有字, 最后写入, 作为记录提交标志)
+
+    最新一条CRC正确的记录有效. 当前bank写满时, 把新记录写入已擦除的备用bank
+    (即压缩, 旧记录全部作废), 擦除操作由 param_store_maintain 在空闲时执行
+*/
+
+#define PARAM_STORE_BANK_MAGIC      0x314D5250u     /* "PRM1" */
+#define PARAM_STORE_RECORD_MAGIC    0xA55Au
+#define PARAM_STORE_BANK_HEADER     8u              /* bank头字节数 */
+
+/* 返回值 */
+typedef enum
+{
+    PARAM_OK = 0,           /* 成功 */
+    PARAM_EMPTY,            /* 没有有效记录 */
+    PARAM_BUSY,             /* 备用bank未擦除, 需先调用 param_store_maintain */
+    PARAM_TOO_LARGE,        /* 记录超过bank容量 */
+    PARAM_ERROR             /* flash操作失败 */
+}ParamResult;
+
+/* flash访问接口 (板上为HAL实现, 主机上可用内存数组模拟) */
+typedef struct
+{
+    const uint8_t *bank_base[2];                                        /* 两个bank的读地址 */
+    uint32_t bank_size;                                                 /* 每个bank字节数 */
+    int (*program_word)(uint8_t _bank, uint32_t _offset, uint32_t _data);  /* 写一个字, 0=成功 */
+    int (*erase_bank)(uint8_t _bank);                                   /* 擦除整个bank, 0=成功 */
+}ParamFlashOps_T;
+
+/* 存储状态 */
+typedef struct
+{
+    const ParamFlashOps_T *ops;
+    int8_t active;              /* 当前有效bank, -1=无 */
+    uint8_t spare;              /* 下一次压缩写入的bank */
+    uint8_t spare_ready;        /* 备用bank已擦除 */
+    uint32_t generation;        /* 当前bank代数 */
+    uint32_t write_offset;      /* 下一条记录的写入偏移 */
+    uint32_t record_offset;     /* 最新有效记录偏移, 0=无 */
+    uint16_t record_length;     /* 最新有效记录数据长度 */
+    uint16_t record_version;    /* 最新有效记录版本 */
+    uint16_t record_count;      /* 当前bank中的记录数(含损坏的) */
+}ParamStore_T;
+
+/*
+    提供给用户调用的API
+*/
+/* 扫描两个bank, 找到最新有效记录 */
+void param_store_init(ParamStore_T * _tpStore, const ParamFlashOps_T * _tpOps);
+
+/* 读取最新有效记录, 最多拷贝 _size 字节 */
+ParamResult param_store_load(const ParamStore_T * _tpStore, void * _pData, uint16_t _size,
+                             uint16_t * _pVersion, uint16_t * _pLength);
+
+/* 追加一条记录 (不擦除, 需要擦除时返回 PARAM_BUSY) */
+ParamResult param_store_save(ParamStore_T * _tpStore, const void * _pData, uint16_t _length, uint16_t _version);
+
+/* 是否有待执行的擦除 */
+uint8_t param_store_need_maintain(const ParamStore_T * _tpStore);
+
+/* 擦除备用bank (耗时, 应在空闲时调用) */
+ParamResult param_store_maintain(ParamStore_T * _tpStore);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,112 @@
+#include "perf.h"
+#include <string.h>
+
+/* 编译器屏障: 单核上保证序号与数据的读写顺序 */
+#define PERF_BARRIER()  __asm volatile ("" ::: "memory")
+
+/*******************************************************************************
+ * @brief 清零统计 (不含 net_total)
+ *******************************************************************************/
+static void perf_slot_clear(PerfSlot_T * _tpSlot)
+{
+    _tpSlot->count = 0;
+    _tpSlot->min = UINT32_MAX;
+    _tpSlot->max = 0;
+    _tpSlot->sum = 0;
+    for (uint8_t i = 0; i < PERF_HIST_BINS; i++)
+    {
+        _tpSlot->hist[i] = 0;
+    }
+}
+
+/*******************************************************************************
+ * @brief 初始化
+ * @param {PerfSlot_T *} _tpSlot 指向统计槽的指针
+ * @return {*}
+ *******************************************************************************/
+void perf_slot_init(PerfSlot_T * _tpSlot)
+{
+    _tpSlot->seq = 0;
+    _tpSlot->reset_req = 0;
+    _tpSlot->net_total = 0;
+    perf_slot_clear(_tpSlot);
+}
+
+/*******************************************************************************
+ * @brief 执行时间对应的直方图格
+ * @param {uint32_t} _cycles 执行时间(周期)
+ * @return {uint8_t} 格序号 0 ~ PERF_HIST_BINS-1
+ *******************************************************************************/
+uint8_t perf_hist_bin(uint32_t _cycles)
+{
+    uint32_t v = _cycles >> PERF_HIST_SHIFT;
+    uint8_t bin;
+
+    if (v == 0) return 0;
+#if defined(__GNUC__) || defined(__clang__)
+    bin = (uint8_t)(32 - __builtin_clz(v));
+#else
+    for (bin = 0; v != 0; bin++) v >>= 1;
+#endif
+    return bin < PERF_HIST_BINS ? bin : PERF_HIST_BINS - 1;
+}
+
+/*******************************************************************************
+ * @brief 写端: 记录一次执行时间
+ * @param {PerfSlot_T *} _tpSlot 指向统计槽的指针
+ * @param {uint32_t} _cycles 执行时间(周期)
+ * @return {*}
+ * @note 无循环, 无除法; 序号前后各加1, 读端据此判断是否读到写了一半的数据
+ *******************************************************************************/
+void perf_slot_record(PerfSlot_T * _tpSlot, uint32_t _cycles)
+{
+    _tpSlot->seq++;
+    PERF_BARRIER();
+
+    if (_tpSlot->reset_req)
+    {
+        _tpSlot->reset_req = 0;
+        perf_slot_clear(_tpSlot);
+    }
+
+    _tpSlot->count++;
+    _tpSlot->sum += _cycles;
+    if (_cycles < _tpSlot->min) _tpSlot->min = _cycles;
+    if (_cycles > _tpSlot->max) _tpSlot->max = _cycles;
+    _tpSlot->hist[perf_hist_bin(_cycles)]++;
+    _tpSlot->net_total += _cycles;
+
+    PERF_BARRIER();
+    _tpSlot->seq++;
+}
+
+/*******************************************************************************
+ * @brief 请求清零
+ * @param {PerfSlot_T *} _tpSlot 指向统计槽的指针
+ * @return {*}
+ * @note 清零由写端执行, 避免两个上下文同时写统计数据
+ *******************************************************************************/
+void perf_slot_request_reset(PerfSlot_T * _tpSlot)
+{
+    _tpSlot->reset_req = 1;
+}
+
+/*******************************************************************************
+ * @brief 读端: 读取一致的副本
+ * @param {const PerfSlot_T *} _tpSlot 指向统计槽的指针
+ * @param {PerfSlot_T *} _tpOut 副本
+ * @return {*}
+ * @note 写端是更高优先级的中断时, 读取期间发生记录则重读; 写端不会被读端打断
+ *******************************************************************************/
+void perf_slot_read(const PerfSlot_T * _tpSlot, PerfSlot_T * _tpOut)
+{
+    uint32_t seq;
+
+    do
+    {
+        seq = _tpSlot->seq;
+        PERF_BARRIER();
+        memcpy(_tpOut, (const void *)_tpSlot, sizeof(PerfSlot_T));
+        PERF_BARRIER();
+    } while ((seq & 1) || seq != _tpSlot->seq);
+}
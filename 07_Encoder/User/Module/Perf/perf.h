@@ -0,0 +1,46 @@
+#ifndef __PERF_H
+#define __PERF_H
+
+#include <stdint.h>
+
+/* 直方图: 第0格 [0, 2^SHIFT), 第i格 [2^(SHIFT+i-1), 2^(SHIFT+i)) 周期, 最后一格含所有更长的 */
+#define PERF_HIST_BINS      16
+#define PERF_HIST_SHIFT     7       /* 128周期, 168MHz 下约0.76us */
+
+/*
+    执行时间统计 (与硬件无关, 时间由调用者以周期数传入)
+    单写端: 每个统计槽只由一个上下文记录; 其他上下文通过 perf_slot_read 读取一致的副本
+*/
+typedef struct
+{
+    volatile uint32_t seq;      /* 写入序号, 奇数表示正在写 */
+    volatile uint8_t reset_req; /* 其他上下文请求清零, 由写端在下次记录时执行 */
+
+    uint32_t count;             /* 次数 */
+    uint32_t min;               /* 最短(周期) */
+    uint32_t max;               /* 最长(周期) */
+    uint64_t sum;               /* 总和(周期), 求平均 */
+    uint32_t hist[PERF_HIST_BINS];
+
+    volatile uint32_t net_total; /* 累计周期(32位回绕, 不清零), 用于扣除嵌套中断时间 */
+}PerfSlot_T;
+
+/*
+    提供给用户调用的API
+*/
+/* 初始化 */
+void perf_slot_init(PerfSlot_T * _tpSlot);
+
+/* 写端: 记录一次执行时间(周期) */
+void perf_slot_record(PerfSlot_T * _tpSlot, uint32_t _cycles);
+
+/* 任意上下文: 请求清零 (写端下次记录前执行) */
+void perf_slot_request_reset(PerfSlot_T * _tpSlot);
+
+/* 读端: 读取一致的副本 */
+void perf_slot_read(const PerfSlot_T * _tpSlot, PerfSlot_T * _tpOut);
+
+/* 执行时间对应的直方图格 */
+uint8_t perf_hist_bin(uint32_t _cycles);
+
+#endif
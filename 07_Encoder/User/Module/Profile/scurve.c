@@ -0,0 +1,259 @@
+#include "scurve.h"
+#include <math.h>
+
+#define SCURVE_BISECT_ITER 32   /* 位移规划峰值速度二分次数 */
+
+/* 一次速度变化(加速或减速)的时间参数 */
+typedef struct
+{
+    float tj;           /* 变加速段时长 */
+    float ta;           /* 匀加速段时长 */
+    float a_peak;       /* 实际最大加速度 */
+}SCurveRamp_T;
+
+/* 内部功能函数 */
+static void scurve_ramp(SCurveRamp_T * _tpRamp, float _dv, float _a, float _j);
+static float scurve_ramp_distance(float _v1, float _v2, float _a, float _j);
+static void scurve_build(SCurve_T * _tpCurve, const SCurveLimits_T * _tpLimits, float _v_peak, float _cruise_time);
+static void scurve_integrate(const SCurvePoint_T * _tpStart, float _j, float _t, SCurvePoint_T * _tpOut);
+
+/*******************************************************************************
+ * @brief 速度规划
+ * @param {SCurve_T *} _tpCurve 规划结果
+ * @param {const SCurveLimits_T *} _tpLimits 约束
+ * @param {float} _cruise_time 峰值速度保持时间, 0=到达后立即减速
+ * @return {*}
+ * @note v_end == v_max 且 _cruise_time = 0 时, 即为单纯的加速到目标速度
+ *******************************************************************************/
+void scurve_plan_velocity(SCurve_T * _tpCurve, const SCurveLimits_T * _tpLimits, float _cruise_time)
+{
+    _tpCurve->dir = 1.0f;
+    scurve_build(_tpCurve, _tpLimits, _tpLimits->v_max, _cruise_time > 0.0f ? _cruise_time : 0.0f);
+}
+
+/*******************************************************************************
+ * @brief 位移规划
+ * @param {SCurve_T *} _tpCurve 规划结果
+ * @param {const SCurveLimits_T *} _tpLimits 约束 (速度均为沿运动方向的大小)
+ * @param {float} _distance 目标位移, 负数为反向
+ * @return {uint8_t} 1=成功, 0=距离过短(按最短曲线规划, 实际位移大于目标)
+ * @note 到达v_max仍有剩余距离时插入匀速段; 否则二分查找能恰好走完距离的峰值速度
+ *******************************************************************************/
+uint8_t scurve_plan_distance(SCurve_T * _tpCurve, const SCurveLimits_T * _tpLimits, float _distance)
+{
+    float d = fabsf(_distance);
+    float v_lo = _tpLimits->v_start > _tpLimits->v_end ? _tpLimits->v_start : _tpLimits->v_end;
+    float v_hi = _tpLimits->v_max > v_lo ? _tpLimits->v_max : v_lo;
+    uint8_t ok = 1;
+    uint8_t i;
+
+    float d_full = scurve_ramp_distance(_tpLimits->v_start, v_hi, _tpLimits->accel, _tpLimits->jerk) +
+                   scurve_ramp_distance(v_hi, _tpLimits->v_end, _tpLimits->decel, _tpLimits->jerk);
+
+    _tpCurve->dir = _distance < 0.0f ? -1.0f : 1.0f;
+
+    if (d_full <= d)
+    {
+        /* 能到达最大速度: 剩余距离匀速走完 */
+        float cruise = v_hi > 0.0f ? (d - d_full) / v_hi : 0.0f;
+        scurve_build(_tpCurve, _tpLimits, v_hi, cruise);
+        return 1;
+    }
+
+    float d_min = scurve_ramp_distance(_tpLimits->v_start, v_lo, _tpLimits->accel, _tpLimits->jerk) +
+                  scurve_ramp_distance(v_lo, _tpLimits->v_end, _tpLimits->decel, _tpLimits->jerk);
+    if (d_min > d)
+    {
+        /* 起止速度本身就需要更长的距离 */
+        ok = 0;
+        v_hi = v_lo;
+    }
+    else
+    {
+        /* 位移随峰值速度单调增加, 二分求解 */
+        for (i = 0; i < SCURVE_BISECT_ITER; i++)
+        {
+            float v_mid = 0.5f * (v_lo + v_hi);
+            float d_mid = scurve_ramp_distance(_tpLimits->v_start, v_mid, _tpLimits->accel, _tpLimits->jerk) +
+                          scurve_ramp_distance(v_mid, _tpLimits->v_end, _tpLimits->decel, _tpLimits->jerk);
+            if (d_mid > d)
+                v_hi = v_mid;
+            else
+                v_lo = v_mid;
+        }
+        v_hi = v_lo;
+    }
+
+    scurve_build(_tpCurve, _tpLimits, v_hi, 0.0f);
+
+    /* 二分残差用匀速段补齐 */
+    if (ok && v_hi > 0.0f && d > fabsf(_tpCurve->distance))
+        scurve_build(_tpCurve, _tpLimits, v_hi, (d - fabsf(_tpCurve->distance)) / v_hi);
+
+    return ok;
+}
+
+/*******************************************************************************
+ * @brief 求t时刻的设定值
+ * @param {const SCurve_T *} _tpCurve 规划结果
+ * @param {float} _t 时间(从曲线起点算起)
+ * @param {SCurvePoint_T *} _tpOut 位移/速度/加速度 (带方向)
+ * @return {*}
+ * @note 段号由7个边界直接比较得到, 每段内为三次多项式, 计算量固定
+ *******************************************************************************/
+void scurve_eval(const SCurve_T * _tpCurve, float _t, SCurvePoint_T * _tpOut)
+{
+    uint8_t seg = scurve_segment(_tpCurve, _t);
+    SCurvePoint_T pt;
+
+    if (_t < 0.0f)
+        _t = 0.0f;
+
+    if (seg >= SCURVE_SEGMENTS)
+    {
+        /* 结束后保持结束速度 */
+        const SCurvePoint_T *end = &_tpCurve->s0[SCURVE_SEGMENTS];
+        pt.p = end->p + end->v * (_t - _tpCurve->total_time);
+        pt.v = end->v;
+        pt.a = 0.0f;
+    }
+    else
+    {
+        scurve_integrate(&_tpCurve->s0[seg], _tpCurve->j[seg], _t - _tpCurve->t0[seg], &pt);
+    }
+
+    _tpOut->p = pt.p * _tpCurve->dir;
+    _tpOut->v = pt.v * _tpCurve->dir;
+    _tpOut->a = pt.a * _tpCurve->dir;
+}
+
+/*******************************************************************************
+ * @brief 求t时刻所在段号
+ * @param {const SCurve_T *} _tpCurve 规划结果
+ * @param {float} _t 时间
+ * @return {uint8_t} 0~6, 结束后返回7
+ *******************************************************************************/
+uint8_t scurve_segment(const SCurve_T * _tpCurve, float _t)
+{
+    uint8_t seg = SCURVE_SEGMENTS;
+
+    /* 从后往前找第一个起点不晚于t的非空段 */
+    while (seg > 0 && _t < _tpCurve->t0[seg])
+        seg--;
+
+    /* 跳过时长为0的段, 使返回的段号与实际所处阶段一致 */
+    while (seg < SCURVE_SEGMENTS && _tpCurve->t0[seg + 1] <= _t)
+        seg++;
+
+    return seg;
+}
+
+/* ————————————————————————————————— 内部功能函数 ————————————————————————————————— */
+/*******************************************************************************
+ * @brief 计算一次速度变化的变加速/匀加速时长
+ * @note 速度变化量足够大时加速度能达到上限, 否则为三角形加速度曲线
+ *******************************************************************************/
+static void scurve_ramp(SCurveRamp_T * _tpRamp, float _dv, float _a, float _j)
+{
+    if (_dv <= 0.0f || _a <= 0.0f)
+    {
+        _tpRamp->tj = 0.0f;
+        _tpRamp->ta = 0.0f;
+        _tpRamp->a_peak = 0.0f;
+    }
+    else if (_j <= 0.0f)
+    {
+        /* 不限加加速度: 梯形曲线 */
+        _tpRamp->tj = 0.0f;
+        _tpRamp->ta = _dv / _a;
+        _tpRamp->a_peak = _a;
+    }
+    else if (_dv * _j >= _a * _a)
+    {
+        _tpRamp->tj = _a / _j;
+        _tpRamp->ta = _dv / _a - _tpRamp->tj;
+        _tpRamp->a_peak = _a;
+    }
+    else
+    {
+        _tpRamp->tj = sqrtf(_dv / _j);
+        _tpRamp->ta = 0.0f;
+        _tpRamp->a_peak = _j * _tpRamp->tj;
+    }
+}
+
+/*******************************************************************************
+ * @brief 一次速度变化经过的位移
+ * @note 加速度曲线关于中点对称, 位移 = 平均速度 × 时间
+ *******************************************************************************/
+static float scurve_ramp_distance(float _v1, float _v2, float _a, float _j)
+{
+    SCurveRamp_T ramp;
+
+    scurve_ramp(&ramp, fabsf(_v2 - _v1), _a, _j);
+    return 0.5f * (_v1 + _v2) * (2.0f * ramp.tj + ramp.ta);
+}
+
+/*******************************************************************************
+ * @brief 根据峰值速度和匀速时间生成7段参数及各段起始状态
+ *******************************************************************************/
+static void scurve_build(SCurve_T * _tpCurve, const SCurveLimits_T * _tpLimits, float _v_peak, float _cruise_time)
+{
+    SCurveRamp_T up, down;
+    float s_up = _v_peak >= _tpLimits->v_start ? 1.0f : -1.0f;
+    float s_down = _tpLimits->v_end >= _v_peak ? 1.0f : -1.0f;
+    float dt[SCURVE_SEGMENTS];
+    float a0[SCURVE_SEGMENTS];
+    uint8_t i;
+
+    scurve_ramp(&up, fabsf(_v_peak - _tpLimits->v_start), _tpLimits->accel, _tpLimits->jerk);
+    scurve_ramp(&down, fabsf(_tpLimits->v_end - _v_peak), _tpLimits->decel, _tpLimits->jerk);
+
+    dt[0] = up.tj;      _tpCurve->j[0] = s_up * _tpLimits->jerk;    a0[0] = 0.0f;
+    dt[1] = up.ta;      _tpCurve->j[1] = 0.0f;                      a0[1] = s_up * up.a_peak;
+    dt[2] = up.tj;      _tpCurve->j[2] = -s_up * _tpLimits->jerk;   a0[2] = s_up * up.a_peak;
+    dt[3] = _cruise_time; _tpCurve->j[3] = 0.0f;                    a0[3] = 0.0f;
+    dt[4] = down.tj;    _tpCurve->j[4] = s_down * _tpLimits->jerk;  a0[4] = 0.0f;
+    dt[5] = down.ta;    _tpCurve->j[5] = 0.0f;                      a0[5] = s_down * down.a_peak;
+    dt[6] = down.tj;    _tpCurve->j[6] = -s_down * _tpLimits->jerk; a0[6] = s_down * down.a_peak;
+
+    if (_tpLimits->jerk <= 0.0f)
+    {
+        for (i = 0; i < SCURVE_SEGMENTS; i++)
+            _tpCurve->j[i] = 0.0f;
+    }
+
+    _tpCurve->t0[0] = 0.0f;
+    _tpCurve->s0[0].p = 0.0f;
+    _tpCurve->s0[0].v = _tpLimits->v_start;
+    _tpCurve->s0[0].a = 0.0f;
+
+    for (i = 0; i < SCURVE_SEGMENTS; i++)
+    {
+        SCurvePoint_T start = _tpCurve->s0[i];
+
+        /* 加速度在段边界直接给定, 避免累积误差 (不限jerk时加速度在此处阶跃) */
+        start.a = a0[i];
+        _tpCurve->s0[i].a = a0[i];
+        scurve_integrate(&start, _tpCurve->j[i], dt[i], &_tpCurve->s0[i + 1]);
+        _tpCurve->t0[i + 1] = _tpCurve->t0[i] + dt[i];
+    }
+
+    /* 终点速度精确落在 v_end */
+    _tpCurve->s0[SCURVE_SEGMENTS].v = _tpLimits->v_end;
+    _tpCurve->s0[SCURVE_SEGMENTS].a = 0.0f;
+
+    _tpCurve->total_time = _tpCurve->t0[SCURVE_SEGMENTS];
+    _tpCurve->distance = _tpCurve->s0[SCURVE_SEGMENTS].p * _tpCurve->dir;
+    _tpCurve->v_peak = _v_peak;
+}
+
+/*******************************************************************************
+ * @brief 恒定加加速度下积分t时间
+ *******************************************************************************/
+static void scurve_integrate(const SCurvePoint_T * _tpStart, float _j, float _t, SCurvePoint_T * _tpOut)
+{
+    _tpOut->p = _tpStart->p + _tpStart->v * _t + 0.5f * _tpStart->a * _t * _t + _j * _t * _t * _t / 6.0f;
+    _tpOut->v = _tpStart->v + _tpStart->a * _t + 0.5f * _j * _t * _t;
+    _tpOut->a = _tpStart->a + _j * _t;
+}
@@ -0,0 +1,73 @@
+#ifndef __SCURVE_H
+#define __SCURVE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    7段S曲线 (加加速度受限)
+
+    段号:   0        1        2        3        4        5        6
+          +j加速   匀加速   -j加速    匀速    -j减速   匀减速   +j减速
+
+    单位由调用者决定, 只要求一致: 速度v, 加速度a=dv/dt, 加加速度j=da/dt, 位移p=∫v dt
+    例如 v取rpm, t取秒, 则 p/60 为圈数
+    jerk<=0 表示不限制加加速度, 此时退化为梯形曲线 (0/2/4/6段时长为0)
+*/
+
+#define SCURVE_SEGMENTS 7
+
+/* 规划约束 (均取沿运动方向的正值) */
+typedef struct
+{
+    float v_start;              /* 起始速度 */
+    float v_max;                /* 最大速度 */
+    float v_end;                /* 结束速度 */
+    float accel;                /* 最大加速度 */
+    float decel;                /* 最大减速度 */
+    float jerk;                 /* 最大加加速度, <=0 不限制 */
+}SCurveLimits_T;
+
+/* 曲线上一点 */
+typedef struct
+{
+    float p;                    /* 位移 */
+    float v;                    /* 速度 */
+    float a;                    /* 加速度 */
+}SCurvePoint_T;
+
+/* 规划结果 */
+typedef struct
+{
+    float t0[SCURVE_SEGMENTS + 1];      /* 各段起始时刻, t0[7]=总时间 */
+    float j[SCURVE_SEGMENTS];           /* 各段加加速度 */
+    SCurvePoint_T s0[SCURVE_SEGMENTS + 1]; /* 各段起始状态, s0[7]=终点状态 */
+    float dir;                          /* 运动方向 +1/-1 */
+    float total_time;                   /* 总时间 */
+    float distance;                     /* 总位移(带方向) */
+    float v_peak;                       /* 实际峰值速度 */
+}SCurve_T;
+
+/*
+    提供给用户调用的API
+*/
+/* 速度规划: v_start → v_max, 匀速保持 _cruise_time, → v_end */
+void scurve_plan_velocity(SCurve_T * _tpCurve, const SCurveLimits_T * _tpLimits, float _cruise_time);
+
+/* 位移规划: 走完 _distance (可为负) 时恰好降到 v_end; 返回0表示距离过短, 无法在约束内到达 */
+uint8_t scurve_plan_distance(SCurve_T * _tpCurve, const SCurveLimits_T * _tpLimits, float _distance);
+
+/* 求任意时刻的设定值, O(1); t超过总时间后按结束速度匀速外推 */
+void scurve_eval(const SCurve_T * _tpCurve, float _t, SCurvePoint_T * _tpOut);
+
+/* 求t时刻所在段号(0~6), 结束后返回7 */
+uint8_t scurve_segment(const SCurve_T * _tpCurve, float _t);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -397,6 +397,142 @@ rt_size_t rt_ringbuffer_data_len(struct rt_ringbuffer *rb)
 }
 //RTM_EXPORT(rt_ringbuffer_data_len);
 
+/**
+ * @brief Reserve the free space of the ring buffer for writing in place.
+ *
+ * @param rb            A pointer to the ring buffer object.
+ * @param ptr           When this function return, *ptr points to the first writable byte.
+ * @param wrap_ptr      When this function return, *wrap_ptr points to the free space after the wrap point (the start of the buffer).
+ * @param wrap_len      When this function return, *wrap_len is the size of the free space after the wrap point.
+ *
+ * @note The free space is split at the end of the buffer into two contiguous spans: [ptr, ptr + return value) and
+ *       [wrap_ptr, wrap_ptr + wrap_len). Write the data into them in order, then call rt_ringbuffer_commit().
+ *       Nothing is visible to the reader before the commit. Only one writer may hold a reservation at a time.
+ *
+ * @return Return the size of the first contiguous span.
+ */
+rt_size_t rt_ringbuffer_reserve(struct rt_ringbuffer *rb,
+                                rt_uint8_t          **ptr,
+                                rt_uint8_t          **wrap_ptr,
+                                rt_size_t            *wrap_len)
+{
+    rt_size_t size, tail;
+
+    RT_ASSERT(rb != RT_NULL);
+
+    size = rt_ringbuffer_space_len(rb);
+    tail = rb->buffer_size - rb->write_index;
+
+    *ptr = &rb->buffer_ptr[rb->write_index];
+    *wrap_ptr = &rb->buffer_ptr[0];
+
+    /* the free space does not reach the end of the buffer */
+    if (size <= tail)
+    {
+        *wrap_len = 0;
+        return size;
+    }
+
+    *wrap_len = size - tail;
+    return tail;
+}
+//RTM_EXPORT(rt_ringbuffer_reserve);
+
+/**
+ * @brief Commit the data written in place after rt_ringbuffer_reserve().
+ *
+ * @param rb            A pointer to the ring buffer object.
+ * @param length        The size of data in bytes, counted from the first reserved byte (may cross the wrap point).
+ *
+ * @return Return the data size we commit into the ring buffer, no more than the free space.
+ */
+rt_size_t rt_ringbuffer_commit(struct rt_ringbuffer *rb,
+                               rt_uint16_t           length)
+{
+    rt_uint16_t size;
+
+    RT_ASSERT(rb != RT_NULL);
+
+    size = rt_ringbuffer_space_len(rb);
+
+    if (size < length)
+        length = size;
+
+    if (rb->buffer_size - rb->write_index > length)
+    {
+        rb->write_index += length;
+        return length;
+    }
+
+    /* we are going into the other side of the mirror */
+    rb->write_mirror = ~rb->write_mirror;
+    rb->write_index = length - (rb->buffer_size - rb->write_index);
+
+    return length;
+}
+//RTM_EXPORT(rt_ringbuffer_commit);
+
+/**
+ * @brief Get the contiguous readable data of the ring buffer without removing it.
+ *
+ * @param rb        A pointer to the ring buffer object.
+ * @param ptr       When this function return, *ptr is a pointer to the first readable byte of the ring buffer.
+ *
+ * @note Unlike rt_ringbuffer_peek(), the data stays in the ring buffer (the writer can not overwrite it)
+ *       until rt_ringbuffer_discard() is called, so it can be handed to a DMA transfer directly.
+ *       The data after the wrap point is returned by the next call after the discard.
+ *
+ * @return Return the size of the contiguous readable data.
+ */
+rt_size_t rt_ringbuffer_peek_linear(struct rt_ringbuffer *rb, rt_uint8_t **ptr)
+{
+    rt_size_t size, tail;
+
+    RT_ASSERT(rb != RT_NULL);
+
+    size = rt_ringbuffer_data_len(rb);
+    tail = rb->buffer_size - rb->read_index;
+
+    *ptr = &rb->buffer_ptr[rb->read_index];
+
+    return size < tail ? size : tail;
+}
+//RTM_EXPORT(rt_ringbuffer_peek_linear);
+
+/**
+ * @brief Remove data from the ring buffer without copying it.
+ *
+ * @param rb            A pointer to the ring buffer object.
+ * @param length        The size of data in bytes.
+ *
+ * @return Return the data size we removed from the ring buffer.
+ */
+rt_size_t rt_ringbuffer_discard(struct rt_ringbuffer *rb,
+                                rt_uint16_t           length)
+{
+    rt_size_t size;
+
+    RT_ASSERT(rb != RT_NULL);
+
+    size = rt_ringbuffer_data_len(rb);
+
+    if (size < length)
+        length = size;
+
+    if (rb->buffer_size - rb->read_index > length)
+    {
+        rb->read_index += length;
+        return length;
+    }
+
+    /* we are going into the other side of the mirror */
+    rb->read_mirror = ~rb->read_mirror;
+    rb->read_index = length - (rb->buffer_size - rb->read_index);
+
+    return length;
+}
+//RTM_EXPORT(rt_ringbuffer_discard);
+
 /**
  * @brief Reset the ring buffer object, and clear all contents in the buffer.
  *
@@ -90,6 +90,14 @@ rt_size_t rt_ringbuffer_get(struct rt_ringbuffer *rb, rt_uint8_t *ptr, rt_uint16
 rt_size_t rt_ringbuffer_peek(struct rt_ringbuffer *rb, rt_uint8_t **ptr);
 rt_size_t rt_ringbuffer_getchar(struct rt_ringbuffer *rb, rt_uint8_t *ch);
 rt_size_t rt_ringbuffer_data_len(struct rt_ringbuffer *rb);
+/* In-place write. The UART driver formats through spsc_write_span (Module/Spsc) now;
+ * these stay as the rt_ringbuffer baseline in Tools/spsc_bench.cpp. */
+rt_size_t rt_ringbuffer_reserve(struct rt_ringbuffer *rb, rt_uint8_t **ptr, rt_uint8_t **wrap_ptr, rt_size_t *wrap_len);
+rt_size_t rt_ringbuffer_commit(struct rt_ringbuffer *rb, rt_uint16_t length);
+/* Zero-copy read for DMA. The UART driver uses spsc_read_span/release now;
+ * kept as the rt_ringbuffer baseline in Tools/spsc_bench.cpp. */
+rt_size_t rt_ringbuffer_peek_linear(struct rt_ringbuffer *rb, rt_uint8_t **ptr);
+rt_size_t rt_ringbuffer_discard(struct rt_ringbuffer *rb, rt_uint16_t length);
 
 #ifdef RT_USING_HEAP
 struct rt_ringbuffer* rt_ringbuffer_create(rt_uint16_t length);
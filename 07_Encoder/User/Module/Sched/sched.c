@@ -0,0 +1,163 @@
+#include "sched.h"
+
+/* 回绕安全的时间差: a 晚于(或等于) b 时为非负 */
+#define SCHED_DIFF(a, b)    ((int32_t)((uint32_t)(a) - (uint32_t)(b)))
+
+/*******************************************************************************
+ * @brief 初始化
+ * @param {Sched_T *} _tpSched 指向调度器结构体的指针
+ * @param {SchedTask_T *} _tpTasks 任务表 (需填好 func/period/phase/priority/enabled)
+ * @param {uint8_t} _count 任务数
+ * @param {uint32_t} _now 当前时刻
+ * @return {*}
+ *******************************************************************************/
+void sched_init(Sched_T * _tpSched, SchedTask_T * _tpTasks, uint8_t _count, uint32_t _now)
+{
+    _tpSched->tasks = _tpTasks;
+    _tpSched->count = _count;
+
+    for (uint8_t i = 0; i < _count; i++)
+    {
+        SchedTask_T *task = &_tpTasks[i];
+
+        if (task->period == 0) task->period = 1;
+        task->release = _now + task->phase;
+    }
+    sched_reset_stats(_tpSched);
+}
+
+/*******************************************************************************
+ * @brief 把释放时刻推进到 _now 之后 (保持相位)
+ * @param {SchedTask_T *} _tpTask 任务
+ * @param {uint32_t} _now 当前时刻
+ * @return {uint32_t} 跳过的周期数 (不含本次)
+ *******************************************************************************/
+static uint32_t sched_advance(SchedTask_T * _tpTask, uint32_t _now)
+{
+    uint32_t late = (uint32_t)SCHED_DIFF(_now, _tpTask->release);
+    uint32_t skipped = late / _tpTask->period;
+
+    _tpTask->release += (skipped + 1) * _tpTask->period;
+    return skipped;
+}
+
+/*******************************************************************************
+ * @brief 执行一个已到期且优先级最高的任务
+ * @param {Sched_T *} _tpSched 指向调度器结构体的指针
+ * @param {uint32_t} _now 当前时刻
+ * @return {SchedTask_T *} 执行的任务, 0=没有到期任务
+ * @note 每次只执行一个, 调用者循环调用并每次传入最新时刻,
+ *       长任务执行期间到期的高优先级任务能排在其余低优先级任务之前;
+ *       同优先级按到期先后, 再按任务表顺序
+ *******************************************************************************/
+SchedTask_T * sched_run_one(Sched_T * _tpSched, uint32_t _now)
+{
+    SchedTask_T *best = 0;
+
+    for (uint8_t i = 0; i < _tpSched->count; i++)
+    {
+        SchedTask_T *task = &_tpSched->tasks[i];
+
+        if (!task->enabled || SCHED_DIFF(_now, task->release) < 0) continue;
+
+        if (best == 0 || task->priority < best->priority ||
+            (task->priority == best->priority && SCHED_DIFF(best->release, task->release) > 0))
+        {
+            best = task;
+        }
+    }
+
+    if (best == 0) return 0;
+
+    // 统计延迟, 延迟超过一个周期时跳过错过的释放, 不补跑
+    uint32_t late = (uint32_t)SCHED_DIFF(_now, best->release);
+    if (late > best->max_late) best->max_late = late;
+    best->misses += sched_advance(best, _now);
+    best->runs++;
+
+    best->func();
+    return best;
+}
+
+/*******************************************************************************
+ * @brief 释放到期任务 (抢占式)
+ * @param {Sched_T *} _tpSched 指向调度器结构体的指针
+ * @param {uint32_t} _now 当前时刻
+ * @param {uint32_t} _pending 已激活尚未开始执行的任务位图
+ * @return {uint32_t} 本次到期的任务位图, 交给内核激活
+ * @note 在节拍中断中调用; 任务数不超过32。
+ *       上次激活还没开始执行的任务不重复激活, 本次释放计为错过
+ *******************************************************************************/
+uint32_t sched_release(Sched_T * _tpSched, uint32_t _now, uint32_t _pending)
+{
+    uint32_t mask = 0;
+    uint8_t count = _tpSched->count > 32 ? 32 : _tpSched->count;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        SchedTask_T *task = &_tpSched->tasks[i];
+
+        if (!task->enabled || SCHED_DIFF(_now, task->release) < 0) continue;
+
+        if (_pending & (1u << i))
+        {
+            task->misses++;
+        }
+        else
+        {
+            task->activation = task->release;
+            mask |= 1u << i;
+        }
+        task->misses += sched_advance(task, _now);
+    }
+    return mask;
+}
+
+/*******************************************************************************
+ * @brief 任务开始执行 (抢占式)
+ * @param {SchedTask_T *} _tpTask 任务
+ * @param {uint32_t} _now 当前时刻
+ * @return {*}
+ * @note 延迟 = 开始执行时刻 - 释放时刻, 包括等待更高优先级任务的时间
+ *******************************************************************************/
+void sched_begin(SchedTask_T * _tpTask, uint32_t _now)
+{
+    uint32_t late = (uint32_t)SCHED_DIFF(_now, _tpTask->activation);
+
+    if (late > _tpTask->max_late) _tpTask->max_late = late;
+    _tpTask->runs++;
+}
+
+/*******************************************************************************
+ * @brief 运行时使能/禁止
+ * @param {SchedTask_T *} _tpTask 任务
+ * @param {uint8_t} _enable 1=使能, 0=禁止
+ * @param {uint32_t} _now 当前时刻
+ * @return {*}
+ * @note 禁止期间不统计超时; 重新使能时释放时刻对齐到原相位的下一个时刻
+ *******************************************************************************/
+void sched_enable(SchedTask_T * _tpTask, uint8_t _enable, uint32_t _now)
+{
+    if (_enable && !_tpTask->enabled && SCHED_DIFF(_now, _tpTask->release) > 0)
+    {
+        // 已过的释放时刻直接跳过, 取原相位上不早于 _now 的第一个释放时刻
+        uint32_t late = (uint32_t)SCHED_DIFF(_now, _tpTask->release);
+        _tpTask->release += (late + _tpTask->period - 1) / _tpTask->period * _tpTask->period;
+    }
+    _tpTask->enabled = _enable;
+}
+
+/*******************************************************************************
+ * @brief 清除统计
+ * @param {Sched_T *} _tpSched 指向调度器结构体的指针
+ * @return {*}
+ *******************************************************************************/
+void sched_reset_stats(Sched_T * _tpSched)
+{
+    for (uint8_t i = 0; i < _tpSched->count; i++)
+    {
+        _tpSched->tasks[i].runs = 0;
+        _tpSched->tasks[i].misses = 0;
+        _tpSched->tasks[i].max_late = 0;
+    }
+}
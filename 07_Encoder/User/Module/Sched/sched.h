@@ -0,0 +1,71 @@
+#ifndef __SCHED_H
+#define __SCHED_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    周期任务调度核心 (与硬件无关, 时间由调用者传入, 单位为节拍)
+    - 绝对截止时间: 每次只把释放时刻加一个周期, 执行晚了也不会累积漂移
+    - 回绕安全: 时间比较一律用 (int32_t)(a - b), 节拍计数溢出后仍正确
+    - 相位偏移: 同周期的任务错开首次释放时刻, 负载分散到不同节拍
+    - 优先级: 多个任务同时到期时先执行优先级高(数值小)的
+    - 超时统计: 错过的周期数、最大延迟
+    两种用法:
+    - 协作式: 主循环反复调用 sched_run_one, 任务在主循环中依次执行
+    - 抢占式: 节拍中断调用 sched_release 得到到期任务位图交给内核激活,
+      内核执行任务前调用 sched_begin 统计延迟 (任务表须按优先级排列, 第i位 = 第i个任务)
+*/
+typedef struct
+{
+    void (*func)(void);         /* 任务函数 */
+    uint32_t period;            /* 周期(节拍) */
+    uint32_t phase;             /* 相位偏移(节拍), 首次释放 = 启动时刻 + phase */
+    uint8_t priority;           /* 优先级, 0最高 */
+    uint8_t enabled;            /* 使能 */
+    const char *name;           /* 名称 (统计报告用) */
+
+    uint32_t release;           /* 下一次释放时刻 (绝对时间) */
+    uint32_t activation;        /* 最近一次激活对应的释放时刻 (抢占式用) */
+
+    /* 统计 */
+    uint32_t runs;              /* 执行次数 */
+    uint32_t misses;            /* 错过的周期数 (延迟超过一个周期时跳过的释放) */
+    uint32_t max_late;          /* 最大延迟(节拍): 实际执行时刻 - 释放时刻 */
+}SchedTask_T;
+
+typedef struct
+{
+    SchedTask_T *tasks;         /* 任务表 */
+    uint8_t count;              /* 任务数 */
+}Sched_T;
+
+/*
+    提供给用户调用的API
+*/
+/* 初始化 (所有任务按 _now + phase 释放, 使能状态取任务表中的初值) */
+void sched_init(Sched_T * _tpSched, SchedTask_T * _tpTasks, uint8_t _count, uint32_t _now);
+
+/* 执行一个已到期且优先级最高的任务, 返回该任务; 没有到期任务返回0 */
+SchedTask_T * sched_run_one(Sched_T * _tpSched, uint32_t _now);
+
+/* 释放到期任务 (节拍中断中调用), 返回到期任务位图; _pending 中的任务上次激活还未执行, 计为错过 */
+uint32_t sched_release(Sched_T * _tpSched, uint32_t _now, uint32_t _pending);
+
+/* 任务开始执行, 统计次数和延迟 (抢占式, 执行任务函数前调用) */
+void sched_begin(SchedTask_T * _tpTask, uint32_t _now);
+
+/* 运行时使能/禁止 (重新使能时按原相位对齐到下一个释放时刻) */
+void sched_enable(SchedTask_T * _tpTask, uint8_t _enable, uint32_t _now);
+
+/* 清除统计 */
+void sched_reset_stats(Sched_T * _tpSched);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,182 @@
+#include "spsc.h"
+#include <string.h>
+
+/*
+    读取对端位置用 acquire: 之后对数据的访问不会提前到读位置之前
+    发布本端位置用 release: 之前对数据的访问不会推迟到发布之后
+    单核 Cortex-M 上编译为普通读写加 DMB, 主机多核测试时同样正确
+*/
+#define SPSC_LOAD_ACQUIRE(p)        __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define SPSC_STORE_RELEASE(p, v)    __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+/*******************************************************************************
+ * @brief 初始化
+ * @param {Spsc_T *} _tpRing 指向环形缓冲区结构体的指针
+ * @param {uint8_t *} _buffer 缓冲区
+ * @param {uint32_t} _size 缓冲区字节数 (不小于1), 须为2的幂 (否则只用到不大于它的最大2的幂)
+ * @return {*}
+ * @note 在两端开始使用之前调用
+ *******************************************************************************/
+void spsc_init(Spsc_T * _tpRing, uint8_t * _buffer, uint32_t _size)
+{
+    uint32_t size = 1;
+
+    while (size <= _size / 2) size <<= 1;
+
+    _tpRing->buffer = _buffer;
+    _tpRing->mask = size - 1;
+    _tpRing->head = 0;
+    _tpRing->tail = 0;
+}
+
+/*******************************************************************************
+ * @brief 当前数据量
+ * @param {const Spsc_T *} _tpRing 指向环形缓冲区结构体的指针
+ * @return {uint32_t} 字节数
+ *******************************************************************************/
+uint32_t spsc_data_len(const Spsc_T * _tpRing)
+{
+    uint32_t tail = SPSC_LOAD_ACQUIRE(&_tpRing->tail);
+    uint32_t head = SPSC_LOAD_ACQUIRE(&_tpRing->head);
+
+    return head - tail;
+}
+
+/*******************************************************************************
+ * @brief 空闲空间
+ * @param {const Spsc_T *} _tpRing 指向环形缓冲区结构体的指针
+ * @return {uint32_t} 字节数
+ *******************************************************************************/
+uint32_t spsc_space_len(const Spsc_T * _tpRing)
+{
+    return _tpRing->mask + 1 - spsc_data_len(_tpRing);
+}
+
+/*******************************************************************************
+ * @brief 写端: 取得空闲区
+ * @param {Spsc_T *} _tpRing 指向环形缓冲区结构体的指针
+ * @param {uint8_t **} _ptr 输出第一段的起点 (写位置)
+ * @param {uint8_t **} _wrap_ptr 输出第二段的起点 (缓冲区开头)
+ * @param {uint32_t *} _wrap_len 输出第二段的长度, 空闲区不折返时为0
+ * @return {uint32_t} 第一段的长度
+ * @note 按顺序写入两段后调用 spsc_write_commit, 提交之前读端看不到
+ *******************************************************************************/
+uint32_t spsc_write_span(Spsc_T * _tpRing, uint8_t ** _ptr, uint8_t ** _wrap_ptr, uint32_t * _wrap_len)
+{
+    uint32_t head = _tpRing->head;
+    uint32_t space = _tpRing->mask + 1 - (head - SPSC_LOAD_ACQUIRE(&_tpRing->tail));
+    uint32_t index = head & _tpRing->mask;
+    uint32_t tail_len = _tpRing->mask + 1 - index;
+
+    *_ptr = &_tpRing->buffer[index];
+    *_wrap_ptr = _tpRing->buffer;
+
+    if (space <= tail_len)
+    {
+        *_wrap_len = 0;
+        return space;
+    }
+
+    *_wrap_len = space - tail_len;
+    return tail_len;
+}
+
+/*******************************************************************************
+ * @brief 写端: 提交写入的数据
+ * @param {Spsc_T *} _tpRing 指向环形缓冲区结构体的指针
+ * @param {uint32_t} _len 字节数, 不超过 spsc_write_span 得到的两段之和
+ * @return {*}
+ *******************************************************************************/
+void spsc_write_commit(Spsc_T * _tpRing, uint32_t _len)
+{
+    SPSC_STORE_RELEASE(&_tpRing->head, _tpRing->head + _len);
+}
+
+/*******************************************************************************
+ * @brief 写端: 整块写入
+ * @param {Spsc_T *} _tpRing 指向环形缓冲区结构体的指针
+ * @param {const uint8_t *} _data 数据
+ * @param {uint32_t} _len 字节数
+ * @return {uint32_t} 写入的字节数, 空间不足时只写入能放下的部分
+ *******************************************************************************/
+uint32_t spsc_write(Spsc_T * _tpRing, const uint8_t * _data, uint32_t _len)
+{
+    uint8_t *ptr, *wrap_ptr;
+    uint32_t wrap_len;
+    uint32_t span = spsc_write_span(_tpRing, &ptr, &wrap_ptr, &wrap_len);
+
+    if (_len > span + wrap_len) _len = span + wrap_len;
+
+    if (_len <= span)
+    {
+        memcpy(ptr, _data, _len);
+    }
+    else
+    {
+        memcpy(ptr, _data, span);
+        memcpy(wrap_ptr, _data + span, _len - span);
+    }
+
+    spsc_write_commit(_tpRing, _len);
+    return _len;
+}
+
+/*******************************************************************************
+ * @brief 读端: 取得连续的一段数据
+ * @param {Spsc_T *} _tpRing 指向环形缓冲区结构体的指针
+ * @param {uint8_t **} _ptr 输出读位置
+ * @return {uint32_t} 读位置起到数据末尾或缓冲区末尾的字节数
+ * @note 数据仍留在缓冲区中 (写端不会覆盖), 可直接交给DMA发送, 用完后调用 spsc_read_release;
+ *       折返后的部分在移除前一段后再次调用得到
+ *******************************************************************************/
+uint32_t spsc_read_span(Spsc_T * _tpRing, uint8_t ** _ptr)
+{
+    uint32_t tail = _tpRing->tail;
+    uint32_t len = SPSC_LOAD_ACQUIRE(&_tpRing->head) - tail;
+    uint32_t index = tail & _tpRing->mask;
+    uint32_t tail_len = _tpRing->mask + 1 - index;
+
+    *_ptr = &_tpRing->buffer[index];
+    return len < tail_len ? len : tail_len;
+}
+
+/*******************************************************************************
+ * @brief 读端: 移除数据
+ * @param {Spsc_T *} _tpRing 指向环形缓冲区结构体的指针
+ * @param {uint32_t} _len 字节数, 不超过当前数据量
+ * @return {*}
+ *******************************************************************************/
+void spsc_read_release(Spsc_T * _tpRing, uint32_t _len)
+{
+    SPSC_STORE_RELEASE(&_tpRing->tail, _tpRing->tail + _len);
+}
+
+/*******************************************************************************
+ * @brief 读端: 整块读出
+ * @param {Spsc_T *} _tpRing 指向环形缓冲区结构体的指针
+ * @param {uint8_t *} _data 输出缓冲区
+ * @param {uint32_t} _len 最多读出的字节数
+ * @return {uint32_t} 读出的字节数
+ *******************************************************************************/
+uint32_t spsc_read(Spsc_T * _tpRing, uint8_t * _data, uint32_t _len)
+{
+    uint32_t tail = _tpRing->tail;
+    uint32_t len = SPSC_LOAD_ACQUIRE(&_tpRing->head) - tail;
+    uint32_t index = tail & _tpRing->mask;
+    uint32_t tail_len = _tpRing->mask + 1 - index;
+
+    if (_len > len) _len = len;
+
+    if (_len <= tail_len)
+    {
+        memcpy(_data, &_tpRing->buffer[index], _len);
+    }
+    else
+    {
+        memcpy(_data, &_tpRing->buffer[index], tail_len);
+        memcpy(_data + tail_len, _tpRing->buffer, _len - tail_len);
+    }
+
+    spsc_read_release(_tpRing, _len);
+    return _len;
+}
@@ -0,0 +1,54 @@
+#ifndef __SPSC_H
+#define __SPSC_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    单生产者单消费者字节环形缓冲区 (无锁, 不关中断), 用于中断与前台之间传递字节流
+    - 读写位置各占一个对齐的32位字, 自由递增 (不回绕到缓冲区大小), 数据量 = head - tail
+      写端只写 head, 读端只写 tail, 两端互不做读-改-写, 不会改坏对方的位置
+    - 容量为2的幂, 位置与 mask 相与得到下标, 可用满全部容量
+    - 写端先写数据再发布 head (release), 读端先读 head 再读数据 (acquire); 读端同理发布 tail
+    - 除整块读写外还提供连续区间操作: 直接在缓冲区中写入/交给DMA读取, 写完/读完再提交
+*/
+typedef struct
+{
+    uint8_t *buffer;            /* 缓冲区 */
+    uint32_t mask;              /* 容量 - 1 */
+    volatile uint32_t head;     /* 写位置, 只由写端修改 */
+    volatile uint32_t tail;     /* 读位置, 只由读端修改 */
+}Spsc_T;
+
+/*
+    提供给用户调用的API
+*/
+/* 初始化 (_size 须为2的幂, 否则向下取2的幂) */
+void spsc_init(Spsc_T * _tpRing, uint8_t * _buffer, uint32_t _size);
+
+/* 当前数据量 / 空闲空间 (对端并发时为保守值) */
+uint32_t spsc_data_len(const Spsc_T * _tpRing);
+uint32_t spsc_space_len(const Spsc_T * _tpRing);
+
+/* 写端: 整块写入, 空间不足时只写入能放下的部分, 返回写入的字节数 */
+uint32_t spsc_write(Spsc_T * _tpRing, const uint8_t * _data, uint32_t _len);
+
+/* 写端: 取得空闲区 (两段连续区间: 写位置到缓冲区末尾 / 折返后的部分), 写完后用 spsc_write_commit 提交 */
+uint32_t spsc_write_span(Spsc_T * _tpRing, uint8_t ** _ptr, uint8_t ** _wrap_ptr, uint32_t * _wrap_len);
+void spsc_write_commit(Spsc_T * _tpRing, uint32_t _len);
+
+/* 读端: 整块读出, 返回读出的字节数 */
+uint32_t spsc_read(Spsc_T * _tpRing, uint8_t * _data, uint32_t _len);
+
+/* 读端: 取得读位置起连续的一段数据 (不移除), 用完后用 spsc_read_release 移除 */
+uint32_t spsc_read_span(Spsc_T * _tpRing, uint8_t ** _ptr);
+void spsc_read_release(Spsc_T * _tpRing, uint32_t _len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -15,10 +15,14 @@
 #include <stdarg.h>
 #include <math.h>
 
+/* ========== 控制周期 ========== */
+#include "control_rate.h"
+
 /* ========== �����ͷ�ļ� ========== */
 #include "ebtn.h"
 
 #include "ringbuffer.h"
+#include "spsc.h"
 
 #include "oled.h"
 
@@ -33,6 +37,7 @@
 #include "oled_driver.h"
 #include "motor_driver.h"
 #include "encoder_driver.h"
+#include "flash_driver.h"
 
 /* ========== Ӧ�ò�ͷ�ļ� ========== */
 #include "led_app.h"
@@ -43,7 +48,10 @@
 #include "motor_app.h"
 #include "encoder_app.h"
 #include "pid_app.h"
+#include "param_app.h"
 #include "lvgl_app.h"  // LVGL应用
+#include "perf_app.h"  // 执行时间统计
+#include "log_app.h"   // 延迟格式化日志
 
 /* ========== ���ĵ�����ͷ�ļ� ========== */
 #include "Scheduler.h"
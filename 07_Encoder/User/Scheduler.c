@@ -1,59 +1,167 @@
 #include "Scheduler.h"
-
-// 任务结构体
-typedef struct {
-  void (*task_func)(void);  // 任务函数指针
-  uint32_t rate_ms;         // 执行周期（毫秒）
-  uint32_t last_run;        // 上次执行时间（初始化为 0，每次运行时刷新）
-} scheduler_task_t;
+#include "telem_app.h"
 
 // 全局变量，用于存储任务数量
 uint8_t task_num;
 
-// 静态任务数组,每个任务包含任务函数、执行周期(毫秒)和上次运行时间(毫秒)
-static scheduler_task_t scheduler_task[] =
+// 静态任务数组, 每个任务包含: 任务函数、执行周期(毫秒)、相位偏移(毫秒)、优先级(0最高)、初始使能、名称
+// 同周期的任务错开相位, 避免在同一个节拍集中执行
+// 按优先级排列 (抢占式内核要求): 同优先级的任务之间不抢占, 共享数据不需要加锁
+//   0: 控制外环, 以及会修改电机状态的按键/菜单和参数保存 (motor_state 只在这一级写)
+//   1: 串口命令、执行时间报告、遥测输出
+//   2: LED
+//   3: 共用 hi2c2 的任务 (LVGL 刷新OLED、OLED菜单、灰度传感器), 日志输出
+//      hi2c2 的 HAL 句柄锁不是原子操作, 这几个任务放在同一级, 一次传输不会被另一个任务的传输打断
+static SchedTask_T scheduler_task[] =
 {
-  {Led_Task, 1, 0},
-  {Key_Task, 10, 0},
-  {Gray_Task, 10, 0},
-  {Oled_Task, 10, 0},
-  {Motor_Task, 10, 0},
-  {Uart1_Task, 10, 0},
-  {LVGL_Task, 5, 0},  // LVGL任务,5ms周期刷新
+  {Motor_Task, CONTROL_OUTER_PERIOD_MS, 0, 0, 1, "Motor"},  // 控制外环: 运动曲线/位置环/模式逻辑
+  {Key_Task, 10, 1, 0, 1, "Key"},  // 按键事件经菜单调用 MotorApp_* 修改电机状态
+  {Param_Task, 100, 9, 0, 1, "Param"},  // 参数保存(擦除推迟到电机停止时)
+  {Uart1_Task, 10, 3, 1, 1, "Uart1"},
+#if PERF_ENABLE
+  {Perf_Task, 10, 8, 1, 1, "Perf"},  // 执行时间报告, 每次输出一行
+#endif
+#if TELEM_ENABLE
+  {Telem_Task, 5, 4, 1, 1, "Telem"},  // 二进制遥测打包输出
+#endif
+  {Led_Task, 1, 0, 2, 1, "Led"},
+  {Gray_Task, 10, 5, 3, 1, "Gray"},  // 灰度传感器 (hi2c2)
+  {Oled_Task, 10, 7, 3, 1, "Oled"},  // OLED菜单 (hi2c2) 与调试输出
+  {LVGL_Task, 5, 2, 3, 1, "LVGL"},  // LVGL任务,5ms周期刷新 (hi2c2)
+  {Log_Task, 10, 6, 3, 1, "Log"},  // 日志输出 (文本方式在这里格式化)
 };
 
+static Sched_T scheduler;
+
+#if SCHEDULER_PREEMPTIVE
+static uint8_t scheduler_level[KERNEL_MAX_TASKS];   // 各任务的内核优先级 (取任务表中的优先级)
+static volatile uint8_t scheduler_started = 0;      // 首次 Scheduler_Run 后才开始释放任务
+
+/**
+ * @brief 内核执行第 index 个任务
+ */
+static void Scheduler_Dispatch(uint8_t index)
+{
+  SchedTask_T *task = &scheduler_task[index];
+  PERF_MARK(mark);
+
+  PERF_BEGIN(mark);
+  sched_begin(task, HAL_GetTick());
+  task->func();
+  PERF_END_TASK(mark, index);  // 扣除期间抢占进来的中断和任务
+}
+#endif
 
 /**
  * @brief 调度器初始化函数
- * 计算任务数组的元素个数，并将结果存储在 task_num 中
+ * 计算任务数组的元素个数，并以当前时刻为起点安排各任务的首次释放
  */
 void Scheduler_Init(void)
 {
   System_Init();
   // 计算任务数组的元素个数，并将结果存储在 task_num 中
-  task_num = sizeof(scheduler_task) / sizeof(scheduler_task_t); // 数组大小 / 数组成员大小 = 数组元素个数
+  task_num = sizeof(scheduler_task) / sizeof(scheduler_task[0]); // 数组大小 / 数组成员大小 = 数组元素个数
+  sched_init(&scheduler, scheduler_task, task_num, HAL_GetTick());
+
+#if SCHEDULER_PREEMPTIVE
+  for (uint8_t i = 0; i < task_num && i < KERNEL_MAX_TASKS; i++) {
+    scheduler_level[i] = scheduler_task[i].priority;
+  }
+  kernel_init(scheduler_level, task_num, Scheduler_Dispatch);
+#endif
 }
 
+#if SCHEDULER_PREEMPTIVE
+/**
+ * @brief 调度器运行函数 (抢占式)
+ * 首次调用时以当前时刻为起点重新安排释放并开始调度 (main 中 Scheduler_Init 之后还有其他初始化),
+ * 之后什么也不做: 主循环是空闲任务, 所有任务都由 SysTick 激活、在 PendSV 中抢占执行
+ */
+void Scheduler_Run(void)
+{
+  if (scheduler_started) return;
+
+  sched_init(&scheduler, scheduler_task, task_num, HAL_GetTick());
+  scheduler_started = 1;
+}
+
+/**
+ * @brief 节拍处理 (SysTick 中断中调用)
+ * 释放到期任务交给内核; 上次激活还没开始执行的任务不重复激活, 计为错过
+ */
+void Scheduler_Tick(void)
+{
+  if (!scheduler_started) return;
+
+  kernel_post(sched_release(&scheduler, HAL_GetTick(), kernel_pending()));
+}
+#else
 /**
  * @brief 调度器运行函数
- * 遍历任务数组，检查是否有任务需要执行。如果当前时间已经超过任务的执行周期，则执行该任务并更新上次运行时间
+ * 每次执行一个已到期且优先级最高的任务, 直到没有到期任务; 每个任务执行后重新读取系统时间,
+ * 长任务期间到期的高优先级任务先于其余低优先级任务执行
  */
 void Scheduler_Run(void)
 {
-  // 遍历任务数组中的所有任务
-  for (uint8_t i = 0; i < task_num; i++)
-  {
-    // 获取当前的系统时间（毫秒）
-    uint32_t now_time = HAL_GetTick();
+  PERF_MARK(mark);
 
-    // 检查当前时间是否达到任务的执行时间
-    if (now_time >= scheduler_task[i].rate_ms + scheduler_task[i].last_run)
-    {
-      // 更新任务的上次运行时间为当前时间
-      scheduler_task[i].last_run = now_time;
+  for (;;) {
+    PERF_BEGIN(mark);
+    SchedTask_T *task = sched_run_one(&scheduler, HAL_GetTick());
+    if (task == 0) break;
+    PERF_END_TASK(mark, (uint8_t)(task - scheduler_task));  // 含本次选择任务的开销
+  }
+}
 
-      // 执行任务函数
-      scheduler_task[i].task_func();
+/**
+ * @brief 节拍处理 (协作式不使用)
+ */
+void Scheduler_Tick(void)
+{
+}
+#endif
+
+/**
+ * @brief 运行时使能/禁止任务
+ * @param task_func 任务函数
+ * @param enable 1=使能, 0=禁止
+ */
+void Scheduler_Enable(void (*task_func)(void), uint8_t enable)
+{
+#if SCHEDULER_PREEMPTIVE
+  uint32_t state = kernel_port_irq_save();  // 释放时刻同时被 SysTick 读写
+#endif
+  for (uint8_t i = 0; i < task_num; i++) {
+    if (scheduler_task[i].func == task_func) {
+      sched_enable(&scheduler_task[i], enable, HAL_GetTick());
     }
   }
+#if SCHEDULER_PREEMPTIVE
+  kernel_port_irq_restore(state);
+#endif
+}
+
+/**
+ * @brief 获取任务表 (含执行次数、错过的周期数、最大延迟)
+ * @param count 输出任务数
+ * @return 任务表
+ */
+const SchedTask_T *Scheduler_GetTasks(uint8_t *count)
+{
+  *count = task_num;
+  return scheduler_task;
+}
+
+/**
+ * @brief 清除任务统计
+ */
+void Scheduler_ResetStats(void)
+{
+#if SCHEDULER_PREEMPTIVE
+  uint32_t state = kernel_port_irq_save();  // 错过次数由 SysTick 累加
+  sched_reset_stats(&scheduler);
+  kernel_port_irq_restore(state);
+#else
+  sched_reset_stats(&scheduler);
+#endif
 }
@@ -2,8 +2,22 @@
 #define __SCHEDULER_H__
 
 #include "MyDefine.h"
+#include "sched.h"
+#include "kernel.h"
+
+/**
+ * @brief 调度方式
+ * @note 1 = 抢占式: SysTick 释放到期任务, 内核按优先级抢占执行, 界面刷新不会推迟控制外环
+ *       0 = 协作式: 主循环依次执行到期任务
+ *       两种方式共用同一张任务表, 优先级相同的任务之间不抢占
+ */
+#define SCHEDULER_PREEMPTIVE 1
 
 void Scheduler_Init(void);
 void Scheduler_Run(void);
+void Scheduler_Tick(void);
+void Scheduler_Enable(void (*task_func)(void), uint8_t enable);
+const SchedTask_T *Scheduler_GetTasks(uint8_t *count);
+void Scheduler_ResetStats(void);
   
 #endif
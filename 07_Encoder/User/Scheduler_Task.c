@@ -1,37 +1,64 @@
 /**
  * @brief 系统初始化和中断处理
+ * @note 执行模型: 每个任务只属于一个上下文
+ *       - TIM2中断 (控制内环): Encoder_Task、PID_Task, 独占 axes[] 的编码器/同步状态和速度环状态
+ *       - 前台调度器: Motor_Task (控制外环) 及按键/显示/串口/参数任务, 独占 motor_state
+ *       跨上下文的数据只经由 Handoff 交接: 外环 → 内环为速度环命令 (PID_SetSpeedTarget 等),
+ *       内环 → 前台为编码器反馈 (Encoder_GetFeedback), 均不关中断
  */
 #include "Scheduler_Task.h"
+#include "telem_app.h"
+
+/**
+ * @brief 按控制频率设置TIM2时基 (TIM2计数频率1MHz)
+ */
+static void Control_Timebase_Init(void)
+{
+    htim2.Init.Period = 1000000 / CONTROL_TIMEBASE_HZ - 1;
+    __HAL_TIM_SET_AUTORELOAD(&htim2, htim2.Init.Period);
+}
 
 void System_Init(void)
 {
+    Perf_Init();
+    Control_Timebase_Init();
     Uart_Tx_Init();
+    Log_Init();      // 之后各模块初始化的日志先缓存, 调度开始后由 Log_Task 输出
+    Telem_Init();
     Led_Init();
     Key_Init();
     Uart_Init();
     Oled_Init();
     Gray_Init();
+    PID_LoadDefaults();
+    Param_Init();    // 加载持久化参数, 必须在电机/编码器/PID初始化之前
     Motor_Init();
     Encoder_Init();
     PID_Init();
-    Uart_Printf(DEBUG_UART, "==== System Init ====\r\n");
+    LOG_I("==== System Init ====");
     HAL_TIM_Base_Start_IT(&htim2);
 }
 
-static uint8_t timer_10ms = 0;
+static uint8_t control_divider = 0;
 
 /**
- * @brief TIM2中断回调 (1ms周期)
+ * @brief TIM2中断回调 (CONTROL_TIMEBASE_HZ)
  */
 void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
 {
     if (htim->Instance != htim2.Instance) return;
 
-    // 10ms任务
-    if (++timer_10ms >= 10) {
-        timer_10ms = 0;
-        Encoder_Task();  // 编码器采样
-        Motor_Task();    // 电机控制
-        PID_Task();      // PID计算
-    }
+    // DMA采样时TIM2比控制频率快, 其余中断只用于触发DMA搬运CNT
+    if (++control_divider < CONTROL_TIMEBASE_DIV) return;
+    control_divider = 0;
+
+    PERF_MARK(mark);
+    PERF_BEGIN(mark);
+
+    // 控制内环 (CONTROL_RATE_HZ), 外环 Motor_Task 在前台调度器中执行
+    Encoder_Task();  // 编码器采样, 发布反馈
+    PID_Task();      // 速度环, 读取外环发布的目标
+    Telem_Capture(); // 遥测采样 (只拷贝, 由 Telem_Task 编码输出)
+
+    PERF_END_ISR(mark, PERF_ISR_CONTROL);
 }
@@ -0,0 +1,50 @@
+#ifndef __CONTROL_RATE_H__
+#define __CONTROL_RATE_H__
+
+#include <stdint.h>
+
+/*
+    双速率控制:
+    - 内环 (CONTROL_RATE_HZ): TIM2中断中执行编码器采样 + 速度环, 支持 100 / 500 / 1000 / 2000
+    - 外环 (CONTROL_OUTER_RATE_HZ): 前台调度器中执行运动曲线、圈数位置环、标定等模式逻辑
+    两者通过 Handoff 交接: 外环发布速度目标, 内环发布编码器反馈
+*/
+#define CONTROL_RATE_HZ       1000
+#define CONTROL_DT_S          (1.0f / CONTROL_RATE_HZ)
+
+// 外环频率(Hz)
+#define CONTROL_OUTER_RATE_HZ 100
+#define CONTROL_OUTER_DT_S    (1.0f / CONTROL_OUTER_RATE_HZ)
+// 外环任务周期(ms), 由调度器按 HAL_GetTick 执行
+#define CONTROL_OUTER_PERIOD_MS  (1000 / CONTROL_OUTER_RATE_HZ)
+// 时间(ms) → 外环周期数
+#define CONTROL_OUTER_MS_TO_TICKS(ms)  ((uint32_t)(ms) * CONTROL_OUTER_RATE_HZ / 1000)
+
+/**
+ * @brief 编码器采样方式
+ * @note 0 = 每个控制周期读取CNT + M/T法测速 (当前模式)
+ *       1 = TIM2按 ENCODER_DMA_SAMPLES 倍控制频率运行, 每个TIM2周期触发DMA搬运CNT,
+ *           每个控制周期对这一批样本做最小二乘拟合测速 (见 encoder_app.h)
+ */
+#define ENCODER_DMA_SAMPLING  0
+// DMA采样: 每个控制周期的样本数 (采样频率不超过8kHz, 且须整除1MHz)
+#define ENCODER_DMA_SAMPLES   (CONTROL_RATE_HZ > 1000 ? 4 : 8)
+
+// TIM2中断频率(Hz): TIM2计数频率1MHz; DMA采样时按采样频率运行, 其余中断只触发DMA
+#if ENCODER_DMA_SAMPLING
+#define CONTROL_TIMEBASE_HZ   (CONTROL_RATE_HZ * ENCODER_DMA_SAMPLES)
+#else
+#define CONTROL_TIMEBASE_HZ   CONTROL_RATE_HZ
+#endif
+// 每个控制周期包含的TIM2中断数
+#define CONTROL_TIMEBASE_DIV  (CONTROL_TIMEBASE_HZ / CONTROL_RATE_HZ)
+
+#if (CONTROL_TIMEBASE_HZ % CONTROL_RATE_HZ) != 0 || (1000000 % CONTROL_TIMEBASE_HZ) != 0
+#error "CONTROL_RATE_HZ 必须能整除TIM2时基"
+#endif
+
+#if CONTROL_OUTER_RATE_HZ > CONTROL_RATE_HZ || (1000 % CONTROL_OUTER_RATE_HZ) != 0
+#error "CONTROL_OUTER_RATE_HZ 不能高于内环, 且周期须为整数ms"
+#endif
+
+#endif